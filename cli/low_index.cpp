@@ -0,0 +1,471 @@
+// Command-line enumerator: lists the low index subgroups of finitely
+// presented groups without going through python.
+//
+// Build with:
+//
+//     make -C cli
+//
+// Usage:
+//
+//     cli/low_index -d DEGREE [options] [FILE]
+//
+// Presentations are read from FILE (or stdin if FILE is missing or "-"),
+// one per line in the form
+//
+//     [RANK:] SHORT_RELATOR ... [| LONG_RELATOR ...]
+//
+// where the relators are words as accepted by parse_word, e.g.,
+//
+//     3: aaBcbbcAc | aacAbCBBaCAAbbcBc
+//
+// If the rank is omitted, the one given with --rank is used, or else the
+// largest generator (letter) occurring in the relators. Blank lines and
+// lines starting with # are skipped.
+//
+// The covering subgraphs are written in the order of SimsTreeBase::list()
+// while the search is still running: the search tree is split with
+// SimsTreeBase::bloom and the subtrees are searched by a pool of threads,
+// writing the result of a subtree as soon as all the subtrees before it
+// are done.
+//
+// Output formats:
+// - text (default): for each presentation, a line "# " followed by the
+//   presentation and then one line for each covering subgraph with its
+//   permutation representation, e.g., [[0, 1, 2], [1, 2, 0]].
+// - result: the format of ResultFile.
+// - delta: the format of DeltaStream.
+// The binary formats need --output since the counts in their headers are
+// filled in at the end. If there is more than one presentation, "{}" in the
+// file name is replaced by the (zero-based) index of the presentation.
+//
+// With --serve (or --socket), the presentations and degrees are instead
+// read as requests from stdin (or clients connecting to the Unix domain
+// socket) and the results streamed back, see server.h for the protocol.
+// The threads and the expanded relators are kept between requests, so
+// a small request takes microseconds instead of the startup time of a
+// process.
+
+#include "presentation.h"
+#include "scheduler.h"
+#include "server.h"
+
+#include "deltaStream.h"
+#include "lowIndex.h"
+#include "resultFile.h"
+#include "simsTree.h"
+#include "words.h"
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace low_index;
+using namespace low_index::cli;
+
+namespace {
+
+const char usage[] =
+    "Usage: low_index -d DEGREE [options] [FILE]\n"
+    "       low_index --serve [--socket PATH] [options]\n"
+    "\n"
+    "List the subgroups of index at most DEGREE of the presentations read\n"
+    "from FILE (or stdin), one per line:\n"
+    "\n"
+    "    [RANK:] SHORT_RELATOR ... [| LONG_RELATOR ...]\n"
+    "\n"
+    "Options:\n"
+    "  -d, --degree DEGREE      maximal index (required)\n"
+    "  -r, --rank RANK          rank for lines without RANK:\n"
+    "  -t, --threads N          number of threads (default: 0, that is,\n"
+    "                           all cores)\n"
+    "  -s, --strategy STRATEGY  spin_short (default) or none\n"
+    "  -f, --format FORMAT      text (default), result or delta\n"
+    "  -o, --output FILE        write to FILE instead of stdout; {} is\n"
+    "                           replaced by the index of the presentation\n"
+    "      --serve              answer requests \"ID DEGREE PRESENTATION\"\n"
+    "                           from stdin, see cli/server.h\n"
+    "      --socket PATH        answer requests from clients connecting\n"
+    "                           to the Unix domain socket PATH\n"
+    "      --cache-size N       number of presentations to keep prepared\n"
+    "                           when serving (default: 1024)\n"
+    "  -h, --help               show this message\n";
+
+// Thrown for bad command-line arguments, prints the usage.
+class UsageError : public std::domain_error
+{
+public:
+    UsageError(const std::string &what) : std::domain_error(what) { }
+};
+
+enum class Format { text, result, delta };
+
+struct Options
+{
+    DegreeType max_degree = 0;
+    RankType rank = 0;
+    unsigned int num_threads = 0;
+    std::string strategy = spin_short_strategy;
+    Format format = Format::text;
+    std::string output;
+    std::string input;
+    bool serve = false;
+    std::string socket;
+    size_t cache_size = 1024;
+};
+
+long
+parse_integer(const std::string &flag,
+              const std::string &value,
+              const long min,
+              const long max)
+{
+    char * end;
+    const long result = std::strtol(value.c_str(), &end, 10);
+    if (value.empty() || *end || result < min || result > max) {
+        throw UsageError(
+            "Expected integer between " + std::to_string(min) + " and " +
+            std::to_string(max) + " for " + flag + ", got '" + value + "'");
+    }
+    return result;
+}
+
+Options
+parse_options(const int argc, char ** const argv)
+{
+    Options options;
+    bool has_input = false;
+
+    for (int i = 1; i < argc; i++) {
+        const std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            std::cout << usage;
+            std::exit(0);
+        }
+        if (arg == "--serve") {
+            options.serve = true;
+            continue;
+        }
+        if (arg.size() > 1 && arg[0] == '-') {
+            if (i + 1 == argc) {
+                throw UsageError("Missing value for " + arg);
+            }
+            const std::string value = argv[++i];
+            if (arg == "-d" || arg == "--degree") {
+                options.max_degree = static_cast<DegreeType>(
+                    parse_integer(arg, value, 1, 255));
+            } else if (arg == "-r" || arg == "--rank") {
+                options.rank = static_cast<RankType>(
+                    parse_integer(arg, value, 1, 65535));
+            } else if (arg == "-t" || arg == "--threads") {
+                options.num_threads = static_cast<unsigned int>(
+                    parse_integer(arg, value, 0, 1 << 16));
+            } else if (arg == "-s" || arg == "--strategy") {
+                if (value != spin_short_strategy && value != "none") {
+                    throw UsageError("Unknown strategy '" + value + "'");
+                }
+                options.strategy = value;
+            } else if (arg == "-f" || arg == "--format") {
+                if (value == "text") {
+                    options.format = Format::text;
+                } else if (value == "result") {
+                    options.format = Format::result;
+                } else if (value == "delta") {
+                    options.format = Format::delta;
+                } else {
+                    throw UsageError("Unknown format '" + value + "'");
+                }
+            } else if (arg == "-o" || arg == "--output") {
+                options.output = value;
+            } else if (arg == "--socket") {
+                options.serve = true;
+                options.socket = value;
+            } else if (arg == "--cache-size") {
+                options.cache_size = static_cast<size_t>(
+                    parse_integer(arg, value, 0, 1L << 30));
+            } else {
+                throw UsageError("Unknown option " + arg);
+            }
+            continue;
+        }
+        if (has_input) {
+            throw UsageError("More than one input file");
+        }
+        has_input = true;
+        options.input = arg;
+    }
+
+    if (options.serve) {
+        // The degree is part of the requests.
+        if (options.max_degree != 0 || options.format != Format::text ||
+            !options.output.empty() || has_input) {
+            throw UsageError(
+                "--degree, --format, --output and FILE cannot be used "
+                "with --serve");
+        }
+    } else if (options.max_degree == 0) {
+        throw UsageError("Missing --degree");
+    }
+    if (options.format != Format::text && options.output.empty()) {
+        throw UsageError("The binary formats need --output");
+    }
+    if (options.num_threads == 0) {
+        options.num_threads = std::thread::hardware_concurrency();
+        if (options.num_threads == 0) {
+            options.num_threads = 1;
+        }
+    }
+
+    return options;
+}
+
+// Receives the covering subgraphs of one presentation in order and
+// completes the output once all have been received.
+class OutputSink : public Sink
+{
+public:
+    virtual void finish() = 0;
+};
+
+class TextSink : public OutputSink
+{
+public:
+    TextSink(std::ostream &out) : _out(out) { }
+
+    void write(const CoverList &covers) override {
+        std::string buffer;
+        append_permutation_reps(covers, "", buffer);
+        _out << buffer;
+        // Make the results available to the next program in the pipeline.
+        _out.flush();
+    }
+
+    void finish() override {
+        _out.flush();
+    }
+
+private:
+    std::ostream &_out;
+};
+
+class ResultSink : public OutputSink
+{
+public:
+    ResultSink(const std::string &filename,
+               const RankType rank,
+               const DegreeType max_degree)
+      : _writer(filename, rank, max_degree)
+      , _segment(_writer.add_segment()) { }
+
+    void write(const CoverList &covers) override {
+        for (size_t i = 0; i < covers.size(); i++) {
+            _segment->write(covers.degree(i), covers.outgoing_table(i));
+        }
+    }
+
+    void finish() override {
+        _writer.add_run(0, 0, _segment->size());
+        _writer.finish();
+    }
+
+private:
+    ResultFileWriter _writer;
+    ResultSegmentWriter * _segment;
+};
+
+class DeltaSink : public OutputSink
+{
+public:
+    DeltaSink(const std::string &filename,
+              const RankType rank,
+              const DegreeType max_degree)
+      : _writer(filename, rank, max_degree) { }
+
+    void write(const CoverList &covers) override {
+        for (size_t i = 0; i < covers.size(); i++) {
+            _writer.write(covers.degree(i), covers.outgoing_table(i));
+        }
+    }
+
+    void finish() override {
+        _writer.close();
+    }
+
+private:
+    DeltaStreamWriter _writer;
+};
+
+// Enough subtrees to balance the load between the threads and to write
+// results early.
+size_t
+num_subtrees(const unsigned int num_threads)
+{
+    return num_threads == 1 ? 64 : 16 * num_threads;
+}
+
+std::string
+output_filename(const std::string &pattern, const size_t index)
+{
+    std::string result = pattern;
+    const size_t pos = result.find("{}");
+    if (pos != std::string::npos) {
+        result.replace(pos, 2, std::to_string(index));
+    }
+    return result;
+}
+
+void
+list_subgroups(const Options &options,
+               Scheduler &scheduler,
+               const std::string &line,
+               const size_t index,
+               std::ostream &text_out)
+{
+    const Presentation p = parse_presentation(line, options.rank);
+
+    const std::shared_ptr<const std::vector<Relator>> short_relators =
+        std::make_shared<const std::vector<Relator>>(
+            (options.strategy == spin_short_strategy)
+                ? spin_short(p.short_relators, options.max_degree)
+                : p.short_relators);
+    const std::shared_ptr<const std::vector<Relator>> long_relators =
+        std::make_shared<const std::vector<Relator>>(p.long_relators);
+
+    std::shared_ptr<OutputSink> sink;
+    switch (options.format) {
+    case Format::text:
+        text_out << "# " << line << "\n";
+        sink.reset(new TextSink(text_out));
+        break;
+    case Format::result:
+        sink.reset(new ResultSink(output_filename(options.output, index),
+                                  p.rank, options.max_degree));
+        break;
+    case Format::delta:
+        sink.reset(new DeltaSink(output_filename(options.output, index),
+                                 p.rank, options.max_degree));
+        break;
+    }
+
+    const SimsTree tree(
+        p.rank, options.max_degree, *short_relators, *long_relators);
+    const std::shared_ptr<const std::vector<SimsNode>> roots =
+        std::make_shared<const std::vector<SimsNode>>(
+            tree.bloom(num_subtrees(options.num_threads)));
+
+    std::promise<void> done;
+    scheduler.submit(
+        std::make_shared<Job>(
+            roots, short_relators, long_relators, sink,
+            [&done](const std::exception_ptr error) {
+                if (error) {
+                    done.set_exception(error);
+                } else {
+                    done.set_value();
+                }
+            }));
+    done.get_future().get();
+    sink->finish();
+}
+
+void
+serve(const Options &options)
+{
+    ServerOptions server_options;
+    server_options.strategy = options.strategy;
+    server_options.rank = options.rank;
+    server_options.num_subtrees = num_subtrees(options.num_threads);
+    server_options.cache_size = options.cache_size;
+    server_options.socket = options.socket;
+
+    Scheduler scheduler(options.num_threads);
+    serve(scheduler, server_options);
+}
+
+int
+run(const Options &options)
+{
+    if (options.serve) {
+        serve(options);
+        return 0;
+    }
+
+    std::ifstream input_file;
+    std::istream * input = &std::cin;
+    if (!options.input.empty() && options.input != "-") {
+        input_file.open(options.input);
+        if (!input_file) {
+            throw std::runtime_error("Could not open " + options.input);
+        }
+        input = &input_file;
+    }
+
+    std::ofstream output_file;
+    std::ostream * text_out = &std::cout;
+    if (options.format == Format::text && !options.output.empty()) {
+        output_file.open(options.output);
+        if (!output_file) {
+            throw std::runtime_error("Could not open " + options.output);
+        }
+        text_out = &output_file;
+    }
+
+    const bool has_pattern =
+        options.output.find("{}") != std::string::npos;
+
+    Scheduler scheduler(options.num_threads);
+
+    size_t index = 0;
+    std::string line;
+    while (std::getline(*input, line)) {
+        if (is_blank_or_comment(line)) {
+            continue;
+        }
+        if (index > 0 && options.format != Format::text && !has_pattern) {
+            throw std::domain_error(
+                "More than one presentation needs {} in the output file "
+                "name");
+        }
+        try {
+            list_subgroups(options, scheduler, line, index, *text_out);
+        } catch (const std::domain_error &e) {
+            throw std::domain_error(
+                "Presentation " + std::to_string(index) + ": " + e.what());
+        }
+        index++;
+    }
+
+    if (!*text_out) {
+        throw std::runtime_error("Could not write output");
+    }
+    return 0;
+}
+
+} // Anonymous namespace
+
+int
+main(const int argc, char ** const argv)
+{
+    std::ios::sync_with_stdio(false);
+
+    Options options;
+    try {
+        options = parse_options(argc, argv);
+    } catch (const UsageError &e) {
+        std::cerr << "low_index: " << e.what() << "\n\n" << usage;
+        return 2;
+    }
+
+    try {
+        return run(options);
+    } catch (const std::exception &e) {
+        std::cerr << "low_index: error: " << e.what() << "\n";
+        return 1;
+    }
+}
@@ -0,0 +1,135 @@
+#include "presentation.h"
+
+#include "words.h"
+
+#include <algorithm>
+#include <cctype>
+#include <sstream>
+#include <stdexcept>
+
+namespace low_index {
+namespace cli {
+
+// The largest generator used in the words (in the a, b, ... syntax).
+static
+RankType
+_infer_rank(const std::vector<std::string> &words)
+{
+    RankType result = 0;
+    for (const std::string &word : words) {
+        for (const char letter : word) {
+            if (letter >= '0' && letter <= '9') {
+                throw std::domain_error(
+                    "Rank needs to be given for word '" + word + "'");
+            }
+            if (letter >= 'a' && letter <= 'z') {
+                result = std::max<RankType>(result, letter - 'a' + 1);
+            }
+            if (letter >= 'A' && letter <= 'Z') {
+                result = std::max<RankType>(result, letter - 'A' + 1);
+            }
+        }
+    }
+    return result;
+}
+
+Presentation
+parse_presentation(const std::string &line, const RankType default_rank)
+{
+    std::string words = line;
+    RankType rank = default_rank;
+
+    const size_t colon = words.find(':');
+    if (colon != std::string::npos) {
+        std::istringstream prefix(words.substr(0, colon));
+        long value;
+        std::string rest;
+        if (!(prefix >> value) || (prefix >> rest) ||
+            value < 1 || value > 65535) {
+            throw std::domain_error(
+                "Bad rank '" + words.substr(0, colon) + "'");
+        }
+        rank = static_cast<RankType>(value);
+        words = words.substr(colon + 1);
+    }
+
+    std::vector<std::string> short_words;
+    std::vector<std::string> long_words;
+    bool is_long = false;
+    std::istringstream in(words);
+    std::string word;
+    while (in >> word) {
+        if (word == "|") {
+            if (is_long) {
+                throw std::domain_error("More than one '|'");
+            }
+            is_long = true;
+            continue;
+        }
+        (is_long ? long_words : short_words).push_back(word);
+    }
+
+    if (rank == 0) {
+        std::vector<std::string> all_words = short_words;
+        all_words.insert(all_words.end(), long_words.begin(), long_words.end());
+        rank = _infer_rank(all_words);
+        if (rank == 0) {
+            throw std::domain_error(
+                "Cannot determine rank of presentation without relators");
+        }
+    }
+
+    Presentation result;
+    result.rank = rank;
+    for (const std::string &w : short_words) {
+        result.short_relators.push_back(parse_word(rank, w));
+    }
+    for (const std::string &w : long_words) {
+        result.long_relators.push_back(parse_word(rank, w));
+    }
+    return result;
+}
+
+bool
+is_blank_or_comment(const std::string &line)
+{
+    for (const char c : line) {
+        if (c == '#') {
+            return true;
+        }
+        if (!std::isspace(static_cast<unsigned char>(c))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+append_permutation_reps(const CoverList &covers,
+                        const std::string &prefix,
+                        std::string &result)
+{
+    for (size_t i = 0; i < covers.size(); i++) {
+        const std::vector<std::vector<DegreeType>> rep =
+            covers.permutation_rep(i);
+        result += prefix;
+        result += '[';
+        for (size_t j = 0; j < rep.size(); j++) {
+            if (j > 0) {
+                result += ", ";
+            }
+            result += '[';
+            for (size_t k = 0; k < rep[j].size(); k++) {
+                if (k > 0) {
+                    result += ", ";
+                }
+                result += std::to_string(static_cast<int>(rep[j][k]));
+            }
+            result += ']';
+        }
+        result += "]\n";
+    }
+}
+
+} // Namespace cli
+} // Namespace low_index
@@ -0,0 +1,43 @@
+#ifndef LOW_INDEX_CLI_PRESENTATION_H
+#define LOW_INDEX_CLI_PRESENTATION_H
+
+#include "coverList.h"
+
+#include <string>
+#include <vector>
+
+namespace low_index {
+namespace cli {
+
+/// A presentation as given on a line of input, see parse_presentation.
+struct Presentation
+{
+    RankType rank;
+    std::vector<Relator> short_relators;
+    std::vector<Relator> long_relators;
+};
+
+/// Parse a presentation of the form
+///
+///     [RANK:] SHORT_RELATOR ... [| LONG_RELATOR ...]
+///
+/// where the relators are words as accepted by parse_word. Without RANK:,
+/// default_rank is used or, if it is zero, the largest generator (letter)
+/// occurring in the relators. Throws std::domain_error for bad input.
+Presentation parse_presentation(const std::string &line,
+                                RankType default_rank);
+
+/// Whether the line is blank or a comment (starting with #).
+bool is_blank_or_comment(const std::string &line);
+
+/// Append a line with the permutation representation of each covering
+/// subgraph, e.g., [[0, 1, 2], [1, 2, 0]], to result. Each line starts
+/// with prefix.
+void append_permutation_reps(const CoverList &covers,
+                             const std::string &prefix,
+                             std::string &result);
+
+} // Namespace cli
+} // Namespace low_index
+
+#endif
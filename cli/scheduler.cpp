@@ -0,0 +1,201 @@
+#include "scheduler.h"
+
+#include "simsTree.h"
+
+namespace low_index {
+namespace cli {
+
+Job::Job(
+    std::shared_ptr<const std::vector<SimsNode>> roots,
+    std::shared_ptr<const std::vector<Relator>> short_relators,
+    std::shared_ptr<const std::vector<Relator>> long_relators,
+    std::shared_ptr<Sink> sink,
+    std::function<void(std::exception_ptr)> on_done)
+  : _roots(std::move(roots))
+  , _short_relators(std::move(short_relators))
+  , _long_relators(std::move(long_relators))
+  , _sink(std::move(sink))
+  , _on_done(std::move(on_done))
+  , _token(std::make_shared<CancellationToken>())
+  , _results(_roots->size())
+  , _searched(_roots->size(), false)
+  , _next(0)
+  , _written(0)
+  , _in_flight(0)
+  , _writing(false)
+{
+}
+
+Scheduler::Scheduler(const unsigned int num_threads)
+  // Enough subtrees ahead to keep the threads busy when one subtree
+  // takes much longer than the others.
+  : _window(4 * num_threads)
+  , _turn(0)
+  , _stop(false)
+{
+    for (unsigned int i = 0; i < num_threads; i++) {
+        _threads.emplace_back(&Scheduler::_thread_worker, this);
+    }
+}
+
+Scheduler::~Scheduler()
+{
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cond.notify_all();
+    for (std::thread &thread : _threads) {
+        thread.join();
+    }
+}
+
+void
+Scheduler::submit(std::shared_ptr<Job> job)
+{
+    if (job->_roots->empty()) {
+        job->_on_done(nullptr);
+        return;
+    }
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _jobs.push_back(std::move(job));
+    }
+    _cond.notify_all();
+}
+
+void
+Scheduler::cancel(const std::shared_ptr<Job> &job)
+{
+    // Stop the threads searching subtrees of the job.
+    job->_token->cancel();
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (!job->_error) {
+            job->_error = std::make_exception_ptr(JobCancelled());
+        }
+        // If a thread is still searching or writing, it finishes the job.
+        _finish_if_done(job, lock);
+    }
+    _cond.notify_all();
+}
+
+void
+Scheduler::_thread_worker()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        std::shared_ptr<Job> job;
+        size_t index = 0;
+
+        // Take the next subtree from the Job's in turn.
+        _cond.wait(lock, [this, &job, &index] {
+            for (size_t i = 0; i < _jobs.size(); i++) {
+                const size_t pos = (_turn + i) % _jobs.size();
+                Job &j = *_jobs[pos];
+                if (!j._error &&
+                    j._next < j._roots->size() &&
+                    j._next < j._written + _window) {
+                    job = _jobs[pos];
+                    index = j._next++;
+                    _turn = pos + 1;
+                    return true;
+                }
+            }
+            return _stop && _jobs.empty(); });
+        if (!job) {
+            return;
+        }
+
+        job->_in_flight++;
+        lock.unlock();
+
+        CoverList covers;
+        std::exception_ptr error;
+        try {
+            SimsTree tree((*job->_roots)[index],
+                          *job->_short_relators,
+                          *job->_long_relators);
+            tree.set_cancellation_token(job->_token);
+            covers = tree.list_compact();
+            if (!tree.is_complete()) {
+                throw JobCancelled();
+            }
+        } catch (...) {
+            error = std::current_exception();
+        }
+
+        lock.lock();
+        job->_in_flight--;
+        if (error) {
+            if (!job->_error) {
+                job->_error = error;
+            }
+        } else {
+            job->_results[index] = std::move(covers);
+            job->_searched[index] = true;
+            if (!job->_writing) {
+                _write_results(*job, lock);
+            }
+        }
+        _finish_if_done(job, lock);
+        _cond.notify_all();
+    }
+}
+
+void
+Scheduler::_write_results(Job &job, std::unique_lock<std::mutex> &lock)
+{
+    job._writing = true;
+    while (!job._error &&
+           job._written < job._roots->size() &&
+           job._searched[job._written]) {
+        const CoverList covers = std::move(job._results[job._written]);
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            job._sink->write(covers);
+        } catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        if (error) {
+            job._error = error;
+            break;
+        }
+        job._written++;
+        // The window moved.
+        _cond.notify_all();
+    }
+    job._writing = false;
+}
+
+void
+Scheduler::_finish_if_done(const std::shared_ptr<Job> &job,
+                           std::unique_lock<std::mutex> &lock)
+{
+    if (job->_writing || job->_in_flight > 0) {
+        return;
+    }
+    if (!job->_error && job->_written < job->_roots->size()) {
+        return;
+    }
+
+    for (size_t pos = 0; pos < _jobs.size(); pos++) {
+        if (_jobs[pos] == job) {
+            _jobs.erase(_jobs.begin() + pos);
+            if (pos < _turn) {
+                _turn--;
+            }
+            const std::exception_ptr error = job->_error;
+            lock.unlock();
+            job->_on_done(error);
+            lock.lock();
+            return;
+        }
+    }
+    // Otherwise another thread finished it already.
+}
+
+} // Namespace cli
+} // Namespace low_index
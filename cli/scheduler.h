@@ -0,0 +1,141 @@
+#ifndef LOW_INDEX_CLI_SCHEDULER_H
+#define LOW_INDEX_CLI_SCHEDULER_H
+
+#include "cancellation.h"
+#include "coverList.h"
+#include "simsNode.h"
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace low_index {
+namespace cli {
+
+/// Receives the covering subgraphs of a Job in the order of
+/// SimsTreeBase::list().
+class Sink
+{
+public:
+    virtual ~Sink() { }
+    /// Called with the covering subgraphs of each subtree in order, never
+    /// concurrently for the same Job.
+    virtual void write(const CoverList &covers) = 0;
+};
+
+/// Passed to the on_done of a Job cancelled by Scheduler::cancel.
+class JobCancelled : public std::runtime_error
+{
+public:
+    JobCancelled()
+      : std::runtime_error("The request was cancelled.") { }
+};
+
+/// The search for the covering subgraphs of one presentation, split into
+/// subtrees, e.g., by SimsTreeBase::bloom.
+class Job
+{
+public:
+    /// The roots of the subtrees, short and long relators are as for the
+    /// constructor of SimsTree taking a root.
+    ///
+    /// on_done is called exactly once after the sink received all
+    /// covering subgraphs (with a null exception_ptr) or after the
+    /// search failed (with the exception thrown by the search or the
+    /// sink).
+    Job(std::shared_ptr<const std::vector<SimsNode>> roots,
+        std::shared_ptr<const std::vector<Relator>> short_relators,
+        std::shared_ptr<const std::vector<Relator>> long_relators,
+        std::shared_ptr<Sink> sink,
+        std::function<void(std::exception_ptr)> on_done);
+
+private:
+    friend class Scheduler;
+
+    const std::shared_ptr<const std::vector<SimsNode>> _roots;
+    const std::shared_ptr<const std::vector<Relator>> _short_relators;
+    const std::shared_ptr<const std::vector<Relator>> _long_relators;
+    const std::shared_ptr<Sink> _sink;
+    const std::function<void(std::exception_ptr)> _on_done;
+    // Stops the subtrees being searched when the Job is cancelled.
+    const std::shared_ptr<CancellationToken> _token;
+
+    // The members below are guarded by Scheduler::_mutex.
+
+    // Covering subgraphs of the subtrees searched but not yet written.
+    std::vector<CoverList> _results;
+    std::vector<bool> _searched;
+    // Index of the next subtree to search.
+    size_t _next;
+    // Number of subtrees written to the sink.
+    size_t _written;
+    // Number of subtrees being searched.
+    size_t _in_flight;
+    // Whether a thread is writing to the sink.
+    bool _writing;
+    std::exception_ptr _error;
+};
+
+/// A pool of threads searching the subtrees of several Job's.
+///
+/// The threads take the next subtree from the Job's in turn, so that a
+/// large Job does not hold up small Job's submitted after it. The
+/// covering subgraphs of a subtree are passed to the Sink (by the thread
+/// that searched the subtree) once those of all subtrees before it have
+/// been. To bound the memory used by results that cannot be written yet,
+/// the threads only search subtrees less than a window ahead of the
+/// first subtree not written.
+class Scheduler
+{
+public:
+    /// Start the threads.
+    Scheduler(unsigned int num_threads);
+
+    /// Stops the threads once all Job's are done.
+    ~Scheduler();
+
+    /// Add a Job. Thread-safe.
+    void submit(std::shared_ptr<Job> job);
+
+    /// Stop searching the subtrees of a submitted Job. Unless the Job is
+    /// done already, its on_done is called with JobCancelled (possibly
+    /// by the calling thread). Thread-safe.
+    void cancel(const std::shared_ptr<Job> &job);
+
+private:
+    // Follow rule-of-three/rule-of-five.
+    Scheduler(const Scheduler &other) = delete;
+    Scheduler& operator=(const Scheduler& other) = delete;
+
+    void _thread_worker();
+    // Write the results of the job that are next in order. Called with
+    // the lock held and returns with the lock held.
+    void _write_results(Job &job, std::unique_lock<std::mutex> &lock);
+    // Remove job and call its on_done if it is done. Called with the
+    // lock held and returns with the lock held.
+    void _finish_if_done(const std::shared_ptr<Job> &job,
+                         std::unique_lock<std::mutex> &lock);
+
+    const size_t _window;
+
+    std::mutex _mutex;
+    std::condition_variable _cond;
+    // Job's not done yet, in order of submission.
+    std::deque<std::shared_ptr<Job>> _jobs;
+    // Position in _jobs of the Job to take the next subtree from.
+    size_t _turn;
+    bool _stop;
+
+    std::vector<std::thread> _threads;
+};
+
+} // Namespace cli
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,489 @@
+#include "server.h"
+
+#include "lowIndex.h"
+#include "presentation.h"
+#include "simsTree.h"
+#include "words.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <csignal>
+#include <cstring>
+#include <list>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace low_index {
+namespace cli {
+
+// Close connections sending longer lines (after sending an error).
+static const size_t _max_line_length = 1 << 24;
+
+// A client, that is, stdin/stdout or a socket.
+class _Connection
+{
+public:
+    _Connection(Scheduler &scheduler, const int in_fd, const int out_fd)
+      : _scheduler(scheduler)
+      , _in_fd(in_fd)
+      , _out_fd(out_fd)
+      , _closed(false)
+      , _begin(0)
+      , _line_too_long(false)
+    {
+    }
+
+    ~_Connection() {
+        if (is_socket()) {
+            ::close(_in_fd);
+        }
+    }
+
+    bool is_socket() const { return _in_fd == _out_fd; }
+
+    // Read the next line (without the newline). Returns false at the end
+    // of the input or if the line is longer than _max_line_length. In
+    // the latter case, line_too_long() is true and line is set to the
+    // start of the line.
+    bool read_line(std::string &line) {
+        while (true) {
+            const size_t end = _input.find('\n', _begin);
+            if (end != std::string::npos) {
+                line.assign(_input, _begin, end - _begin);
+                _begin = end + 1;
+                return true;
+            }
+            _input.erase(0, _begin);
+            _begin = 0;
+            if (_input.size() > _max_line_length) {
+                _line_too_long = true;
+                line.assign(_input, 0, 256);
+                return false;
+            }
+            char buffer[1 << 16];
+            const ssize_t n = read(_in_fd, buffer, sizeof(buffer));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                // Treat an unterminated last line as a line.
+                if (_input.empty()) {
+                    return false;
+                }
+                line.swap(_input);
+                _input.clear();
+                return true;
+            }
+            _input.append(buffer, n);
+        }
+    }
+
+    bool line_too_long() const { return _line_too_long; }
+
+    // Write lines. Thread-safe, the lines of different calls are not
+    // interleaved. Throws std::runtime_error if the client went away (and
+    // cancels all its requests then).
+    void send(const std::string &lines) {
+        int error = 0;
+        {
+            std::unique_lock<std::mutex> lock(_send_mutex);
+            if (_closed) {
+                throw std::runtime_error("Connection was closed.");
+            }
+            size_t offset = 0;
+            while (offset < lines.size()) {
+                const ssize_t n = write(
+                    _out_fd, lines.data() + offset, lines.size() - offset);
+                if (n < 0) {
+                    if (errno == EINTR) {
+                        continue;
+                    }
+                    error = errno;
+                    break;
+                }
+                offset += n;
+            }
+        }
+        if (error) {
+            // Not holding _send_mutex since the cancelled requests send
+            // their last line.
+            close();
+            throw std::runtime_error(
+                std::string("Could not write response: ") +
+                std::strerror(error));
+        }
+    }
+
+    // Stop sending responses and cancel all requests that are not done.
+    void close() {
+        {
+            std::unique_lock<std::mutex> lock(_send_mutex);
+            if (_closed) {
+                return;
+            }
+            _closed = true;
+        }
+        for (const std::shared_ptr<Job> &job : _jobs()) {
+            _scheduler.cancel(job);
+        }
+    }
+
+    // Cancel the requests with the given id that are not done.
+    void cancel(const std::string &id) {
+        for (const std::shared_ptr<Job> &job : _jobs(&id)) {
+            _scheduler.cancel(job);
+        }
+    }
+
+    // Called before submitting the Job of a request.
+    void begin_request(const std::string &id,
+                       const std::shared_ptr<Job> &job) {
+        std::unique_lock<std::mutex> lock(_requests_mutex);
+        _requests.emplace_back(id, job);
+    }
+
+    // Called when the Job of a request is done.
+    void end_request(const Job * const job) {
+        {
+            std::unique_lock<std::mutex> lock(_requests_mutex);
+            for (auto it = _requests.begin(); it != _requests.end(); ++it) {
+                if (it->second.get() == job) {
+                    _requests.erase(it);
+                    break;
+                }
+            }
+        }
+        _requests_cond.notify_all();
+    }
+
+    // Wait until the responses to all requests have been sent.
+    void wait_for_requests() {
+        std::unique_lock<std::mutex> lock(_requests_mutex);
+        _requests_cond.wait(lock, [this] { return _requests.empty(); });
+    }
+
+private:
+    // The Job's of the requests that are not done (with the given id).
+    // Copied so that Scheduler::cancel is called without holding
+    // _requests_mutex (which end_request needs).
+    std::vector<std::shared_ptr<Job>> _jobs(
+            const std::string * const id = nullptr) {
+        std::unique_lock<std::mutex> lock(_requests_mutex);
+        std::vector<std::shared_ptr<Job>> result;
+        for (const auto &request : _requests) {
+            if (!id || request.first == *id) {
+                result.push_back(request.second);
+            }
+        }
+        return result;
+    }
+
+    Scheduler &_scheduler;
+    const int _in_fd;
+    const int _out_fd;
+
+    std::mutex _send_mutex;
+    // Set by close. Guarded by _send_mutex.
+    bool _closed;
+
+    std::mutex _requests_mutex;
+    std::condition_variable _requests_cond;
+    // The id and Job of each request that is not done. A Job refers to
+    // the connection through its sink, so this is a cycle broken by
+    // end_request.
+    std::list<std::pair<std::string, std::shared_ptr<Job>>> _requests;
+
+    // Read but not yet returned by read_line, starting at _begin.
+    std::string _input;
+    size_t _begin;
+    bool _line_too_long;
+};
+
+// What is needed to submit a Job for a presentation and degree.
+struct _Prepared
+{
+    std::shared_ptr<const std::vector<SimsNode>> roots;
+    std::shared_ptr<const std::vector<Relator>> short_relators;
+    std::shared_ptr<const std::vector<Relator>> long_relators;
+};
+
+// Least recently used cache of _Prepared. Thread-safe.
+class _Cache
+{
+public:
+    _Cache(const size_t capacity) : _capacity(capacity) { }
+
+    std::shared_ptr<const _Prepared> get(const std::string &key) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        const auto it = _index.find(key);
+        if (it == _index.end()) {
+            return nullptr;
+        }
+        // Move to front.
+        _entries.splice(_entries.begin(), _entries, it->second);
+        return it->second->second;
+    }
+
+    void put(const std::string &key,
+             const std::shared_ptr<const _Prepared> &value) {
+        if (_capacity == 0) {
+            return;
+        }
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_index.count(key)) {
+            // Another thread prepared the same presentation.
+            return;
+        }
+        _entries.emplace_front(key, value);
+        _index[key] = _entries.begin();
+        if (_entries.size() > _capacity) {
+            _index.erase(_entries.back().first);
+            _entries.pop_back();
+        }
+    }
+
+private:
+    typedef std::list<
+        std::pair<std::string, std::shared_ptr<const _Prepared>>> _Entries;
+
+    const size_t _capacity;
+    std::mutex _mutex;
+    // Most recently used first.
+    _Entries _entries;
+    std::unordered_map<std::string, _Entries::iterator> _index;
+};
+
+static
+std::shared_ptr<const _Prepared>
+_prepare(const std::string &presentation,
+         const DegreeType max_degree,
+         const ServerOptions &options)
+{
+    const Presentation p = parse_presentation(presentation, options.rank);
+
+    std::shared_ptr<_Prepared> result = std::make_shared<_Prepared>();
+    result->short_relators = std::make_shared<const std::vector<Relator>>(
+        (options.strategy == spin_short_strategy)
+            ? spin_short(p.short_relators, max_degree)
+            : p.short_relators);
+    result->long_relators = std::make_shared<const std::vector<Relator>>(
+        p.long_relators);
+    const SimsTree tree(p.rank, max_degree,
+                        *result->short_relators, *result->long_relators);
+    result->roots = std::make_shared<const std::vector<SimsNode>>(
+        tree.bloom(options.num_subtrees));
+    return result;
+}
+
+// Writes the covering subgraphs of a request to the connection.
+class _ResponseSink : public Sink
+{
+public:
+    _ResponseSink(std::shared_ptr<_Connection> connection,
+                  const std::string &id,
+                  std::shared_ptr<size_t> count)
+      : _connection(std::move(connection))
+      , _prefix(id + " ")
+      , _count(std::move(count))
+    {
+    }
+
+    void write(const CoverList &covers) override {
+        if (covers.empty()) {
+            return;
+        }
+        std::string lines;
+        append_permutation_reps(covers, _prefix, lines);
+        _connection->send(lines);
+        *_count += covers.size();
+    }
+
+private:
+    const std::shared_ptr<_Connection> _connection;
+    const std::string _prefix;
+    const std::shared_ptr<size_t> _count;
+};
+
+static
+void
+_send_ignoring_errors(_Connection &connection, const std::string &line)
+{
+    try {
+        connection.send(line);
+    } catch (const std::runtime_error &) {
+        // The client went away.
+    }
+}
+
+static
+void
+_handle_request(Scheduler &scheduler,
+                _Cache &cache,
+                const ServerOptions &options,
+                const std::shared_ptr<_Connection> &connection,
+                const std::string &line)
+{
+    std::istringstream in(line);
+    std::string id;
+    std::string degree;
+    in >> id >> degree;
+    std::string presentation;
+    std::getline(in, presentation);
+
+    if (degree == "cancel") {
+        // Nothing to do if the request is done already.
+        connection->cancel(id);
+        return;
+    }
+
+    std::shared_ptr<const _Prepared> prepared;
+    try {
+        char * end;
+        const long max_degree = std::strtol(degree.c_str(), &end, 10);
+        if (degree.empty() || *end || max_degree < 1 || max_degree > 255) {
+            throw std::domain_error(
+                "Expected degree between 1 and 255, got '" + degree + "'");
+        }
+        const std::string key = degree + " " + presentation;
+        prepared = cache.get(key);
+        if (!prepared) {
+            prepared = _prepare(presentation,
+                                static_cast<DegreeType>(max_degree),
+                                options);
+            cache.put(key, prepared);
+        }
+    } catch (const std::exception &e) {
+        _send_ignoring_errors(*connection, id + " error " + e.what() + "\n");
+        return;
+    }
+
+    std::shared_ptr<size_t> count = std::make_shared<size_t>(0);
+    // Set once the job exists - on_done is only called after submit.
+    std::shared_ptr<const Job *> job_ptr = std::make_shared<const Job *>();
+    const std::shared_ptr<Job> job = std::make_shared<Job>(
+        prepared->roots,
+        prepared->short_relators,
+        prepared->long_relators,
+        std::make_shared<_ResponseSink>(connection, id, count),
+        [connection, id, count, job_ptr](const std::exception_ptr error) {
+            std::string response = id + " done " + std::to_string(*count);
+            if (error) {
+                try {
+                    std::rethrow_exception(error);
+                } catch (const std::exception &e) {
+                    response = id + " error " + e.what();
+                }
+            }
+            _send_ignoring_errors(*connection, response + "\n");
+            connection->end_request(*job_ptr);
+        });
+    *job_ptr = job.get();
+    connection->begin_request(id, job);
+    scheduler.submit(job);
+}
+
+static
+void
+_handle_connection(Scheduler &scheduler,
+                   _Cache &cache,
+                   const ServerOptions &options,
+                   const std::shared_ptr<_Connection> &connection)
+{
+    std::string line;
+    while (connection->read_line(line)) {
+        if (is_blank_or_comment(line)) {
+            continue;
+        }
+        _handle_request(scheduler, cache, options, connection, line);
+    }
+    if (connection->line_too_long()) {
+        // We cannot tell where the next request starts, so give up on the
+        // client.
+        std::istringstream in(line);
+        std::string id = "-";
+        in >> id;
+        _send_ignoring_errors(
+            *connection,
+            id + " error Request longer than " +
+            std::to_string(_max_line_length) + " bytes.\n");
+        connection->close();
+    } else if (connection->is_socket()) {
+        // The client closed the socket (or at least shut down writing).
+        connection->close();
+    }
+    connection->wait_for_requests();
+}
+
+static
+int
+_listen(const std::string &path)
+{
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::domain_error("Socket path too long: " + path);
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        throw std::runtime_error(
+            std::string("Could not create socket: ") + std::strerror(errno));
+    }
+    // Remove the socket of a previous server.
+    unlink(path.c_str());
+    if (bind(fd, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        listen(fd, SOMAXCONN) != 0) {
+        const int error = errno;
+        close(fd);
+        throw std::runtime_error(
+            "Could not listen on " + path + ": " + std::strerror(error));
+    }
+    return fd;
+}
+
+void
+serve(Scheduler &scheduler, const ServerOptions &options)
+{
+    // Report a client that went away as error when writing to it.
+    std::signal(SIGPIPE, SIG_IGN);
+
+    _Cache cache(options.cache_size);
+
+    if (options.socket.empty()) {
+        _handle_connection(scheduler, cache, options,
+                           std::make_shared<_Connection>(scheduler, 0, 1));
+        return;
+    }
+
+    const int listen_fd = _listen(options.socket);
+    while (true) {
+        const int fd = accept(listen_fd, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            const int error = errno;
+            close(listen_fd);
+            throw std::runtime_error(
+                std::string("Could not accept connection: ") +
+                std::strerror(error));
+        }
+        // The thread only reads the requests, the search is done by the
+        // threads of the scheduler.
+        std::thread(_handle_connection,
+                    std::ref(scheduler), std::ref(cache), std::cref(options),
+                    std::make_shared<_Connection>(scheduler, fd, fd))
+            .detach();
+    }
+}
+
+} // Namespace cli
+} // Namespace low_index
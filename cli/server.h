@@ -0,0 +1,74 @@
+#ifndef LOW_INDEX_CLI_SERVER_H
+#define LOW_INDEX_CLI_SERVER_H
+
+#include "scheduler.h"
+
+#include <string>
+
+namespace low_index {
+namespace cli {
+
+/// Options of serve.
+struct ServerOptions
+{
+    /// Value for the strategy argument of permutation_reps.
+    std::string strategy;
+    /// Rank for presentations without RANK:, see parse_presentation.
+    RankType rank;
+    /// Number of subtrees to split each search into, see
+    /// SimsTreeBase::bloom.
+    size_t num_subtrees;
+    /// Maximal number of prepared presentations to keep.
+    size_t cache_size;
+    /// Path of the Unix domain socket to listen on. If empty, requests
+    /// are read from stdin and the responses written to stdout.
+    std::string socket;
+};
+
+/// Answer requests for the covering subgraphs of presentations until stdin
+/// is closed or, when listening on a socket, forever.
+///
+/// The protocol is line-based. A request is a line
+///
+///     ID DEGREE PRESENTATION
+///
+/// where ID is a token (without whitespace) chosen by the client and
+/// PRESENTATION is as for parse_presentation. Blank lines and lines
+/// starting with # are skipped. The response consists of a line
+///
+///     ID [[0, 1, 2], [1, 2, 0]]
+///
+/// for each covering subgraph (in the order of SimsTreeBase::list())
+/// followed by a line
+///
+///     ID done COUNT
+///
+/// or, if the request failed, a line
+///
+///     ID error MESSAGE
+///
+/// A client can send further requests without waiting for the response;
+/// the lines of the responses to concurrent requests are interleaved. The
+/// requests of all clients are searched by the threads of the scheduler in
+/// turn, see Scheduler.
+///
+/// A line
+///
+///     ID cancel
+///
+/// cancels the requests with the given ID that are not done yet. Their
+/// response ends with an error line. Requests are also cancelled when the
+/// client closes the socket (or shuts down writing), so a client has to
+/// keep the socket open until it received all responses. This does not
+/// apply to stdin. A line longer than 16 MiB is answered with an error
+/// line (with the ID if the line starts with one, - otherwise) and then
+/// the connection is closed.
+///
+/// The relators (expanded according to the strategy) and the roots of the
+/// subtrees are cached for the most recent presentations and degrees.
+void serve(Scheduler &scheduler, const ServerOptions &options);
+
+} // Namespace cli
+} // Namespace low_index
+
+#endif
@@ -1,5 +1,8 @@
 #include "abstractSimsNode.h"
 
+#include "binaryEncoding.h"
+#include "kernels.h"
+
 #include <limits>
 #include <stdexcept>
 #include <cstring>
@@ -98,11 +101,102 @@ AbstractSimsNode::_copy_memory(const AbstractSimsNode &other)
     std::memcpy(_memory_start(), other._memory_start(), _memory_size);
 }
 
+void
+AbstractSimsNode::set_outgoing_table(
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    _initialize_memory();
+    _set_outgoing_table(degree, outgoing);
+}
+
+void
+AbstractSimsNode::encode(
+    std::string * const bytes,
+    const bool with_lift_state) const
+{
+    append_uint<uint8_t>(bytes, degree());
+    bytes->append(
+        reinterpret_cast<const char*>(_outgoing), rank() * degree());
+    if (!with_lift_state) {
+        return;
+    }
+    // The lift state of vertices larger than the degree has not been
+    // touched since _initialize_memory, so skip them.
+    for (size_t n = 0; n < _num_relators; n++) {
+        for (DegreeType v = 0; v < degree(); v++) {
+            const size_t j = n * max_degree() + v;
+            append_uint<RelatorLengthType>(bytes, _lift_indices[j]);
+            append_uint<DegreeType>(bytes, _lift_vertices[j]);
+        }
+    }
+}
+
+void
+AbstractSimsNode::decode(
+    ByteReader * const reader,
+    const bool with_lift_state)
+{
+    const DegreeType d = reader->read_uint<uint8_t>();
+    set_outgoing_table(d, reader->read_bytes(rank() * d));
+    if (!with_lift_state) {
+        return;
+    }
+    constexpr DegreeType finished =
+        std::numeric_limits<DegreeType>::max();
+
+    for (size_t n = 0; n < _num_relators; n++) {
+        for (DegreeType v = 0; v < d; v++) {
+            const size_t j = n * max_degree() + v;
+            _lift_indices[j] = reader->read_uint<RelatorLengthType>();
+            const DegreeType vertex = reader->read_uint<DegreeType>();
+            // _relator_may_lift uses the vertex to index the tables.
+            if (!((vertex >= 1 && vertex <= d) || vertex == finished)) {
+                throw std::domain_error(
+                    "Lift state with vertex larger than degree.");
+            }
+            _lift_vertices[j] = vertex;
+        }
+    }
+}
+
+void
+AbstractSimsNode::check_lift_state(
+    const std::vector<Relator> &relators) const
+{
+    if (relators.size() > _num_relators) {
+        throw std::domain_error(
+            "check_lift_state: More relators than the node supports.");
+    }
+
+    constexpr DegreeType finished =
+        std::numeric_limits<DegreeType>::max();
+
+    for (size_t n = 0; n < relators.size(); n++) {
+        for (DegreeType v = 0; v < degree(); v++) {
+            const size_t j = n * max_degree() + v;
+            // _relator_may_lift continues at _lift_indices[j] unless the
+            // relator already lifted.
+            if (_lift_vertices[j] != finished &&
+                !(_lift_indices[j] < relators[n].size())) {
+                throw std::domain_error(
+                    "Lift state does not fit the relators.");
+            }
+        }
+    }
+}
+
 bool
 AbstractSimsNode::relators_may_lift(const std::vector<Relator> &relators,
 				    const std::pair<LetterType, DegreeType> slot,
 				    const DegreeType target)
 {
+    // The acceleration structure only has room for num_relators()
+    // relators (none for the SimsNode's returned by SimsTreeBase::list()).
+    if (relators.size() > _num_relators) {
+        throw std::domain_error(
+            "relators_may_lift: More relators than the node supports.");
+    }
     for (size_t n = 0; n < relators.size(); n++) {
         for (DegreeType v = 0; v < degree(); v++) {
 	    DegreeType endVertex = _lift_vertices[n*max_degree() + v];
@@ -120,6 +214,43 @@ AbstractSimsNode::relators_may_lift(const std::vector<Relator> &relators,
     return true;
 }
 
+bool
+AbstractSimsNode::short_relators_lift(
+    const std::vector<Relator> &relators) const
+{
+    if (relators.size() > _num_relators) {
+        throw std::domain_error(
+            "short_relators_lift: More relators than the node supports.");
+    }
+    if (!is_complete()) {
+        throw std::domain_error(
+            "short_relators_lift: The graph is not a covering.");
+    }
+
+    constexpr DegreeType finished =
+        std::numeric_limits<DegreeType>::max();
+
+    for (size_t n = 0; n < relators.size(); n++) {
+        const Relator &relator = relators[n];
+        for (DegreeType v = 0; v < degree(); v++) {
+            const size_t j = n * max_degree() + v;
+            DegreeType vertex = _lift_vertices[j];
+            if (vertex == finished) {
+                continue;
+            }
+            // Since the graph is complete, the lift cannot get stuck
+            // (see _relator_may_lift).
+            for (size_t i = _lift_indices[j]; i < relator.size(); i++) {
+                vertex = act_by(relator[i], vertex);
+            }
+            if (vertex != v + 1) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 bool
 AbstractSimsNode::_relator_may_lift(
     const Relator &relator,
@@ -138,8 +269,10 @@ AbstractSimsNode::_relator_may_lift(
         return true;
     }
 
-    // Continue lifting the relator where we left of.
-    DegreeType next_vertex;
+    // Continue lifting the relator where we left of. The loop always
+    // sets next_vertex, initialize it anyway so that gcc does not warn
+    // when inlining the verified_add_edge below (with LTO).
+    DegreeType next_vertex = 0;
     for (RelatorLengthType i = _lift_indices[j]; true; i++) {
         // Result of lifting the edge given by the next letter in
         // the relator.
@@ -200,6 +333,17 @@ AbstractSimsNode::_relator_may_lift(
 bool
 AbstractSimsNode::relators_lift(const std::vector<Relator> &relators) const
 {
+    if (relators.empty()) {
+        return true;
+    }
+
+    const Kernels &k = kernels();
+    if (is_complete() &&
+        degree() <= k.max_lift_degree && rank() <= k.max_lift_rank) {
+        return k.relators_lift(rank(), degree(), _outgoing, _incoming,
+                               relators);
+    }
+
     for (const Relator &relator : relators) {
         for (DegreeType v = 1; v <= degree(); v++) {
             // Start with vertex v.
@@ -266,15 +410,36 @@ AbstractSimsNode::may_be_minimal() const
     // for any choice of basepoint it returns True.
 
     for (DegreeType basepoint = 2; basepoint <= degree(); basepoint++) {
-        if (!_may_be_minimal(basepoint)) {
+        if (_compare_basepoint(basepoint) < 0) {
             return false;
         }
     }
     return true;
 }
 
-bool
-AbstractSimsNode::_may_be_minimal(const DegreeType basepoint) const
+DegreeType
+AbstractSimsNode::conjugacy_class_size() const
+{
+    if (!is_complete()) {
+        throw std::domain_error(
+            "The conjugacy class size needs a complete covering subgraph.");
+    }
+
+    // The vertices which, as basepoint, give the same covering subgraph
+    // form the orbit of vertex 1 under the normalizer N(H) of the
+    // subgroup H. Their number is thus [N(H):H] and the number of
+    // conjugates of H is [G:N(H)] = degree / [N(H):H].
+    DegreeType num_basepoints = 1;
+    for (DegreeType basepoint = 2; basepoint <= degree(); basepoint++) {
+        if (_compare_basepoint(basepoint) == 0) {
+            num_basepoints++;
+        }
+    }
+    return degree() / num_basepoints;
+}
+
+int
+AbstractSimsNode::_compare_basepoint(const DegreeType basepoint) const
 {
     // Unfortunately, MS Visual Studio does not support
     // C99-style Variable Length Arrays, so we allocate a fixed length array.
@@ -313,7 +478,7 @@ AbstractSimsNode::_may_be_minimal(const DegreeType basepoint) const
                     (alt_to_std[slot_vertex] - 1) * rank() + l];
                 if (a == 0 || b == 0) {
                     // The slot was empty in one indexing, so we cannot decide.
-                    return true;
+                    return 0;
                 }
                 // Update the mappings.
                 DegreeType &c = std_to_alt[b];
@@ -328,17 +493,18 @@ AbstractSimsNode::_may_be_minimal(const DegreeType basepoint) const
                 // Compare the old and new indices of the other end of the edge.
                 if (c < a) {
                     // The new basepoint is better - discard this graph.
-                    return false;
+                    return -1;
                 }
                 if (c > a) {
                     // The old basepoint is better.
-                    return true;
+                    return 1;
                 }
             }
         }
     }
 
-    return true;
+    // Both basepoints give the same covering subgraph.
+    return 0;
 }
 
 } // Namespace low_index
@@ -5,6 +5,8 @@
 
 namespace low_index {
 
+class ByteReader;
+
 ///
 /// A class to list covering subgraphs up to conjugacy for a finitely
 /// presented group G.
@@ -62,11 +64,35 @@ public:
     /// If the subgraph is complete, the answer is definite. That
     /// is, if the subgraph is complete then the answer is true
     /// if and only if the given relators lift.
+    ///
+    /// Throws std::domain_error if there are more relators than
+    /// num_relators(), e.g., for a SimsNode returned by
+    /// SimsTreeBase::list() (use relators_lift instead).
     // bool relators_may_lift(const std::vector<Relator> &relators);
     bool relators_may_lift(const std::vector<Relator> &relators,
 			   const std::pair<LetterType, DegreeType> slot,
 			   const DegreeType target);
 
+    /// For a complete subgraph, check that the given "short" relators
+    /// lift. Gives the same answer as relators_may_lift with target 0,
+    /// continuing the lifts from the acceleration structure, but does not
+    /// update it. Thus, a leaf of the search tree can be checked without
+    /// copying it first.
+    ///
+    /// Throws std::domain_error if the subgraph is not complete or there
+    /// are more relators than num_relators().
+    bool short_relators_lift(const std::vector<Relator> &relators) const;
+
+    /// Check that the acceleration structure used by relators_may_lift
+    /// fits the given "short" relators, that is, that the position up to
+    /// which each relator was lifted is within the relator. This is
+    /// always the case unless the node was decoded (see decode) from
+    /// bytes that were not produced by encode for the same relators.
+    ///
+    /// Throws std::domain_error otherwise or if there are more relators
+    /// than num_relators().
+    void check_lift_state(const std::vector<Relator> &relators) const;
+
     /// We regard two complete covering subgraphs that differ only
     /// by reindexing of the vertices as equivalent. We want to only
     /// list one complete covering subgraph for each such conjugacy
@@ -85,10 +111,71 @@ public:
     /// if and only if the given relators lift.
     bool may_be_minimal() const;
 
+    /// For a complete covering subgraph minimal in its conjugacy class
+    /// (e.g., one found by SimsTreeBase::list()), the number of subgroups
+    /// conjugate to the subgroup H it corresponds to.
+    ///
+    /// This is the degree divided by the number of vertices which give
+    /// the same covering subgraph when chosen as basepoint, that is, the
+    /// index of H in its normalizer. The vertices are found by the same
+    /// comparison of basepoints as in may_be_minimal.
+    ///
+    /// Throws std::domain_error if the subgraph is not complete.
+    DegreeType conjugacy_class_size() const;
+
+    /// Replace the graph by the one given by a table of outgoing edges
+    /// for the vertices 1, ..., degree (see
+    /// CoveringSubgraph::outgoing_table for the layout).
+    ///
+    /// The acceleration structure is reset to the one of a graph without
+    /// edges. Thus, if the graph is not complete, call relators_may_lift
+    /// with target 0 to update the acceleration structure before adding
+    /// further edges.
+    void set_outgoing_table(DegreeType degree,
+                            const DegreeType *outgoing);
+
+    /// A cheaper set_outgoing_table to replace the graph by a complete
+    /// one, e.g., to check many covering subgraphs with
+    /// relators_lift without allocating a node for each.
+    ///
+    /// The table has to describe a complete covering subgraph and is not
+    /// validated (CoverStore validates its file when opening it). The
+    /// node must not support any relators (num_relators() == 0) since
+    /// the acceleration structure is not reset.
+    void set_complete_outgoing_table(DegreeType degree,
+                                     const DegreeType *outgoing) {
+        _set_complete_outgoing_table(degree, outgoing);
+    }
+
+    /// Append a compact binary encoding of this node to bytes.
+    ///
+    /// The encoding consists of the degree and the outgoing table (see
+    /// CoveringSubgraph::outgoing_table) and, if with_lift_state, the
+    /// acceleration structure used by relators_may_lift for the vertices
+    /// 1, ..., degree. The rank, max_degree and num_relators are not
+    /// encoded.
+    ///
+    /// The lift state is needed to continue adding edges to an incomplete
+    /// node without calling relators_may_lift with target 0 first.
+    void encode(std::string * bytes, bool with_lift_state) const;
+
+    /// Replace this node by the one encoded with encode. The node needs
+    /// to have the same rank, max_degree and num_relators as the encoded
+    /// node. Throws std::runtime_error if the data are truncated and
+    /// std::domain_error if they do not describe a valid graph or the
+    /// lift state refers to vertices larger than the degree. Since the
+    /// relators are not known here, use check_lift_state before calling
+    /// relators_may_lift.
+    void decode(ByteReader * reader, bool with_lift_state);
+
     /// How many relators are supported by the acceleration structure.
     /// In other words, the number of "short relators".
     unsigned int num_relators() const { return _num_relators; }
 
+    /// Number of bytes used to store the graph and acceleration structure
+    /// (on the heap for a SimsNode).
+    size_t memory_size() const { return _memory_size; }
+
 protected:
     AbstractSimsNode(RankType rank,
                      DegreeType max_degree,
@@ -139,17 +226,19 @@ private:
         size_t n,
         DegreeType v);
 
-    // Helper for may_be_minimal. It checks whether moving the given
-    // basepoint to vertex 1 would produce a covering subgraph
-    // that is smaller than this covering subgraph with respect to
-    // the covering subgraph order.
+    // Helper for may_be_minimal and conjugacy_class_size. It checks
+    // whether moving the given basepoint to vertex 1 would produce a
+    // covering subgraph that is smaller than this covering subgraph with
+    // respect to the covering subgraph order.
     //
-    // More precisely, it returns false if every completion of the
-    // covering subgraph where the given basepoint is moved to vertex
-    // 1 would be smaller than every completion of this covering
-    // subgraph.
+    // More precisely, it returns a negative number if every completion
+    // of the covering subgraph where the given basepoint is moved to
+    // vertex 1 would be smaller than every completion of this covering
+    // subgraph, a positive number if it would be larger and zero if
+    // this cannot be decided yet or if the subgraph is complete and both
+    // covering subgraphs are the same.
     //
-    bool _may_be_minimal(DegreeType basepoint) const;
+    int _compare_basepoint(DegreeType basepoint) const;
 
     const unsigned int _num_relators;
 
@@ -0,0 +1,161 @@
+#ifndef LOW_INDEX_BINARY_ENCODING_H
+#define LOW_INDEX_BINARY_ENCODING_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Helpers for the binary file formats of low_index.
+///
+/// All integers are encoded as little-endian, independent of the platform.
+
+namespace low_index {
+
+/// Append unsigned integer as little-endian to bytes.
+template<typename T>
+inline
+void
+append_uint(std::string * const bytes, const T value)
+{
+    for (size_t i = 0; i < sizeof(T); i++) {
+        bytes->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+/// Read unsigned little-endian integer.
+template<typename T>
+inline
+T
+read_uint(const uint8_t * const p)
+{
+    T result = 0;
+    for (size_t i = 0; i < sizeof(T); i++) {
+        result |= static_cast<T>(p[i]) << (8 * i);
+    }
+    return result;
+}
+
+/// Append unsigned integer as LEB128 varint to bytes, that is 7 bits
+/// per byte starting with the least significant bits and the highest
+/// bit of a byte set if more bytes follow.
+inline
+void
+append_varint(std::string * const bytes, uint64_t value)
+{
+    while (value >= 0x80) {
+        bytes->push_back(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    bytes->push_back(static_cast<char>(value));
+}
+
+/// Reads consecutive values from memory, throwing std::runtime_error
+/// instead of reading past the end.
+class ByteReader
+{
+public:
+    ByteReader(const uint8_t * const data, const size_t size)
+      : _p(data)
+      , _end(data + size)
+    { }
+
+    /// Read unsigned little-endian integer.
+    template<typename T>
+    T read_uint() {
+        return low_index::read_uint<T>(read_bytes(sizeof(T)));
+    }
+
+    /// Read unsigned LEB128 varint (see append_varint).
+    uint64_t read_varint() {
+        uint64_t result = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            const uint8_t byte = *read_bytes(1);
+            result |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return result;
+            }
+        }
+        throw std::runtime_error("Invalid varint.");
+    }
+
+    /// Return pointer to the next n bytes and skip them.
+    const uint8_t * read_bytes(const size_t n) {
+        if (static_cast<size_t>(_end - _p) < n) {
+            throw std::runtime_error("Unexpected end of data.");
+        }
+        const uint8_t * const result = _p;
+        _p += n;
+        return result;
+    }
+
+    /// Whether all bytes have been read.
+    bool at_end() const { return _p == _end; }
+
+    /// Number of bytes not read yet.
+    size_t remaining() const { return _end - _p; }
+
+private:
+    const uint8_t * _p;
+    const uint8_t * const _end;
+};
+
+/// A contiguous range of records in a file written in blocks by several
+/// threads (see ResultFileWriter). The index of such a file lists the
+/// extents in the order of the records.
+struct FileExtent
+{
+    /// Byte offset of the first record in the file.
+    uint64_t offset;
+    /// Number of bytes of the records.
+    uint64_t num_bytes;
+    /// Number of records.
+    uint64_t num_records;
+};
+
+/// Append the number of extents and then offset, num_bytes and num_records
+/// of each extent as uint64 to bytes.
+inline
+void
+append_extents(std::string * const bytes,
+               const std::vector<FileExtent> &extents)
+{
+    append_uint<uint64_t>(bytes, extents.size());
+    for (const FileExtent &extent : extents) {
+        append_uint<uint64_t>(bytes, extent.offset);
+        append_uint<uint64_t>(bytes, extent.num_bytes);
+        append_uint<uint64_t>(bytes, extent.num_records);
+    }
+}
+
+/// Read the extents written by append_extents. Throws std::runtime_error
+/// if an extent is not within [data_begin, data_end) of the file.
+inline
+std::vector<FileExtent>
+read_extents(ByteReader * const reader,
+             const uint64_t data_begin,
+             const uint64_t data_end)
+{
+    const uint64_t n = reader->read_uint<uint64_t>();
+    // Each extent takes 24 bytes, so a corrupt count cannot make us
+    // allocate more than the file size.
+    std::vector<FileExtent> result;
+    for (uint64_t i = 0; i < n; i++) {
+        FileExtent extent;
+        extent.offset = reader->read_uint<uint64_t>();
+        extent.num_bytes = reader->read_uint<uint64_t>();
+        extent.num_records = reader->read_uint<uint64_t>();
+        if (extent.offset < data_begin ||
+            extent.offset > data_end ||
+            extent.num_bytes > data_end - extent.offset) {
+            throw std::runtime_error("Extent exceeds the data of the file.");
+        }
+        result.push_back(extent);
+    }
+    return result;
+}
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,65 @@
+#include "cancellation.h"
+
+#include <utility>
+
+namespace low_index {
+
+CancellationToken::CancellationToken()
+  : _cancelled(false)
+  , _deadline(0)
+{
+}
+
+CancellationToken::CancellationToken(
+    std::shared_ptr<const CancellationToken> parent)
+  : _parent(std::move(parent))
+  , _cancelled(false)
+  , _deadline(0)
+{
+}
+
+void
+CancellationToken::cancel()
+{
+    _cancelled = true;
+}
+
+void
+CancellationToken::set_deadline(const double seconds)
+{
+    _deadline =
+        (std::chrono::steady_clock::now() +
+         std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+             std::chrono::duration<double>(seconds)))
+            .time_since_epoch().count();
+}
+
+bool
+CancellationToken::is_cancelled() const
+{
+    if (_cancelled || (_parent && _parent->is_cancelled())) {
+        return true;
+    }
+    const std::chrono::steady_clock::rep deadline = _deadline;
+    return
+        deadline != 0 &&
+        std::chrono::steady_clock::now().time_since_epoch().count() >=
+            deadline;
+}
+
+static std::atomic<bool (*)()> _interrupt_check(nullptr);
+
+void
+set_interrupt_check(bool (* const check)())
+{
+    _interrupt_check = check;
+}
+
+bool
+interrupt_requested()
+{
+    bool (* const check)() = _interrupt_check;
+    return check && check();
+}
+
+} // Namespace low_index
@@ -0,0 +1,72 @@
+#ifndef LOW_INDEX_CANCELLATION_H
+#define LOW_INDEX_CANCELLATION_H
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+
+namespace low_index {
+
+/// A token to stop one or several searches (see
+/// SimsTreeBase::set_cancellation_token) early, either explicitly by
+/// calling cancel() or when a deadline has passed.
+///
+/// A cancelled search returns the complete covering subgraphs found so
+/// far and SimsTreeBase::is_complete() is false.
+///
+/// All methods are thread-safe, in particular, cancel() can be called
+/// from a different thread while a search is running.
+class CancellationToken
+{
+public:
+    CancellationToken();
+
+    /// A token that is also cancelled when the given parent token (which
+    /// can be null) is cancelled. Used to add a deadline to a token
+    /// without changing the given token.
+    explicit CancellationToken(std::shared_ptr<const CancellationToken> parent);
+
+    /// Request all searches using this token to stop.
+    void cancel();
+
+    /// Request all searches using this token to stop once the given
+    /// number of seconds (from now) has passed.
+    void set_deadline(double seconds);
+
+    /// Whether cancel() was called or the deadline has passed.
+    bool is_cancelled() const;
+
+private:
+    const std::shared_ptr<const CancellationToken> _parent;
+    std::atomic<bool> _cancelled;
+    // Ticks of std::chrono::steady_clock, 0 if there is no deadline.
+    std::atomic<std::chrono::steady_clock::rep> _deadline;
+};
+
+/// Install a function that the searches call periodically (from the
+/// thread that called SimsTreeBase::list()) to check whether the
+/// user interrupted the search. If it returns true, the search stops as
+/// if it was cancelled. The python module uses this to handle Ctrl-C
+/// while the GIL is released.
+///
+/// Pass nullptr to uninstall.
+void set_interrupt_check(bool (*check)());
+
+/// Whether the function installed with set_interrupt_check (if any)
+/// reports an interrupt.
+bool interrupt_requested();
+
+/// Thrown by functions such as permutation_reps if the search stopped
+/// early (e.g., it was interrupted, see set_interrupt_check) but the
+/// caller did not ask for a partial result.
+class SearchInterrupted : public std::runtime_error
+{
+public:
+    SearchInterrupted()
+      : std::runtime_error("The search was interrupted.") { }
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,168 @@
+#include "coverList.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace low_index {
+
+// The first slab is small since the multi-threaded implementation creates
+// many lists with few covering subgraphs. The slabs grow geometrically
+// up to the maximum size.
+static const size_t _min_slab_size = 256;
+static const size_t _max_slab_size = 1 << 16;
+
+CoverList::CoverList()
+  : _rank(0)
+  , _max_degree(0)
+  , _free(nullptr)
+  , _free_size(0)
+  , _next_slab_size(_min_slab_size)
+{
+}
+
+CoverList::CoverList(CoverList &&other)
+  : _rank(other._rank)
+  , _max_degree(other._max_degree)
+  , _slabs(std::move(other._slabs))
+  , _free(other._free)
+  , _free_size(other._free_size)
+  , _next_slab_size(other._next_slab_size)
+  , _tables(std::move(other._tables))
+{
+    other._free = nullptr;
+    other._free_size = 0;
+    other._tables.clear();
+}
+
+CoverList&
+CoverList::operator=(CoverList &&other)
+{
+    _rank = other._rank;
+    _max_degree = other._max_degree;
+    _slabs = std::move(other._slabs);
+    _free = other._free;
+    _free_size = other._free_size;
+    _next_slab_size = other._next_slab_size;
+    _tables = std::move(other._tables);
+
+    other._free = nullptr;
+    other._free_size = 0;
+    other._tables.clear();
+    return *this;
+}
+
+void
+CoverList::_add_slab(const size_t size)
+{
+    const size_t n = std::max(size, _next_slab_size);
+    _slabs.emplace_back(new DegreeType[n]);
+    _free = _slabs.back().get();
+    _free_size = n;
+    _next_slab_size = std::min(2 * _next_slab_size, _max_slab_size);
+}
+
+void
+CoverList::push_back(
+    const RankType rank,
+    const DegreeType max_degree,
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    if (_tables.empty()) {
+        _rank = rank;
+        _max_degree = max_degree;
+    } else if (rank != _rank || max_degree != _max_degree) {
+        throw std::domain_error(
+            "CoverList: Covering subgraph has different rank or "
+            "max_degree.");
+    }
+
+    const size_t n = 1 + rank * degree;
+    if (_free_size < n) {
+        _add_slab(n);
+    }
+    _free[0] = degree;
+    std::copy(outgoing, outgoing + rank * degree, _free + 1);
+    _tables.push_back(_free);
+    _free += n;
+    _free_size -= n;
+}
+
+void
+CoverList::append(CoverList &&other)
+{
+    if (other.empty()) {
+        return;
+    }
+    if (empty()) {
+        _rank = other._rank;
+        _max_degree = other._max_degree;
+    } else if (other._rank != _rank || other._max_degree != _max_degree) {
+        throw std::domain_error(
+            "CoverList: Covering subgraphs have different rank or "
+            "max_degree.");
+    }
+
+    // Moving the slabs keeps the pointers in _tables valid. We keep
+    // filling our own last slab.
+    for (std::unique_ptr<DegreeType[]> &slab : other._slabs) {
+        _slabs.push_back(std::move(slab));
+    }
+    if (_tables.empty()) {
+        _tables.swap(other._tables);
+    } else {
+        _tables.insert(
+            _tables.end(), other._tables.begin(), other._tables.end());
+    }
+
+    // Release the memory of other (clear() would keep the capacity).
+    std::vector<std::unique_ptr<DegreeType[]>>().swap(other._slabs);
+    other._free = nullptr;
+    other._free_size = 0;
+    std::vector<const DegreeType *>().swap(other._tables);
+}
+
+SimsNode
+CoverList::cover(const size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range("Index of covering subgraph out of range.");
+    }
+    return SimsNode(_rank, _max_degree, 0, degree(i), outgoing_table(i));
+}
+
+std::vector<std::vector<DegreeType>>
+CoverList::permutation_rep(const size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range("Index of covering subgraph out of range.");
+    }
+    const DegreeType d = degree(i);
+    const DegreeType * const outgoing = outgoing_table(i);
+
+    std::vector<std::vector<DegreeType>> result;
+    result.reserve(_rank);
+    for (RankType l = 0; l < _rank; l++) {
+        std::vector<DegreeType> r;
+        r.reserve(d);
+        for (DegreeType v = 0; v < d; v++) {
+            r.push_back(outgoing[v * _rank + l] - 1);
+        }
+        result.push_back(std::move(r));
+    }
+    return result;
+}
+
+std::vector<SimsNode>
+CoverList::to_sims_nodes() const
+{
+    std::vector<SimsNode> result;
+    result.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+        result.emplace_back(
+            _rank, _max_degree, 0, degree(i), outgoing_table(i));
+    }
+    return result;
+}
+
+} // Namespace low_index
@@ -0,0 +1,100 @@
+#ifndef LOW_INDEX_COVER_LIST_H
+#define LOW_INDEX_COVER_LIST_H
+
+#include "simsNode.h"
+
+namespace low_index {
+
+/// A compact list of complete covering subgraphs.
+///
+/// A SimsNode carries the acceleration structure for relators_may_lift
+/// which is of no use once the covering subgraph is complete and often
+/// takes most of its memory, and each SimsNode requires its own heap
+/// allocation. This list instead only stores the degree and
+/// CoveringSubgraph::outgoing_table of each covering subgraph, packed into
+/// slabs that are allocated with geometrically growing sizes.
+///
+/// A SimsNode is only created when requested through cover() or
+/// to_sims_nodes(). Such a SimsNode has num_relators() == 0.
+///
+/// All covering subgraphs in a list need to have the same rank and
+/// max_degree.
+///
+class CoverList
+{
+public:
+    CoverList();
+    CoverList(CoverList &&other);
+    CoverList& operator=(CoverList &&other);
+
+    /// Rank of the covering subgraphs (0 while the list is empty).
+    RankType rank() const { return _rank; }
+    /// Maximal degree of the covering subgraphs (0 while the list is
+    /// empty).
+    DegreeType max_degree() const { return _max_degree; }
+    /// Number of covering subgraphs.
+    size_t size() const { return _tables.size(); }
+    /// Whether the list is empty.
+    bool empty() const { return _tables.empty(); }
+
+    /// Append (the outgoing table of) a complete covering subgraph.
+    /// Throws std::domain_error if it has a different rank or max_degree
+    /// than the ones already in the list.
+    void push_back(const CoveringSubgraph &node) {
+        push_back(node.rank(), node.max_degree(),
+                  node.degree(), node.outgoing_table());
+    }
+
+    /// Append a complete covering subgraph given by degree and outgoing
+    /// table.
+    void push_back(RankType rank,
+                   DegreeType max_degree,
+                   DegreeType degree,
+                   const DegreeType * outgoing);
+
+    /// Move all covering subgraphs from other to the end of this list
+    /// (without copying their outgoing tables), leaving other empty.
+    void append(CoverList &&other);
+
+    /// Degree of the i-th covering subgraph. Requires i < size().
+    DegreeType degree(size_t i) const { return _tables[i][0]; }
+    /// Outgoing table of the i-th covering subgraph. Requires i < size().
+    const DegreeType * outgoing_table(size_t i) const {
+        return _tables[i] + 1;
+    }
+
+    /// The i-th covering subgraph as SimsNode.
+    SimsNode cover(size_t i) const;
+    /// Same as cover(i).permutation_rep() but without creating a
+    /// SimsNode.
+    std::vector<std::vector<DegreeType>> permutation_rep(size_t i) const;
+
+    /// All covering subgraphs as SimsNode's.
+    std::vector<SimsNode> to_sims_nodes() const;
+
+private:
+    // Follow rule-of-three/rule-of-five. Use append to combine lists.
+    CoverList(const CoverList &other) = delete;
+    CoverList& operator=(const CoverList& other) = delete;
+
+    // Start a new slab with room for at least size bytes.
+    void _add_slab(size_t size);
+
+    RankType _rank;
+    DegreeType _max_degree;
+
+    // The slabs holding the entries (degree followed by outgoing table).
+    std::vector<std::unique_ptr<DegreeType[]>> _slabs;
+    // Unused part of the last slab allocated by this list.
+    DegreeType * _free;
+    size_t _free_size;
+    // Size of the next slab.
+    size_t _next_slab_size;
+
+    // Start of the entry for each covering subgraph.
+    std::vector<const DegreeType *> _tables;
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,332 @@
+#include "coverStore.h"
+
+#include "words.h"
+#include "binaryEncoding.h"
+#include "resultFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+namespace low_index {
+
+static const char _magic[] = { 'L', 'I', 'C', 'S' };
+static const uint32_t _version = 1;
+// Size of header excluding the number of covering subgraphs per degree.
+static const size_t _header_size = 16;
+// Size of the buffer for each degree when streaming covering subgraphs.
+static const size_t _degree_buffer_size = 1 << 16;
+
+void
+write_cover_store(
+    const std::string &filename,
+    const RankType rank,
+    const DegreeType max_degree,
+    const std::vector<SimsNode> &nodes)
+{
+    // Bucket the nodes by degree.
+    std::vector<std::vector<const SimsNode *>> nodes_by_degree(max_degree);
+    for (const SimsNode &node : nodes) {
+        if (node.rank() != rank) {
+            throw std::domain_error(
+                "write_cover_store: Covering subgraph has wrong rank.");
+        }
+        if (node.degree() > max_degree) {
+            throw std::domain_error(
+                "write_cover_store: Covering subgraph has too large degree.");
+        }
+        if (!node.is_complete()) {
+            throw std::domain_error(
+                "write_cover_store: The graph is not a covering.");
+        }
+        nodes_by_degree[node.degree() - 1].push_back(&node);
+    }
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+
+    std::string header(_magic, sizeof(_magic));
+    append_uint<uint32_t>(&header, _version);
+    append_uint<uint16_t>(&header, rank);
+    append_uint<uint8_t>(&header, max_degree);
+    header.resize(_header_size, 0);
+    for (const std::vector<const SimsNode *> &n : nodes_by_degree) {
+        append_uint<uint64_t>(&header, n.size());
+    }
+    out.write(header.data(), header.size());
+
+    for (DegreeType d = 1; d <= max_degree; d++) {
+        for (const SimsNode * const node : nodes_by_degree[d - 1]) {
+            out.write(
+                reinterpret_cast<const char*>(node->outgoing_table()),
+                rank * d);
+        }
+    }
+
+    if (!out) {
+        throw std::runtime_error("Could not write " + filename);
+    }
+}
+
+void
+write_cover_store(
+    const std::string &filename,
+    const ResultFile &results)
+{
+    const RankType rank = results.rank();
+    const DegreeType max_degree = results.max_degree();
+
+    std::ofstream out(filename, std::ios::binary);
+    if (!out) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+
+    std::string header(_magic, sizeof(_magic));
+    append_uint<uint32_t>(&header, _version);
+    append_uint<uint16_t>(&header, rank);
+    append_uint<uint8_t>(&header, max_degree);
+    header.resize(_header_size, 0);
+    // The covering subgraphs of degree d go to
+    // [positions[d - 1], ends[d - 1]) in the file.
+    std::vector<uint64_t> positions;
+    std::vector<uint64_t> ends;
+    uint64_t position = _header_size + 8 * max_degree;
+    for (DegreeType d = 1; d <= max_degree; d++) {
+        append_uint<uint64_t>(&header, results.num_covers(d));
+        positions.push_back(position);
+        position += results.num_covers(d) * rank * d;
+        ends.push_back(position);
+    }
+    out.write(header.data(), header.size());
+
+    // Make a single pass over the result file, buffering the covering
+    // subgraphs of each degree and writing the buffer to where the degree
+    // goes in the file when it is full.
+    std::vector<std::string> buffers(max_degree);
+    auto flush = [&](const DegreeType d) {
+        std::string &buffer = buffers[d - 1];
+        out.seekp(positions[d - 1]);
+        out.write(buffer.data(), buffer.size());
+        positions[d - 1] += buffer.size();
+        buffer.clear();
+    };
+    const size_t record_size = results.record_size();
+    for (size_t e = 0; e < results.num_extents(); e++) {
+        const uint8_t * record = results.extent_records(e);
+        for (size_t i = 0; i < results.extent_size(e);
+             i++, record += record_size) {
+            const DegreeType d = record[0];
+            if (d < 1 || d > max_degree) {
+                throw std::runtime_error(
+                    "Result file has invalid degree.");
+            }
+            std::string &buffer = buffers[d - 1];
+            buffer.append(
+                reinterpret_cast<const char*>(record + 1), rank * d);
+            if (buffer.size() >= _degree_buffer_size) {
+                flush(d);
+            }
+        }
+    }
+    for (DegreeType d = 1; d <= max_degree; d++) {
+        flush(d);
+        if (positions[d - 1] != ends[d - 1]) {
+            throw std::runtime_error(
+                "Result file has wrong number of covering subgraphs.");
+        }
+    }
+
+    out.close();
+    if (!out) {
+        throw std::runtime_error("Could not write " + filename);
+    }
+}
+
+CoverStore::CoverStore(const std::string &filename)
+  : _file(filename)
+{
+    const uint8_t * const data = _file.data();
+
+    if (_file.size() < _header_size ||
+        std::memcmp(data, _magic, sizeof(_magic)) != 0) {
+        throw std::runtime_error(filename + " is not a cover store.");
+    }
+    if (read_uint<uint32_t>(data + 4) != _version) {
+        throw std::runtime_error(
+            filename + " has unsupported cover store version.");
+    }
+    _rank = read_uint<uint16_t>(data + 8);
+    _max_degree = read_uint<uint8_t>(data + 10);
+
+    size_t offset = _header_size + 8 * _max_degree;
+    if (_file.size() < offset) {
+        throw std::runtime_error(filename + " is truncated.");
+    }
+
+    _degree_begin.push_back(0);
+    for (DegreeType d = 1; d <= _max_degree; d++) {
+        const uint64_t n = read_uint<uint64_t>(
+            data + _header_size + 8 * (d - 1));
+        // Check against the file size before multiplying so that a
+        // corrupt header cannot overflow offset.
+        const size_t cover_size = _rank * d;
+        if (cover_size == 0
+                ? n != 0
+                : n > (_file.size() - offset) / cover_size) {
+            throw std::runtime_error(filename + " has wrong size.");
+        }
+        _degree_offset.push_back(offset);
+        _degree_begin.push_back(_degree_begin.back() + n);
+        offset += n * cover_size;
+    }
+
+    if (_file.size() != offset) {
+        throw std::runtime_error(filename + " has wrong size.");
+    }
+
+    // Check once here that the file only contains complete covering
+    // subgraphs, so that _query can skip the validation.
+    std::vector<uint8_t> has_incoming(_rank * _max_degree);
+    for (DegreeType d = 1; d <= _max_degree; d++) {
+        const DegreeType * table = data + _degree_offset[d - 1];
+        for (size_t i = _degree_begin[d - 1]; i < _degree_begin[d]; i++) {
+            std::fill(has_incoming.begin(),
+                      has_incoming.begin() + _rank * d, 0);
+            for (DegreeType v = 0; v < d; v++) {
+                for (RankType l = 0; l < _rank; l++, table++) {
+                    const DegreeType t = *table;
+                    if (t < 1 || t > d ||
+                        has_incoming[(t - 1) * _rank + l]) {
+                        throw std::runtime_error(
+                            filename +
+                            " has invalid covering subgraph.");
+                    }
+                    has_incoming[(t - 1) * _rank + l] = 1;
+                }
+            }
+        }
+    }
+}
+
+size_t
+CoverStore::num_covers(const DegreeType degree) const
+{
+    if (degree < 1 || degree > _max_degree) {
+        return 0;
+    }
+    return _degree_begin[degree] - _degree_begin[degree - 1];
+}
+
+std::pair<DegreeType, const DegreeType *>
+CoverStore::_cover(const size_t i) const
+{
+    // Find degree d with _degree_begin[d - 1] <= i < _degree_begin[d].
+    const DegreeType d =
+        std::upper_bound(_degree_begin.begin(), _degree_begin.end(), i)
+        - _degree_begin.begin();
+    return {
+        d,
+        _file.data()
+            + _degree_offset[d - 1]
+            + (i - _degree_begin[d - 1]) * _rank * d };
+}
+
+SimsNode
+CoverStore::cover(const size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range("Index of covering subgraph out of range.");
+    }
+    const std::pair<DegreeType, const DegreeType *> c = _cover(i);
+    return SimsNode(_rank, _max_degree, 0, c.first, c.second);
+}
+
+void
+CoverStore::_query(
+    const std::vector<Relator> &long_relators,
+    const size_t begin,
+    const size_t end,
+    std::vector<SimsNode> * const result) const
+{
+    // Re-use the same node for every covering subgraph to avoid
+    // heap allocations. Only copy it if the relators lift.
+    SimsNode node(_rank, _max_degree);
+    for (size_t i = begin; i < end; i++) {
+        const std::pair<DegreeType, const DegreeType *> c = _cover(i);
+        // Validated by the constructor.
+        node.set_complete_outgoing_table(c.first, c.second);
+        if (node.relators_lift(long_relators)) {
+            result->push_back(node);
+        }
+    }
+}
+
+std::vector<SimsNode>
+CoverStore::query(
+    const std::vector<Relator> &long_relators,
+    const unsigned int num_threads) const
+{
+    const unsigned int resolved_num_threads =
+        std::max<unsigned int>(
+            1,
+            (num_threads > 0)
+                ? num_threads
+                : std::thread::hardware_concurrency());
+
+    // Each thread processes a contiguous range of covering subgraphs
+    // so that the results can simply be concatenated in order.
+    std::vector<std::vector<SimsNode>> results(resolved_num_threads);
+    std::vector<std::exception_ptr> errors(resolved_num_threads);
+
+    std::vector<std::thread> threads;
+    threads.reserve(resolved_num_threads);
+    for (unsigned int i = 0; i < resolved_num_threads; i++) {
+        const size_t begin = size() * i / resolved_num_threads;
+        const size_t end = size() * (i + 1) / resolved_num_threads;
+        threads.emplace_back(
+            [this, &long_relators, &results, &errors, begin, end, i]() {
+                try {
+                    _query(long_relators, begin, end, &results[i]);
+                } catch (...) {
+                    // Re-thrown on the calling thread.
+                    errors[i] = std::current_exception();
+                }
+            });
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+    for (const std::exception_ptr &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+
+    std::vector<SimsNode> result;
+    for (std::vector<SimsNode> &r : results) {
+        for (SimsNode &node : r) {
+            result.push_back(std::move(node));
+        }
+    }
+    return result;
+}
+
+std::vector<SimsNode>
+CoverStore::query(
+    const std::vector<std::string> &long_relators,
+    const unsigned int num_threads) const
+{
+    std::vector<Relator> relators;
+    relators.reserve(long_relators.size());
+    for (const std::string &word : long_relators) {
+        relators.push_back(parse_word(_rank, word));
+    }
+    return query(relators, num_threads);
+}
+
+} // Namespace low_index
@@ -0,0 +1,115 @@
+#ifndef LOW_INDEX_COVER_STORE_H
+#define LOW_INDEX_COVER_STORE_H
+
+#include "simsNode.h"
+#include "mappedFile.h"
+
+namespace low_index {
+
+/// Write complete covering subgraphs to a file that can be read with
+/// CoverStore.
+///
+/// The covering subgraphs are grouped by degree, preserving their order
+/// within each degree. They must all have the given rank and a degree of at
+/// most max_degree.
+///
+/// The typical use is to store the complete covering subgraphs for which
+/// the short relators lift (that is the result of SimsTree with no long
+/// relators) once and then query them later for many different sets of long
+/// relators.
+///
+/// File format (all integers are little-endian):
+/// - Header:
+///   - 4 bytes magic "LICS"
+///   - uint32 version (currently 1)
+///   - uint16 rank
+///   - uint8 max_degree
+///   - 5 bytes reserved (zero)
+///   - For each degree d = 1, ..., max_degree: uint64 number of covering
+///     subgraphs of degree d.
+/// - For each degree d = 1, ..., max_degree: the
+///   CoveringSubgraph::outgoing_table of the covering subgraphs of degree d,
+///   each taking rank * d bytes.
+void
+write_cover_store(
+    const std::string &filename,
+    RankType rank,
+    DegreeType max_degree,
+    const std::vector<SimsNode> &nodes);
+
+/// Write the complete covering subgraphs of a result file (see
+/// SimsTreeBase::list_to_file) to a file that can be read with CoverStore.
+///
+/// Unlike the above, this streams the covering subgraphs, so they do not
+/// need to fit into memory.
+void
+write_cover_store(
+    const std::string &filename,
+    const class ResultFile &results);
+
+/// A query engine for a file written by write_cover_store.
+///
+/// The file is memory-mapped, so it can be larger than the available
+/// memory. Opening it reads it once to check that it only contains
+/// complete covering subgraphs.
+///
+class CoverStore
+{
+public:
+    /// Open and map file. Throws std::runtime_error if the file cannot
+    /// be read, is not in the right format or contains graphs that are
+    /// not complete covering subgraphs.
+    CoverStore(const std::string &filename);
+
+    /// Rank of the covering subgraphs.
+    RankType rank() const { return _rank; }
+    /// Maximal degree of the covering subgraphs.
+    DegreeType max_degree() const { return _max_degree; }
+    /// Total number of covering subgraphs in file.
+    size_t size() const { return _degree_begin.back(); }
+    /// Number of covering subgraphs in file of given degree.
+    size_t num_covers(DegreeType degree) const;
+
+    /// The i-th covering subgraph in the file.
+    SimsNode cover(size_t i) const;
+
+    /// All covering subgraphs in the file for which the given relators
+    /// lift (in the order of the file, that is grouped by degree).
+    ///
+    /// See permutation_reps for num_threads.
+    std::vector<SimsNode> query(
+        const std::vector<Relator> &long_relators,
+        unsigned int num_threads = 0) const;
+
+    /// An overload of query that takes the relators as SnapPy-style
+    /// words.
+    std::vector<SimsNode> query(
+        const std::vector<std::string> &long_relators,
+        unsigned int num_threads = 0) const;
+
+private:
+    // The memory-mapped file.
+    MappedFile _file;
+
+    RankType _rank;
+    DegreeType _max_degree;
+
+    // Index of first covering subgraph of degree d is at _degree_begin[d - 1]
+    // (and _degree_begin[max_degree] is the total number).
+    std::vector<size_t> _degree_begin;
+    // Byte offset into file where the covering subgraphs of degree d start
+    // at _degree_offset[d - 1].
+    std::vector<size_t> _degree_offset;
+
+    // Degree and outgoing table of the i-th covering subgraph.
+    std::pair<DegreeType, const DegreeType *> _cover(size_t i) const;
+
+    // Query covering subgraphs with index in [begin, end).
+    void _query(const std::vector<Relator> &long_relators,
+                size_t begin, size_t end,
+                std::vector<SimsNode> * result) const;
+};
+
+} // Namespace low_index
+
+#endif
@@ -1,7 +1,10 @@
 #include "coveringSubgraph.h"
 
+#include "kernels.h"
+
 #include <stdexcept>
 #include <cstdlib>
+#include <cstring>
 
 namespace low_index {
 
@@ -152,6 +155,73 @@ CoveringSubgraph::_add_edge(
     return true;
 }
 
+void
+CoveringSubgraph::_set_outgoing_table(
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    if (!(degree >= 1 && degree <= _max_degree)) {
+        throw std::domain_error(
+            "Degree has to be between 1 and " +
+            std::to_string(static_cast<int>(_max_degree)));
+    }
+
+    _degree = degree;
+    _num_edges = 0;
+    _slot_index = 0;
+
+    for (DegreeType v = 0; v < degree; v++) {
+        for (RankType l = 0; l < _rank; l++) {
+            const unsigned int out_index = v * _rank + l;
+            const DegreeType t = outgoing[out_index];
+            if (t == 0) {
+                continue;
+            }
+            if (t > degree) {
+                throw std::domain_error(
+                    "Edge ending at vertex larger than degree.");
+            }
+            const unsigned int in_index = (t - 1) * _rank + l;
+            if (_incoming[in_index] != 0) {
+                throw std::domain_error(
+                    "Two edges with the same label ending at the same "
+                    "vertex.");
+            }
+            _outgoing[out_index] = t;
+            _incoming[in_index] = v + 1;
+            _num_edges++;
+        }
+    }
+}
+
+void
+CoveringSubgraph::_set_complete_outgoing_table(
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    const unsigned int n = _rank * degree;
+    // Clear the vertices of the old graph beyond the new degree so that
+    // the memory looks the same as after _set_outgoing_table.
+    if (degree < _degree) {
+        const unsigned int old_n = _rank * _degree;
+        std::memset(_outgoing + n, 0, old_n - n);
+        std::memset(_incoming + n, 0, old_n - n);
+    }
+
+    std::memcpy(_outgoing, outgoing, n);
+    // Since the graph is complete, this overwrites all incoming edges.
+    for (DegreeType v = 0; v < degree; v++) {
+        for (RankType l = 0; l < _rank; l++) {
+            const DegreeType t = outgoing[v * _rank + l];
+            _incoming[(t - 1) * _rank + l] = v + 1;
+        }
+    }
+
+    _degree = degree;
+    _num_edges = n;
+    _slot_index = 0;
+}
+
 DegreeType
 CoveringSubgraph::act_by(const LetterType letter, const DegreeType vertex) const
 {
@@ -171,22 +241,19 @@ CoveringSubgraph::first_empty_slot() const
         return { 0, 0 };
     }
 
-    for(unsigned int n = _slot_index; n < max_edges; n++) {
-        if (_outgoing[n] == 0) {
-            const std::div_t qr = std::div(
-                static_cast<int>(n), static_cast<int>(_rank));
-            _slot_index = n;
-            return { qr.rem + 1, qr.quot + 1 };
-        }
-        if (_incoming[n] == 0) {
-            const std::div_t qr = std::div(
-                static_cast<int>(n), static_cast<int>(_rank));
-            _slot_index = n;
-            return { -(qr.rem + 1), qr.quot + 1 };
-        }
+    const unsigned int n = kernels().find_empty_slot(
+        _outgoing, _incoming, _slot_index, max_edges);
+    if (n == max_edges) {
+        return {0, 0};
     }
 
-    return {0, 0};
+    const std::div_t qr = std::div(
+        static_cast<int>(n), static_cast<int>(_rank));
+    _slot_index = n;
+    if (_outgoing[n] == 0) {
+        return { qr.rem + 1, qr.quot + 1 };
+    }
+    return { -(qr.rem + 1), qr.quot + 1 };
 }
 
 } // Namespace low_index
@@ -118,6 +118,13 @@ public:
     /// on the numbers 0, ..., degree() - 1.
     std::vector<std::vector<DegreeType>> permutation_rep() const;
 
+    /// The table of outgoing edges with rank() * degree() entries.
+    ///
+    /// The entry at (v - 1) * rank() + (l - 1) is the end of the edge
+    /// labeled l starting at vertex v or 0 if there is no such edge.
+    /// This is a compact way to store a complete covering subgraph.
+    const DegreeType * outgoing_table() const { return _outgoing; }
+
     /// String representation - particularly useful for debugging.
     std::string to_string() const;
 
@@ -141,7 +148,25 @@ protected:
     uint8_t * _memory_start() const {
         return _outgoing;
     }
-    
+
+    // Set the graph to the one given by a table of outgoing edges for
+    // vertices 1, ..., degree (in the same layout as _outgoing) and
+    // compute the incoming edges.
+    //
+    // The subclass is responsible for zeroing the memory for _outgoing
+    // and _incoming before calling this. Throws std::domain_error if
+    // the table does not describe a valid graph.
+    void _set_outgoing_table(DegreeType degree,
+                             const DegreeType *outgoing);
+
+    // Like _set_outgoing_table for a table of a complete covering
+    // subgraph that is already known to be valid. Only overwrites the
+    // entries for the vertices up to the larger of the old and new degree
+    // (instead of needing all memory zeroed) and does not validate the
+    // table.
+    void _set_complete_outgoing_table(DegreeType degree,
+                                      const DegreeType *outgoing);
+
 private:
     // Follow rule-of-three/rule-of-five: either implement or delete
     // assignment operator.
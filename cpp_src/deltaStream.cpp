@@ -0,0 +1,254 @@
+#include "deltaStream.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace low_index {
+
+static const char _magic[] = { 'L', 'I', 'D', 'S' };
+static const uint32_t _version = 2;
+// Offsets of the number of covering subgraphs and of the index.
+static const size_t _size_offset = 12;
+static const size_t _index_offset_offset = 20;
+static const size_t _header_size = 28;
+// Flush the records to disk when reaching this size.
+static const size_t _buffer_size = 1 << 20;
+
+void
+append_delta_record(
+    std::string * const bytes,
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    std::vector<DegreeType> * const previous)
+{
+    const size_t n = rank * degree;
+    const size_t m = std::min(n, previous->size());
+    size_t prefix = 0;
+    while (prefix < m && outgoing[prefix] == (*previous)[prefix]) {
+        prefix++;
+    }
+
+    append_uint<uint8_t>(bytes, degree);
+    append_varint(bytes, prefix);
+    bytes->append(
+        reinterpret_cast<const char*>(outgoing + prefix), n - prefix);
+
+    previous->assign(outgoing, outgoing + n);
+}
+
+std::string
+delta_stream_header(
+    const RankType rank,
+    const DegreeType max_degree,
+    const uint64_t size,
+    const uint64_t index_offset)
+{
+    std::string header(_magic, sizeof(_magic));
+    append_uint<uint32_t>(&header, _version);
+    append_uint<uint16_t>(&header, rank);
+    append_uint<uint8_t>(&header, max_degree);
+    append_uint<uint8_t>(&header, 0);
+    append_uint<uint64_t>(&header, size);
+    append_uint<uint64_t>(&header, index_offset);
+    return header;
+}
+
+DeltaStreamWriter::DeltaStreamWriter(
+    const std::string &filename,
+    const RankType rank,
+    const DegreeType max_degree)
+  : _filename(filename)
+  , _rank(rank)
+  , _max_degree(max_degree)
+  , _out(filename, std::ios::binary)
+  , _size(0)
+  , _end(_header_size)
+{
+    if (!_out) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+
+    // The number of covering subgraphs and the index are filled in by
+    // close.
+    const std::string header = delta_stream_header(rank, max_degree, 0, 0);
+    _out.write(header.data(), header.size());
+
+    _buffer.reserve(_buffer_size + 2 * rank * max_degree + 8);
+}
+
+void
+DeltaStreamWriter::write(const CoveringSubgraph &node)
+{
+    if (node.rank() != _rank) {
+        throw std::domain_error(
+            "DeltaStreamWriter: Covering subgraph has wrong rank.");
+    }
+    if (node.degree() > _max_degree) {
+        throw std::domain_error(
+            "DeltaStreamWriter: Covering subgraph has too large degree.");
+    }
+    if (!node.is_complete()) {
+        throw std::domain_error(
+            "DeltaStreamWriter: The graph is not a covering.");
+    }
+    write(node.degree(), node.outgoing_table());
+}
+
+void
+DeltaStreamWriter::write(
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    append_delta_record(&_buffer, _rank, degree, outgoing, &_previous);
+    _size++;
+
+    if (_buffer.size() >= _buffer_size) {
+        _flush();
+    }
+}
+
+void
+DeltaStreamWriter::_flush()
+{
+    _out.write(_buffer.data(), _buffer.size());
+    if (!_out) {
+        throw std::runtime_error("Could not write " + _filename);
+    }
+    _end += _buffer.size();
+    _buffer.clear();
+}
+
+void
+DeltaStreamWriter::close()
+{
+    _flush();
+
+    // All records form one extent.
+    std::vector<FileExtent> extents;
+    if (_size > 0) {
+        extents.push_back({_header_size, _end - _header_size, _size});
+    }
+    std::string index;
+    append_extents(&index, extents);
+    _out.write(index.data(), index.size());
+
+    const std::string header =
+        delta_stream_header(_rank, _max_degree, _size, _end);
+    _out.seekp(0);
+    _out.write(header.data(), header.size());
+    _out.close();
+    if (!_out) {
+        throw std::runtime_error("Could not write " + _filename);
+    }
+}
+
+DeltaStream::DeltaStream(const std::string &filename)
+  : _file(filename)
+  , _degree(0)
+{
+    const uint8_t * const data = _file.data();
+
+    if (_file.size() < _header_size ||
+        std::memcmp(data, _magic, sizeof(_magic)) != 0) {
+        throw std::runtime_error(filename + " is not a delta stream.");
+    }
+    if (read_uint<uint32_t>(data + 4) != _version) {
+        throw std::runtime_error(
+            filename + " has unsupported delta stream version.");
+    }
+    _rank = read_uint<uint16_t>(data + 8);
+    _max_degree = read_uint<uint8_t>(data + 10);
+    _size = read_uint<uint64_t>(data + _size_offset);
+
+    const uint64_t index_offset =
+        read_uint<uint64_t>(data + _index_offset_offset);
+    if (index_offset < _header_size || index_offset > _file.size()) {
+        throw std::runtime_error(filename + " has invalid index offset.");
+    }
+    try {
+        ByteReader reader(data + index_offset, _file.size() - index_offset);
+        _extents = read_extents(&reader, _header_size, index_offset);
+        if (!reader.at_end()) {
+            throw std::runtime_error("Unexpected data after index.");
+        }
+    } catch (const std::runtime_error &e) {
+        throw std::runtime_error(
+            filename + " has invalid index: " + e.what());
+    }
+
+    size_t n = 0;
+    for (const FileExtent &extent : _extents) {
+        if (extent.num_records > _size - n) {
+            throw std::runtime_error(
+                filename + " has wrong number of records.");
+        }
+        n += extent.num_records;
+    }
+    if (n != _size) {
+        throw std::runtime_error(filename + " has wrong number of records.");
+    }
+
+    _current.reserve(_rank * _max_degree);
+    rewind();
+}
+
+void
+DeltaStream::rewind()
+{
+    _extent = 0;
+    _offset = 0;
+    _extent_end = 0;
+    _extent_remaining = 0;
+    _degree = 0;
+    _current.clear();
+}
+
+bool
+DeltaStream::next()
+{
+    while (_extent_remaining == 0) {
+        if (_offset != _extent_end) {
+            throw std::runtime_error(
+                "Delta stream has unexpected data in extent.");
+        }
+        if (_extent == _extents.size()) {
+            return false;
+        }
+        const FileExtent &extent = _extents[_extent++];
+        _offset = extent.offset;
+        _extent_end = extent.offset + extent.num_bytes;
+        _extent_remaining = extent.num_records;
+    }
+
+    ByteReader reader(_file.data() + _offset, _extent_end - _offset);
+    const DegreeType d = reader.read_uint<uint8_t>();
+    if (d < 1 || d > _max_degree) {
+        throw std::runtime_error("Delta stream has invalid degree.");
+    }
+    const size_t n = _rank * d;
+    const uint64_t prefix = reader.read_varint();
+    if (prefix > n || prefix > _current.size()) {
+        throw std::runtime_error("Delta stream has invalid prefix.");
+    }
+    const uint8_t * const suffix = reader.read_bytes(n - prefix);
+
+    _current.resize(prefix);
+    _current.insert(_current.end(), suffix, suffix + (n - prefix));
+    _degree = d;
+
+    _offset = (suffix + (n - prefix)) - _file.data();
+    _extent_remaining--;
+    return true;
+}
+
+SimsNode
+DeltaStream::cover() const
+{
+    if (_degree == 0) {
+        throw std::domain_error("No current covering subgraph.");
+    }
+    return SimsNode(_rank, _max_degree, 0, _degree, _current.data());
+}
+
+} // Namespace low_index
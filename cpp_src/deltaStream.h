@@ -0,0 +1,162 @@
+#ifndef LOW_INDEX_DELTA_STREAM_H
+#define LOW_INDEX_DELTA_STREAM_H
+
+#include "simsNode.h"
+#include "binaryEncoding.h"
+#include "mappedFile.h"
+
+#include <fstream>
+
+namespace low_index {
+
+/// A compressed file format to archive a large number of complete covering
+/// subgraphs, written by DeltaStreamWriter and read by DeltaStream.
+///
+/// Consecutive covering subgraphs in the order of SimsTreeBase::list() tend
+/// to share a long prefix of their outgoing tables (see
+/// CoveringSubgraph::outgoing_table) since siblings in the search tree only
+/// differ in the edges added last. Thus, each covering subgraph is stored
+/// as the length of the prefix it shares with the previous one and the
+/// remaining suffix. The file can be compressed further with a general
+/// purpose compressor such as gzip or zstd.
+///
+/// Unlike ResultFile, the covering subgraphs can only be read
+/// sequentially.
+///
+/// Like ResultFile, the file can be written by several threads appending
+/// blocks of records (see ResultFileWriter), so the index at the end of the
+/// file lists the extents which, concatenated, give the records in the
+/// order of SimsTreeBase::list(). A record following a record of another
+/// thread in this order shares no prefix with it.
+///
+/// File format (all integers are little-endian):
+/// - Header:
+///   - 4 bytes magic "LIDS"
+///   - uint32 version (currently 2)
+///   - uint16 rank
+///   - uint8 max_degree
+///   - 1 byte reserved (zero)
+///   - uint64 number of covering subgraphs
+///   - uint64 byte offset of the index
+/// - Blocks of records. Each record is:
+///   - uint8 degree
+///   - varint (see append_varint) length p of the prefix shared with the
+///     outgoing table of the previous covering subgraph (0 for the first)
+///   - bytes p, ..., rank * degree - 1 of the outgoing table
+/// - Index:
+///   - The extents, see append_extents.
+
+/// Append the record for the covering subgraph given by degree and
+/// outgoing table to bytes (in the above format) and set previous to
+/// its outgoing table.
+void append_delta_record(std::string * bytes,
+                         RankType rank,
+                         DegreeType degree,
+                         const DegreeType * outgoing,
+                         std::vector<DegreeType> * previous);
+
+/// The header of the above format.
+std::string delta_stream_header(RankType rank,
+                                DegreeType max_degree,
+                                uint64_t size,
+                                uint64_t index_offset);
+
+/// Writes complete covering subgraphs to a file in the above format.
+///
+class DeltaStreamWriter
+{
+public:
+    /// Open file for writing. Throws std::runtime_error on failure.
+    DeltaStreamWriter(const std::string &filename,
+                      RankType rank,
+                      DegreeType max_degree);
+
+    /// Append covering subgraph which needs to be complete and have the
+    /// rank and a degree of at most max_degree given to the constructor.
+    /// Throws std::domain_error otherwise.
+    void write(const CoveringSubgraph &node);
+
+    /// Append covering subgraph given by degree and outgoing table
+    /// (without checking it).
+    void write(DegreeType degree, const DegreeType * outgoing);
+
+    /// Number of covering subgraphs written so far.
+    size_t size() const { return _size; }
+
+    /// Finish writing the file. The file is incomplete until this is called.
+    void close();
+
+private:
+    void _flush();
+
+    const std::string _filename;
+    const RankType _rank;
+    const DegreeType _max_degree;
+    std::ofstream _out;
+    // Records not written to _out yet.
+    std::string _buffer;
+    // Outgoing table of previous covering subgraph.
+    std::vector<DegreeType> _previous;
+    size_t _size;
+    // Number of bytes written to _out so far.
+    uint64_t _end;
+};
+
+/// A sequential reader for a file written by DeltaStreamWriter.
+///
+/// The file is memory-mapped. Call next() to advance to the next covering
+/// subgraph and then use degree() and outgoing_table() or cover().
+///
+class DeltaStream
+{
+public:
+    /// Open and map file. Throws std::runtime_error if the file cannot
+    /// be read or is not in the right format.
+    DeltaStream(const std::string &filename);
+
+    /// Rank of the covering subgraphs.
+    RankType rank() const { return _rank; }
+    /// Maximal degree of the covering subgraphs.
+    DegreeType max_degree() const { return _max_degree; }
+    /// Total number of covering subgraphs in file.
+    size_t size() const { return _size; }
+
+    /// Advance to the next covering subgraph. Returns false if there are
+    /// no more covering subgraphs. Throws std::runtime_error if the file
+    /// is corrupt.
+    bool next();
+
+    /// Start reading from the first covering subgraph again.
+    void rewind();
+
+    /// Degree of the current covering subgraph.
+    DegreeType degree() const { return _degree; }
+    /// Outgoing table of the current covering subgraph.
+    const DegreeType * outgoing_table() const { return _current.data(); }
+    /// The current covering subgraph.
+    SimsNode cover() const;
+
+private:
+    // The memory-mapped file.
+    MappedFile _file;
+
+    RankType _rank;
+    DegreeType _max_degree;
+    size_t _size;
+    std::vector<FileExtent> _extents;
+
+    // Index of the next extent.
+    size_t _extent;
+    // Offset of the next record, end of its extent and number of
+    // records left in the extent.
+    size_t _offset;
+    size_t _extent_end;
+    size_t _extent_remaining;
+
+    DegreeType _degree;
+    std::vector<DegreeType> _current;
+};
+
+} // Namespace low_index
+
+#endif
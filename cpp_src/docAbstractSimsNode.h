@@ -68,6 +68,30 @@ static const char *__doc_low_index_AbstractSimsNode_MemoryLayout_size = R"doc()d
 
 static const char *__doc_low_index_AbstractSimsNode_apply_memory_layout = R"doc()doc";
 
+static const char *__doc_low_index_AbstractSimsNode_check_lift_state =
+R"doc(Check that the acceleration structure used by relators_may_lift fits
+the given "short" relators, that is, that the position up to which each
+relator was lifted is within the relator. This is always the case
+unless the node was decoded (see decode) from bytes that were not
+produced by encode for the same relators.
+
+Throws std::domain_error otherwise or if there are more relators than
+num_relators().)doc";
+
+static const char *__doc_low_index_AbstractSimsNode_compare_basepoint = R"doc()doc";
+
+static const char *__doc_low_index_AbstractSimsNode_conjugacy_class_size =
+R"doc(For a complete covering subgraph minimal in its conjugacy class (e.g.,
+one found by SimsTreeBase::list()), the number of subgroups conjugate to
+the subgroup H it corresponds to.
+
+This is the degree divided by the number of vertices which give the
+same covering subgraph when chosen as basepoint, that is, the index of
+H in its normalizer. The vertices are found by the same comparison of
+basepoints as in may_be_minimal.
+
+Throws std::domain_error if the subgraph is not complete.)doc";
+
 static const char *__doc_low_index_AbstractSimsNode_copy_memory = R"doc()doc";
 
 static const char *__doc_low_index_AbstractSimsNode_initialize_memory = R"doc()doc";
@@ -94,8 +118,6 @@ If the subgraph is complete, the answer is definite. That is, if the
 subgraph is complete, then the answer is true if and only if the given
 relators lift.)doc";
 
-static const char *__doc_low_index_AbstractSimsNode_may_be_minimal_2 = R"doc()doc";
-
 static const char *__doc_low_index_AbstractSimsNode_memory_size = R"doc()doc";
 
 static const char *__doc_low_index_AbstractSimsNode_num_relators =
@@ -119,7 +141,21 @@ the class was instantiated.
 
 If the subgraph is complete, the answer is definite. That is, if the
 subgraph is complete then the answer is true if and only if the given
-relators lift.)doc";
+relators lift.
+
+Throws std::domain_error if there are more relators than
+num_relators(), e.g., for a SimsNode returned by SimsTreeBase.list()
+(use relators_lift instead).)doc";
+
+static const char *__doc_low_index_AbstractSimsNode_set_outgoing_table =
+R"doc(Replace the graph by the one given by a table of outgoing edges for
+the vertices 1, ..., degree (see CoveringSubgraph::outgoing_table for
+the layout).
+
+The acceleration structure is reset to the one of a graph without
+edges. Thus, if the graph is not complete, call relators_may_lift with
+target 0 to update the acceleration structure before adding further
+edges.)doc";
 
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
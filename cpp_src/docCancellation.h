@@ -0,0 +1,72 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_CancellationToken =
+R"doc(A token to stop one or several searches (see
+SimsTreeBase.set_cancellation_token) early, either explicitly by calling
+cancel() or when a deadline has passed.
+
+A cancelled search returns the complete covering subgraphs found so far
+and SimsTreeBase.is_complete() is false.
+
+All methods are thread-safe, in particular, cancel() can be called from
+a different thread while a search is running.)doc";
+
+static const char *__doc_low_index_CancellationToken_CancellationToken = R"doc()doc";
+
+static const char *__doc_low_index_CancellationToken_CancellationToken_2 =
+R"doc(A token that is also cancelled when the given parent token (which can
+be null) is cancelled. Used to add a deadline to a token without
+changing the given token.)doc";
+
+static const char *__doc_low_index_CancellationToken_cancel = R"doc(Request all searches using this token to stop.)doc";
+
+static const char *__doc_low_index_CancellationToken_is_cancelled = R"doc(Whether cancel() was called or the deadline has passed.)doc";
+
+static const char *__doc_low_index_CancellationToken_set_deadline =
+R"doc(Request all searches using this token to stop once the given number of
+seconds (from now) has passed.)doc";
+
+static const char *__doc_low_index_SearchInterrupted =
+R"doc(Thrown by functions such as permutation_reps if the search stopped
+early (e.g., it was interrupted, see set_interrupt_check) but the
+caller did not ask for a partial result.)doc";
+
+static const char *__doc_low_index_interrupt_requested =
+R"doc(Whether the function installed with set_interrupt_check (if any)
+reports an interrupt.)doc";
+
+static const char *__doc_low_index_set_interrupt_check =
+R"doc(Install a function that the searches call periodically (from the
+thread that called SimsTreeBase::list()) to check whether the user
+interrupted the search. If it returns true, the search stops as if it
+was cancelled. The python module uses this to handle Ctrl-C while the
+GIL is released.
+
+Pass nullptr to uninstall.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
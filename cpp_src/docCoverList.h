@@ -0,0 +1,55 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_CoverList =
+R"doc(A compact list of complete covering subgraphs, e.g., the result of
+SimsTreeBase.list_compact.
+
+A SimsNode carries the acceleration structure for relators_may_lift
+which is of no use once the covering subgraph is complete and often
+takes most of its memory. This list instead only stores the degree and
+CoveringSubgraph.outgoing_table of each covering subgraph.
+
+A SimsNode is only created when requested through indexing or
+to_sims_nodes. Such a SimsNode has num_relators() == 0.)doc";
+
+static const char *__doc_low_index_CoverList_cover = R"doc(The i-th covering subgraph as SimsNode.)doc";
+
+static const char *__doc_low_index_CoverList_degree = R"doc(Degree of the i-th covering subgraph.)doc";
+
+static const char *__doc_low_index_CoverList_max_degree = R"doc(Maximal degree of the covering subgraphs (0 while the list is empty).)doc";
+
+static const char *__doc_low_index_CoverList_permutation_rep =
+R"doc(Same as cover(i).permutation_rep() but without creating a SimsNode.)doc";
+
+static const char *__doc_low_index_CoverList_rank = R"doc(Rank of the covering subgraphs (0 while the list is empty).)doc";
+
+static const char *__doc_low_index_CoverList_size = R"doc(Number of covering subgraphs.)doc";
+
+static const char *__doc_low_index_CoverList_to_sims_nodes = R"doc(All covering subgraphs as SimsNode's.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
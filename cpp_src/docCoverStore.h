@@ -0,0 +1,90 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_CoverStore =
+R"doc(A query engine for a file written by write_cover_store.
+
+The file is memory-mapped, so it can be larger than the available
+memory. Opening it reads it once to check that it only contains
+complete covering subgraphs.)doc";
+
+static const char *__doc_low_index_CoverStore_CoverStore =
+R"doc(Open and map file. Throws std::runtime_error if the file cannot be
+read, is not in the right format or contains graphs that are not
+complete covering subgraphs.)doc";
+
+static const char *__doc_low_index_CoverStore_cover = R"doc(The i-th covering subgraph in the file.)doc";
+
+static const char *__doc_low_index_CoverStore_cover_2 = R"doc()doc";
+
+static const char *__doc_low_index_CoverStore_degree_begin = R"doc()doc";
+
+static const char *__doc_low_index_CoverStore_degree_offset = R"doc()doc";
+
+static const char *__doc_low_index_CoverStore_file = R"doc()doc";
+
+static const char *__doc_low_index_CoverStore_max_degree = R"doc(Maximal degree of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_CoverStore_num_covers = R"doc(Number of covering subgraphs in file of given degree.)doc";
+
+static const char *__doc_low_index_CoverStore_query =
+R"doc(All covering subgraphs in the file for which the given relators lift
+(in the order of the file, that is grouped by degree).
+
+See permutation_reps for num_threads.)doc";
+
+static const char *__doc_low_index_CoverStore_query_2 =
+R"doc(An overload of query that takes the relators as SnapPy-style words.)doc";
+
+static const char *__doc_low_index_CoverStore_query_3 = R"doc()doc";
+
+static const char *__doc_low_index_CoverStore_rank = R"doc(Rank of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_CoverStore_size = R"doc(Total number of covering subgraphs in file.)doc";
+
+static const char *__doc_low_index_write_cover_store =
+R"doc(Write complete covering subgraphs to a file that can be read with
+CoverStore.
+
+The covering subgraphs are grouped by degree, preserving their order
+within each degree. They must all have the given rank and a degree of
+at most max_degree.
+
+The typical use is to store the complete covering subgraphs for which
+the short relators lift (that is the result of SimsTree with no long
+relators) once and then query them later for many different sets of
+long relators.)doc";
+
+static const char *__doc_low_index_write_cover_store_2 =
+R"doc(Write the complete covering subgraphs of a result file (see
+SimsTreeBase.list_to_file) to a file that can be read with CoverStore.
+
+Unlike the above, this streams the covering subgraphs, so they do not
+need to fit into memory.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
+
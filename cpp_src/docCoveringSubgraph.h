@@ -125,6 +125,13 @@ static const char *__doc_low_index_CoveringSubgraph_operator_assign = R"doc()doc
 
 static const char *__doc_low_index_CoveringSubgraph_outgoing = R"doc()doc";
 
+static const char *__doc_low_index_CoveringSubgraph_outgoing_table =
+R"doc(The table of outgoing edges with rank() * degree() entries.
+
+The entry at (v - 1) * rank() + (l - 1) is the end of the edge labeled
+l starting at vertex v or 0 if there is no such edge. This is a compact
+way to store a complete covering subgraph.)doc";
+
 static const char *__doc_low_index_CoveringSubgraph_permutation_rep =
 R"doc(Give the representation into the symmetric group S_degree. That is,
 for each letter, give the corresponding permutation on the numbers 1,
@@ -134,6 +141,8 @@ static const char *__doc_low_index_CoveringSubgraph_rank = R"doc(Rank. That is n
 
 static const char *__doc_low_index_CoveringSubgraph_rank_2 = R"doc()doc";
 
+static const char *__doc_low_index_CoveringSubgraph_set_outgoing_table = R"doc()doc";
+
 static const char *__doc_low_index_CoveringSubgraph_slot_index = R"doc()doc";
 
 static const char *__doc_low_index_CoveringSubgraph_to_string = R"doc(String representation - particularly useful for debugging.)doc";
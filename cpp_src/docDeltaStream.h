@@ -0,0 +1,75 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_DeltaStream =
+R"doc(A sequential reader for a file written by DeltaStreamWriter or by
+SimsTreeBase.list_to_file with delta_compressed set.
+
+Iterating over it yields the covering subgraphs (in the order they were
+written) as SimsNode's.)doc";
+
+static const char *__doc_low_index_DeltaStream_DeltaStream =
+R"doc(Open and map file. Throws std::runtime_error if the file cannot be
+read or is not in the right format.)doc";
+
+static const char *__doc_low_index_DeltaStream_max_degree = R"doc(Maximal degree of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_DeltaStream_next =
+R"doc(Advance to the next covering subgraph. Returns false if there are no
+more covering subgraphs. Throws std::runtime_error if the file is
+corrupt.)doc";
+
+static const char *__doc_low_index_DeltaStream_rank = R"doc(Rank of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_DeltaStream_rewind = R"doc(Start reading from the first covering subgraph again.)doc";
+
+static const char *__doc_low_index_DeltaStream_size = R"doc(Total number of covering subgraphs in file.)doc";
+
+static const char *__doc_low_index_DeltaStreamWriter =
+R"doc(Writes complete covering subgraphs to a compressed file.
+
+Consecutive covering subgraphs in the order of SimsTreeBase.list() tend
+to share a long prefix of their outgoing tables since siblings in the
+search tree only differ in the edges added last. Thus, each covering
+subgraph is stored as the length of the prefix it shares with the
+previous one and the remaining suffix. The file can be compressed
+further with a general purpose compressor such as gzip or zstd.)doc";
+
+static const char *__doc_low_index_DeltaStreamWriter_DeltaStreamWriter =
+R"doc(Open file for writing. Throws std::runtime_error on failure.)doc";
+
+static const char *__doc_low_index_DeltaStreamWriter_close =
+R"doc(Finish writing the file. The file is incomplete until this is called.)doc";
+
+static const char *__doc_low_index_DeltaStreamWriter_size = R"doc(Number of covering subgraphs written so far.)doc";
+
+static const char *__doc_low_index_DeltaStreamWriter_write =
+R"doc(Append covering subgraph which needs to be complete and have the rank
+and a degree of at most max_degree given to the constructor. Throws
+std::domain_error otherwise.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
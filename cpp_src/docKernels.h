@@ -0,0 +1,48 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_kernel_variant =
+R"doc(The name of the variant of the kernels used by the search.
+
+The innermost loops of the search are compiled for different
+instruction sets and the best variant supported by the CPU is selected
+at runtime. The variants are, from least to most capable: "scalar",
+"ssse3", "avx2" and "avx512" (the latter three on x86-64 only). The
+environment variable LOW_INDEX_KERNEL_VARIANT can be set to the name of
+a variant to use instead of the best one, e.g., "scalar" for testing.)doc";
+
+static const char *__doc_low_index_kernel_variants =
+R"doc(The names of the variants supported by this CPU, from least to most
+capable.)doc";
+
+static const char *__doc_low_index_set_kernel_variant =
+R"doc(Use the variant of the kernels with the given name, or the best one
+supported by the CPU if the name is "auto". Throws std::domain_error if
+the CPU does not support the variant. The results of the search do not
+depend on the variant.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
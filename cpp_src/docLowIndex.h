@@ -23,6 +23,70 @@
 #endif
 
 
+static const char *__doc_low_index_create_cover_store =
+R"doc(Find all complete covering subgraphs for which the short relators
+lift and write them to a file that can be opened with CoverStore.
+
+See permutation_reps for the arguments. CoverStore::query can then be
+used to quickly find the covering subgraphs for which given long
+relators lift (without traversing the search tree again).
+
+The covering subgraphs are streamed through a temporary result file
+next to the given file (see SimsTreeBase.list_to_file), so they do not
+need to fit into memory.
+
+If the search was stopped early (see create_cover_store_partial), the
+file only contains the covering subgraphs found so far.)doc";
+
+static const char *__doc_low_index_create_cover_store_2 =
+R"doc(An overload of create_cover_store that takes the relators as SnapPy-
+style words.)doc";
+
+static const char *__doc_low_index_create_result_file =
+R"doc(A variant of permutation_reps writing the complete covering subgraphs
+to a file that can be read with ResultFile (instead of keeping them in
+memory). Returns the number of complete covering subgraphs. If
+delta_compressed is set, the file needs to be read with DeltaStream
+instead.
+
+See SimsTreeBase.list_to_file. If the search was stopped early (see
+create_result_file_partial), the file only contains the complete
+covering subgraphs found so far.)doc";
+
+static const char *__doc_low_index_create_result_file_2 =
+R"doc(An overload of create_result_file that takes the relators as SnapPy-
+style words.)doc";
+
+static const char *__doc_low_index_estimate_tree_size =
+R"doc(Estimate the size of the search tree that permutation_reps would
+traverse (and thus how long it takes) with the given number of random
+probes. See SimsTreeBase.estimate_size.
+
+The arguments are the same as for permutation_reps. The probes are split
+among num_threads threads.)doc";
+
+static const char *__doc_low_index_estimate_tree_size_2 =
+R"doc(An overload of estimate_tree_size that takes the relators as SnapPy-
+style words.)doc";
+
+static const char *__doc_low_index_merge_permutation_reps =
+R"doc(Combine the results of permutation_reps for all shards into the result
+of permutation_reps without sharding (including the order).
+
+The order of the given shards does not matter.)doc";
+
+static const char *__doc_low_index_permutation_rep_set =
+R"doc(A variant of permutation_reps returning the result as a
+PermutationRepSet.
+
+This avoids creating a list for each permutation. The order of the
+permutation representations in the PermutationRepSet is the same as the
+one returned by permutation_reps.)doc";
+
+static const char *__doc_low_index_permutation_rep_set_2 =
+R"doc(An overload of permutation_rep_set that takes the relators as SnapPy-
+style words.)doc";
+
 static const char *__doc_low_index_permutation_reps =
 R"doc(Given a finitely presented group G, return a permutation
 representation for each subgroup of index up to max_degree.
@@ -68,7 +132,19 @@ strategy.
 The number of threads being used can be forced by num_threads. Note
 that num_threads = 0 automatically determines the number of threads by
 using the number of cores reported by the operating system.
-num_threads = 1 forces the single-threaded implementation.)doc";
+num_threads = 1 forces the single-threaded implementation.
+
+To split the computation across several processes or machines, run
+permutation_reps with the same arguments and with shard_index = 0, ...,
+num_shards - 1 and then combine the results with
+merge_permutation_reps. Each shard only searches part of the search
+tree (see SimsTreeBase.set_shard) and the shards do not need to
+communicate.
+
+Raises KeyboardInterrupt if the search was interrupted by Ctrl-C. Use
+permutation_reps_partial (and so on for the variants below) with a
+CancellationToken and/or a deadline to stop the search early and keep
+the results found so far.)doc";
 
 static const char *__doc_low_index_permutation_reps_2 =
 R"doc(An overload of permutation_reps that takes the relators as SnapPy-
@@ -80,6 +156,35 @@ and A, B, C, ... correspond to the inverse generators.
 If rank > 26, the generators are encoded as x1, x2, ... and the
 inverse generators as X1, X2, ...)doc";
 
+static const char *__doc_low_index_permutation_reps_batched =
+R"doc(A variant of permutation_reps for a family of groups sharing the same
+short_relators but differing in the long relators.
+
+The i-th entry of the result is the same (including order) as
+permutation_reps for the group with short_relators and long_relators +
+long_relator_sets[i] as relators.
+
+The search tree is only traversed once and each complete covering
+subgraph found is checked against all sets of long relators. This is
+much faster than calling permutation_reps for each set separately,
+e.g., when enumerating the covers for many Dehn-fillings of the same
+cusped manifold.)doc";
+
+static const char *__doc_low_index_permutation_reps_batched_2 =
+R"doc(An overload of permutation_reps_batched that takes the relators as
+SnapPy-style words.)doc";
+
+static const char *__doc_low_index_sample_covers =
+R"doc(Draw random covers with importance weights, see
+SimsTreeBase.sample_covers.
+
+The arguments are the same as for permutation_reps. The probes are split
+among num_threads threads.)doc";
+
+static const char *__doc_low_index_sample_covers_2 =
+R"doc(An overload of sample_covers that takes the relators as SnapPy-style
+words.)doc";
+
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
@@ -0,0 +1,60 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_MemoryLimitExceeded =
+R"doc(Thrown by SimsTreeBase.list() (and its variants) when the search was
+stopped because it would have used more memory than the limit given to
+SimsTreeBase.set_memory_limit.)doc";
+
+static const char *__doc_low_index_MemoryUsage =
+R"doc(The memory (in bytes) used by a search, see
+SimsTreeBase.memory_usage.
+
+This accounts for the data structures of the search, not for the
+overhead of the allocator, so the resident memory of the process is
+somewhat larger.)doc";
+
+static const char *__doc_low_index_MemoryUsage_complete_nodes =
+R"doc(The complete covering subgraphs found (in the compact form of
+CoverList). Those written to a file by list_to_file are not included.)doc";
+
+static const char *__doc_low_index_MemoryUsage_peak = R"doc(The largest total during the last call to list() (or a variant).)doc";
+
+static const char *__doc_low_index_MemoryUsage_pending_nodes =
+R"doc(The nodes whose subtrees still need to be searched, that is, the parts
+of the search tree that SimsTreeMultiThreaded materializes to
+distribute work between the threads.)doc";
+
+static const char *__doc_low_index_MemoryUsage_relators = R"doc(The short and long relators.)doc";
+
+static const char *__doc_low_index_MemoryUsage_stack_frames =
+R"doc(The memory allocated by each thread to recurse a node: room for rank *
+max_degree + 2 nodes (see SimsNodeStack).)doc";
+
+static const char *__doc_low_index_MemoryUsage_total = R"doc(Sum of the above.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,76 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_PermutationRepSet =
+R"doc(A compact container for the permutation representations of complete
+covering subgraphs.
+
+Returning permutation representations as nested lists (as
+permutation_reps does) requires creating a python object for each
+permutation, which is costly. This container instead stores all
+permutations in one flat buffer.
+
+Within this buffer, the permutation representations are grouped by
+degree. The permutation representations of degree d form an array of
+shape num_reps(d) x rank x d where the entry at (i, l, v) is the image
+of v under the permutation for generator l (0-based). This array is
+exposed through the buffer protocol, e.g., numpy.asarray(reps.array(d)).
+
+The permutation representations of a degree are in the same order as
+the complete covering subgraphs given to the constructor. The container
+also remembers the order across degrees so that list(reps) gives the
+same result as permutation_reps.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_PermutationRepSet =
+R"doc(Create the permutation representations for the given complete
+covering subgraphs which need to have the given rank and a degree of at
+most max_degree.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_PermutationRepSet_2 =
+R"doc(Create the permutation representations for the covering subgraphs in
+the given CoverList which need to have the given rank and a degree of
+at most max_degree.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_data =
+R"doc(The num_reps(degree) x rank x degree array of the permutation
+representations of the given degree (supporting the buffer protocol).)doc";
+
+static const char *__doc_low_index_PermutationRepSet_degree = R"doc(Degree of the i-th permutation representation.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_max_degree = R"doc(Maximal degree of the permutation representations.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_num_reps = R"doc(Number of permutation representations of the given degree.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_permutation_rep =
+R"doc(The i-th permutation representation in the same form as an entry of
+the result of permutation_reps.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_rank = R"doc(Number of generators.)doc";
+
+static const char *__doc_low_index_PermutationRepSet_size = R"doc(Number of permutation representations.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
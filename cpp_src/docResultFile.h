@@ -0,0 +1,72 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_ResultFile =
+R"doc(A reader for a file written by SimsTreeBase.list_to_file.
+
+The file is memory-mapped, so opening it is cheap and it can be larger
+than the available memory.
+
+The covering subgraphs are stored as records of a fixed size. Each
+record consists of the degree followed by the outgoing table (see
+CoveringSubgraph.outgoing_table) padded with zeros to rank * max_degree
+entries. Since several threads write the records, they form
+num_extents arrays of consecutive records which, concatenated, give
+the records in the order of SimsTreeBase.list(). The i-th extent is
+exposed through the buffer protocol as array of shape n x record_size,
+e.g., numpy.asarray(file.extent(i)).)doc";
+
+static const char *__doc_low_index_ResultFile_ResultFile =
+R"doc(Open and map file. Throws std::runtime_error if the file cannot be
+read or is not in the right format.)doc";
+
+static const char *__doc_low_index_ResultFile_cover = R"doc(The i-th covering subgraph in the file.)doc";
+
+static const char *__doc_low_index_ResultFile_degree = R"doc(Degree of the i-th covering subgraph.)doc";
+
+static const char *__doc_low_index_ResultFile_extent_records =
+R"doc(The records of the i-th extent as object supporting the buffer
+protocol (keeping the file alive).)doc";
+
+static const char *__doc_low_index_ResultFile_extent_size = R"doc(Number of records of the i-th extent.)doc";
+
+static const char *__doc_low_index_ResultFile_max_degree = R"doc(Maximal degree of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_ResultFile_num_covers = R"doc(Number of covering subgraphs in file of given degree.)doc";
+
+static const char *__doc_low_index_ResultFile_num_extents =
+R"doc(Number of extents, i.e., arrays of consecutive records such that
+concatenating them gives the records in the order of
+SimsTreeBase.list(). The extents can be read in parallel.)doc";
+
+static const char *__doc_low_index_ResultFile_rank = R"doc(Rank of the covering subgraphs.)doc";
+
+static const char *__doc_low_index_ResultFile_record_size = R"doc(Size of a record in bytes, that is 1 + rank * max_degree.)doc";
+
+static const char *__doc_low_index_ResultFile_size = R"doc(Total number of covering subgraphs in file.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
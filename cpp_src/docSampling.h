@@ -0,0 +1,89 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_CoverSample =
+R"doc(The result of SimsTreeBase.sample_covers.
+
+Contains the covers found by the random probes together with their
+importance weights, that is, the inverse of the probability that a probe
+reaches the cover. Probes that ended in a leaf that is not a result of
+list() contribute nothing.
+
+For a function f on the covers, the sum of weights[i] * f(covers[i])
+divided by num_samples is an unbiased estimate of the sum of f over all
+covers found by list(). Dividing by the sum of the weights instead
+estimates the mean of f over all covers, e.g., the fraction of covers
+with a given property.)doc";
+
+static const char *__doc_low_index_CoverSample_covers = R"doc(The covers found, in the order of the probes.)doc";
+
+static const char *__doc_low_index_CoverSample_num_samples = R"doc(Number of random probes.)doc";
+
+static const char *__doc_low_index_CoverSample_probes = R"doc(The index of the probe that found each cover.)doc";
+
+static const char *__doc_low_index_CoverSample_weights = R"doc(The weight of each cover.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate =
+R"doc(The result of SimsTreeBase.estimate_size.
+
+Each random probe gives an unbiased estimate of the number of nodes and
+complete covering subgraphs. The values here are the means over all
+probes. The errors are the standard errors of these means, so that
+value +/- 2 * error is roughly a 95% confidence interval. Note that the
+estimates of individual probes can vary wildly for unbalanced search
+trees, so the intervals are only trustworthy for a large number of
+probes.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_covers =
+R"doc(Estimated number of complete covering subgraphs of degree d found by
+list() at index d - 1.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_covers_error = R"doc(Standard errors for covers.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_estimated_seconds =
+R"doc(Estimated time in seconds for a single-threaded list(), extrapolating
+the time the probes took per node.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_nodes =
+R"doc(Estimated number of nodes of the search tree with d vertices at index
+d - 1.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_nodes_error = R"doc(Standard errors for nodes.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_nodes_probed = R"doc(Number of nodes visited by all probes together.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_num_probes = R"doc(Number of random probes.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_total_covers = R"doc(Estimated total number of complete covering subgraphs.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_total_covers_error = R"doc(Standard error for total_covers.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_total_nodes = R"doc(Estimated total number of nodes of the search tree.)doc";
+
+static const char *__doc_low_index_TreeSizeEstimate_total_nodes_error = R"doc(Standard error for total_nodes.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,101 @@
+/*
+  This file contains docstrings for use in the Python bindings.
+  Do not edit! They were automatically extracted by pybind11_mkdoc.
+ */
+
+#define __EXPAND(x)                                      x
+#define __COUNT(_1, _2, _3, _4, _5, _6, _7, COUNT, ...)  COUNT
+#define __VA_SIZE(...)                                   __EXPAND(__COUNT(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1))
+#define __CAT1(a, b)                                     a ## b
+#define __CAT2(a, b)                                     __CAT1(a, b)
+#define __DOC1(n1)                                       __doc_##n1
+#define __DOC2(n1, n2)                                   __doc_##n1##_##n2
+#define __DOC3(n1, n2, n3)                               __doc_##n1##_##n2##_##n3
+#define __DOC4(n1, n2, n3, n4)                           __doc_##n1##_##n2##_##n3##_##n4
+#define __DOC5(n1, n2, n3, n4, n5)                       __doc_##n1##_##n2##_##n3##_##n4##_##n5
+#define __DOC6(n1, n2, n3, n4, n5, n6)                   __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6
+#define __DOC7(n1, n2, n3, n4, n5, n6, n7)               __doc_##n1##_##n2##_##n3##_##n4##_##n5##_##n6##_##n7
+#define DOC(...)                                         __EXPAND(__EXPAND(__CAT2(__DOC, __VA_SIZE(__VA_ARGS__)))(__VA_ARGS__))
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-variable"
+#endif
+
+
+static const char *__doc_low_index_PerfCounts =
+R"doc(Hardware performance counters for one phase of a search, summed over
+all threads, see SearchStatistics.perf_counters.)doc";
+
+static const char *__doc_low_index_PerfCounts_calls = R"doc(Number of times the phase was run.)doc";
+
+static const char *__doc_low_index_PerfCounts_instructions_per_cycle = R"doc(instructions / cycles.)doc";
+
+static const char *__doc_low_index_SearchStatistics =
+R"doc(A snapshot of the counters of a search, see SimsTreeBase.statistics.
+
+All counters are summed over all threads. If statistics_enabled is
+false, all counters are zero. To enable them, set the environment
+variable LOW_INDEX_STATISTICS=1 when building low_index.)doc";
+
+static const char *__doc_low_index_SearchStatistics_children_tried =
+R"doc(Number of children of incomplete nodes that were tried, i.e., edges
+added to a node.)doc";
+
+static const char *__doc_low_index_SearchStatistics_covers_found =
+R"doc(Number of complete covering subgraphs found (counted once for each set
+of long relators given to SimsTreeBase.list_batched it is a result
+for).)doc";
+
+static const char *__doc_low_index_SearchStatistics_deductions =
+R"doc(Number of edges added by relators_may_lift (as deductions of the short
+relators).)doc";
+
+static const char *__doc_low_index_SearchStatistics_elapsed =
+R"doc(Seconds since list() (or a variant) was called - or how long it took
+if it has finished.)doc";
+
+static const char *__doc_low_index_SearchStatistics_long_relator_checks =
+R"doc(Number of times a complete node was checked against a (non-empty) set
+of long relators.)doc";
+
+static const char *__doc_low_index_SearchStatistics_long_relator_failures =
+R"doc(Number of those checks where the long relators did not lift.)doc";
+
+static const char *__doc_low_index_SearchStatistics_minimality_pruned = R"doc(Number of children rejected by may_be_minimal.)doc";
+
+static const char *__doc_low_index_SearchStatistics_nodes_visited =
+R"doc(Number of nodes of the search tree visited, indexed by the number of
+edges of the node.)doc";
+
+static const char *__doc_low_index_SearchStatistics_perf_counters =
+R"doc(The hardware performance counters for each phase of the search:
+"slot" (finding the first empty slot of a node), "copy" (copying a
+node and adding an edge), "lift" (relators_may_lift), "minimality"
+(may_be_minimal) and "leaf" (checking a complete node).
+
+Empty if perf_counters_enabled is false or the counters are not
+available (they need Linux and perf_event_open to be permitted).
+Reading the counters around each phase needs a system call, so the
+search is considerably slower and the counts include some of the
+overhead. To enable them, set the environment variable
+LOW_INDEX_PERF_COUNTERS=1 when building low_index.)doc";
+
+static const char *__doc_low_index_SearchStatistics_phase_seconds =
+R"doc(Seconds spent in each phase of the search (see perf_counters), summed
+over all threads.
+
+Empty if statistics_enabled is false. The clock is read around each
+phase, which adds some overhead to the search and the times.)doc";
+
+static const char *__doc_low_index_SearchStatistics_relators_pruned =
+R"doc(Number of children rejected by relators_may_lift - including complete
+nodes for which the short relators do not lift.)doc";
+
+static const char *__doc_low_index_SearchStatistics_shard_pruned =
+R"doc(Number of children skipped because they belong to a different shard,
+see SimsTreeBase.set_shard.)doc";
+
+#if defined(__GNUG__)
+#pragma GCC diagnostic pop
+#endif
@@ -39,11 +39,15 @@ R"doc(Create SimsNode for a covering graph that can have up to max_degree
 vertices with edges labeled by rank many letters. num_relators is the
 number of "short relators" that can be checked relator_may_lift.)doc";
 
-static const char *__doc_low_index_SimsNode_SimsNode_2 = R"doc(Copy a different subclass of SimsNode.)doc";
+static const char *__doc_low_index_SimsNode_SimsNode_2 =
+R"doc(Create SimsNode from a table of outgoing edges, see
+AbstractSimsNode::set_outgoing_table.)doc";
 
-static const char *__doc_low_index_SimsNode_SimsNode_3 = R"doc(Copy a SimsNode.)doc";
+static const char *__doc_low_index_SimsNode_SimsNode_3 = R"doc(Copy a different subclass of SimsNode.)doc";
 
-static const char *__doc_low_index_SimsNode_SimsNode_4 =
+static const char *__doc_low_index_SimsNode_SimsNode_4 = R"doc(Copy a SimsNode.)doc";
+
+static const char *__doc_low_index_SimsNode_SimsNode_5 =
 R"doc(Move this SimsNode. Calling methods on the SimsNode we copied from
 will be unsafe.)doc";
 
@@ -51,6 +55,29 @@ static const char *__doc_low_index_SimsNode_allocate_memory = R"doc()doc";
 
 static const char *__doc_low_index_SimsNode_memory = R"doc()doc";
 
+static const char *__doc_low_index_decode_sims_nodes =
+R"doc(Decode SimsNode's encoded with encode_sims_nodes.
+
+Raises RuntimeError if the bytes are not such an encoding and ValueError
+if they do not describe valid graphs. The memory used by the result is
+bounded by a multiple of the size of the bytes. The lift state is
+checked against the degree, but it can only be checked against the
+relators by AbstractSimsNode.check_lift_state (which SimsTreeBase does
+for its root and relators_may_lift does when called from python).)doc";
+
+static const char *__doc_low_index_encode_sims_nodes =
+R"doc(Encode SimsNode's compactly as bytes, e.g., to send them to a
+different process or to store them. Use decode_sims_nodes to recover
+them.
+
+All nodes need to have the same rank, max_degree and num_relators. If
+with_lift_state is false, the acceleration structure of
+relators_may_lift is not encoded. This makes the encoding of incomplete
+nodes smaller, but relators_may_lift has to be called with target 0
+after decoding before adding further edges. Raises ValueError if the
+nodes support so many relators that their lift state would be larger
+than the encoding without it (use with_lift_state then).)doc";
+
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
@@ -42,7 +42,14 @@ static const char *__doc_low_index_SimsTree_SimsTree =
 R"doc(Construct SimsTree with an empty root. That is a SimsNode for the
 given rank and max_degree and no edges.)doc";
 
-static const char *__doc_low_index_SimsTree_SimsTree_2 = R"doc()doc";
+static const char *__doc_low_index_SimsTree_SimsTree_2 =
+R"doc(Use the given SimsNode as root instead of the SimsNode with no edges,
+e.g., one of the nodes returned by SimsTreeBase.bloom.
+
+The rank and max_degree are taken from the root. The root needs to
+support the short_relators, see AbstractSimsNode.num_relators. If the
+root has edges, relators_may_lift must have been called with the
+short_relators after adding them.)doc";
 
 static const char *__doc_low_index_SimsTree_bloom = R"doc()doc";
 
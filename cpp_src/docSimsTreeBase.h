@@ -27,16 +27,203 @@ static const char *__doc_low_index_SimsTreeBase = R"doc(Recurse to find all low-
 
 static const char *__doc_low_index_SimsTreeBase_SimsTreeBase = R"doc()doc";
 
+static const char *__doc_low_index_SimsTreeBase_bloom =
+R"doc(Expand the search tree breadth-first starting from the root of this
+tree until there are at least num_nodes nodes or all nodes are complete
+and return the nodes.
+
+The nodes are returned in the order of list(). That is, constructing a
+tree with the same relators for each node as root (see, e.g., SimsTree)
+and concatenating the results of list() gives the same result as list()
+of this tree. This can be used to write custom parallel drivers or to
+split a large subtree further.
+
+Note that complete nodes are returned as they are, that is, it is left
+to the tree constructed for them to check the long relators.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_count =
+R"doc(Count the complete covering subgraphs of each degree and the subgroups
+they correspond to instead of returning them, e.g., to compute the
+subgroup growth of G.
+
+The number of conjugacy classes of subgroups of index d is the number
+of complete covering subgraphs of degree d returned by list(). The
+number of all subgroups of index d is computed in the same pass by
+adding AbstractSimsNode::conjugacy_class_size for each of them, so no
+complete covering subgraph is kept in memory.
+
+The counts for the shards of a search (see set_shard) add up to the
+counts of the whole search.
+
+Cannot be combined with set_checkpoint or resume.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_estimate_size =
+R"doc(Estimate the size of the search tree (and thus how long list() takes)
+without traversing it, using Knuth's method.
+
+Each probe walks down a random path from the root to a leaf of the
+search tree, choosing uniformly among the children of each node (with
+the same pruning as list()). Counting each node on the path with weight
+the inverse of the probability of reaching it gives an unbiased estimate
+for the number of nodes in the search tree.
+
+Probe i uses a pseudo-random generator determined by seed and i, so the
+result only depends on seed and num_probes (up to floating point
+rounding when num_threads > 1). The probes are split among num_threads
+threads.
+
+This is cheap compared to list(), so it can be used to decide whether a
+run is feasible, how many threads to use or which relators to use as
+short relators.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_is_complete =
+R"doc(Whether list() (or a variant) has finished searching the whole search
+tree, that is, it was neither cancelled (see set_cancellation_token) nor
+interrupted (see set_interrupt_check, e.g., by Ctrl-C in python).)doc";
+
 static const char *__doc_low_index_SimsTreeBase_list = R"doc(List all subgroups.)doc";
 
 static const char *__doc_low_index_SimsTreeBase_list_2 = R"doc()doc";
 
+static const char *__doc_low_index_SimsTreeBase_list_compact =
+R"doc(Same as list() but returning the complete covering subgraphs as a
+CoverList which takes a fraction of the memory.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_list_batched =
+R"doc(Find all complete covering subgraphs for the given group G for each
+of the given sets of (additional) long relators.
+
+That is, the i-th entry of the result contains the complete covering
+subgraphs (in the same order as list()) for which the short_relators,
+the long_relators and the relators in long_relator_sets[i] lift.
+
+The search tree is only traversed once and each complete leaf is
+checked against all sets.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_list_to_file =
+R"doc(Find all complete covering subgraphs for the given group G and write
+them to the given file (in the same order as list()) instead of keeping
+them in memory. Returns the number of complete covering subgraphs. The
+file can be read with ResultFile or, if delta_compressed is set, with
+DeltaStream (which is typically less than half the size but can only be
+read sequentially).
+
+Each thread appends blocks of the complete covering subgraphs it finds
+directly to the given file. When the search is finished, an index
+listing these blocks in the order of list() is written to the end of
+the file.
+
+Cannot be combined with set_checkpoint or resume.)doc";
+
 static const char *__doc_low_index_SimsTreeBase_long_relators = R"doc()doc";
 
+static const char *__doc_low_index_SimsTreeBase_memory_usage =
+R"doc(The memory used by the search with a breakdown into its parts, e.g.,
+to size batch jobs. Can be called from a different thread while list()
+(or a variant) is running. After it has finished, this is the memory
+used at the end of the search (including the complete covering
+subgraphs returned) and the peak.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_resume =
+R"doc(Continue the search from the state saved in the given file (see
+set_checkpoint) instead of starting from the root when list() or
+list_batched() is called.
+
+The result (including the order) is the same as that of an
+uninterrupted run. The tree has to be constructed with the same
+arguments and list() or list_batched() called with the same arguments
+as for the run that wrote the file (but the number of threads may
+differ). Otherwise, list() throws std::domain_error.)doc";
+
 static const char *__doc_low_index_SimsTreeBase_root = R"doc()doc";
 
+static const char *__doc_low_index_SimsTreeBase_sample_covers =
+R"doc(Draw random covers with importance weights, e.g., to estimate the
+fraction of covers with some property when list() is hopeless.
+
+Uses the same random probes as estimate_size (with the same seed, probe
+i ends in the same leaf). Probes ending in a leaf that is not a result
+of list() do not yield a cover, so there are usually fewer covers than
+num_samples. The probes are split among num_threads threads and the
+result does not depend on num_threads.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_set_cancellation_token =
+R"doc(Stop list() (or a variant) early when the given token is cancelled (or
+its deadline has passed). The search then returns the complete covering
+subgraphs found so far (in the same order as list()) and is_complete()
+returns false.
+
+If set_checkpoint was called, a checkpoint is written when the search
+stops so that a later run can resume it.
+
+This also applies when the search is interrupted (see
+set_interrupt_check). Without a token, list() (or a variant) throws
+SearchInterrupted in that case (KeyboardInterrupt in python) instead of
+returning a partial result.
+
+The token is checked periodically, so the search stops within a
+fraction of a second. The same token can be given to several trees.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_set_checkpoint =
+R"doc(Periodically (every interval seconds) write the state of the search
+to the given file while list() or list_batched() is running.
+
+The state consists of the complete covering subgraphs found so far and
+the (incomplete) covering subgraphs whose subtrees still need to be
+searched. A later run can continue from this state with resume.
+
+The file is replaced atomically so that it always contains a
+consistent state even if the process is killed while writing.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_set_memory_limit =
+R"doc(Stop list() (or a variant) and raise MemoryLimitExceeded (a
+MemoryError) when the total of memory_usage() exceeds the given number
+of bytes. If set_checkpoint was called, a checkpoint is written first.
+
+If the memory needed to just start the search (the stack frames and
+relators) exceeds the limit, list() raises right away. Otherwise, the
+limit is checked periodically (like the cancellation token), so the
+search can exceed it slightly before it stops.
+
+0 (the default) means no limit.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_set_shard =
+R"doc(Only search the part of the search tree belonging to the given shard
+so that the search can be split across several processes or machines
+without any coordination between them.
+
+Consider the incomplete covering subgraphs of the search tree that have
+at least shard_depth edges more than the root while their parent has
+fewer. Each such covering subgraph (and thus its subtree) is assigned
+to one of the num_shards shards by a hash of its edges. The few
+complete covering subgraphs with fewer edges are assigned to the shard
+with index 0.
+
+Thus, the results of list() for shard_index = 0, ..., num_shards - 1
+are disjoint and their union is the result of list() without sharding.
+Use merge_shards to restore the order of list() without sharding.
+
+All shards have to use the same shard_depth. A larger shard_depth gives
+more and smaller subtrees which are likely to be balanced better between
+the shards.)doc";
+
+static const char *__doc_low_index_SimsTreeBase_statistics =
+R"doc(A snapshot of the counters of the search, e.g., to see why a search is
+slow or to monitor its progress.
+
+Can be called from a different thread while list() (or a variant) is
+running. The counters are only compiled in if statistics_enabled is
+true.)doc";
+
 static const char *__doc_low_index_SimsTreeBase_short_relators = R"doc()doc";
 
+static const char *__doc_low_index_merge_shards =
+R"doc(Merge the results of SimsTreeBase::list() for the different shards
+(see SimsTreeBase::set_shard) into the same order as the result of
+SimsTreeBase::list() without sharding.
+
+The order of the given lists does not matter.)doc";
+
 #if defined(__GNUG__)
 #pragma GCC diagnostic pop
 #endif
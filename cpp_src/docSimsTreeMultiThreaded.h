@@ -52,6 +52,15 @@ static const char *__doc_low_index_SimsTreeMultiThreaded_SimsTreeMultiThreaded =
 R"doc(Construct SimsTreeMultiThreaded with an empty root. That is a SimsNode
 for the given rank and max_degree and no edges.)doc";
 
+static const char *__doc_low_index_SimsTreeMultiThreaded_SimsTreeMultiThreaded_2 =
+R"doc(Use the given SimsNode as root instead of the SimsNode with no edges,
+e.g., one of the nodes returned by SimsTreeBase.bloom.
+
+The rank and max_degree are taken from the root. The root needs to
+support the short_relators, see AbstractSimsNode.num_relators. If the
+root has edges, relators_may_lift must have been called with the
+short_relators after adding them.)doc";
+
 static const char *__doc_low_index_SimsTreeMultiThreaded_StackedSimsNode = R"doc()doc";
 
 static const char *__doc_low_index_SimsTreeMultiThreaded_list =
@@ -72,6 +81,30 @@ static const char *__doc_low_index_SimsTreeMultiThreaded_recurse = R"doc()doc";
 
 static const char *__doc_low_index_SimsTreeMultiThreaded_recursion_stop_requested = R"doc()doc";
 
+static const char *__doc_low_index_SimsTreeMultiThreaded_set_memory_budget =
+R"doc(Limit the memory (in bytes) used for the parts of the search tree that
+are materialized to distribute work between the threads. This does not
+include the complete covering subgraphs found.
+
+When over budget, a thread does not hand out the remaining work of its
+subtree when another thread runs out of work but keeps recursing it.
+This bounds the memory but can leave threads idle. The budget can be
+exceeded by the nodes handed out at once (the unsearched siblings of the
+nodes on the path of the thread).
+
+0 (the default) means no limit.)doc";
+
+static const char *__doc_low_index_SimsTreeMultiThreaded_set_trace_file =
+R"doc(Record what the worker threads do and write it to the given file (in
+the Chrome trace event format, which can be opened in chrome://tracing
+or https://ui.perfetto.dev) when list() (or a variant) finishes.
+Recorded are the subtrees recursed by each thread, the waits for work,
+the requests to stop recursing (to refill the queue) and the responses
+to them and the swaps of the queue. The main thread records the
+checkpoints.
+
+An empty filename (the default) disables tracing.)doc";
+
 static const char *__doc_low_index_SimsTreeMultiThreaded_thread_num = R"doc()doc";
 
 static const char *__doc_low_index_SimsTreeMultiThreaded_thread_worker = R"doc()doc";
@@ -0,0 +1,495 @@
+#include "kernels.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define LOW_INDEX_X86_KERNELS
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+// Compile a function for the given instruction sets so that it can use
+// their intrinsics without compiling the whole file for them. MSVC allows
+// the intrinsics anyway.
+#if defined(__GNUC__)
+#define LOW_INDEX_TARGET(isa) __attribute__((target(isa)))
+#else
+#define LOW_INDEX_TARGET(isa)
+#endif
+
+namespace low_index {
+
+// The tables for the permutations of the letters in _relators_lift_* are
+// on the stack.
+static const RankType _max_lift_rank = 32;
+
+////////////////////////////////////////////////////////////////////////////
+// scalar
+
+static
+unsigned int
+_find_empty_slot_scalar(
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    unsigned int n,
+    const unsigned int end)
+{
+    for (; n < end; n++) {
+        if (outgoing[n] == 0 || incoming[n] == 0) {
+            return n;
+        }
+    }
+    return end;
+}
+
+// The scalar variant leaves relators_lift to AbstractSimsNode.
+static const Kernels _scalar_kernels = {
+    "scalar", _find_empty_slot_scalar, 0, 0, nullptr };
+
+#ifdef LOW_INDEX_X86_KERNELS
+
+static inline
+unsigned int
+_count_trailing_zeros(const uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long result;
+    _BitScanForward(&result, mask);
+    return result;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+static inline
+unsigned int
+_count_trailing_zeros64(const uint64_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long result;
+    _BitScanForward64(&result, mask);
+    return result;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// Write the permutation of the vertices 0, ..., degree - 1 by each letter
+// and its inverse to tables (one table of the given width for each of
+// them, see _table_index). The vertices from degree to width - 1 are
+// fixed, so that the lanes for them do not need to be masked.
+static
+void
+_fill_tables(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const size_t width,
+    uint8_t * const tables)
+{
+    for (RankType l = 0; l < rank; l++) {
+        uint8_t * const forward = tables + (2 * l) * width;
+        uint8_t * const backward = tables + (2 * l + 1) * width;
+        for (DegreeType v = 0; v < degree; v++) {
+            forward[v] = outgoing[v * rank + l] - 1;
+            backward[v] = incoming[v * rank + l] - 1;
+        }
+        for (size_t v = degree; v < width; v++) {
+            forward[v] = static_cast<uint8_t>(v);
+            backward[v] = static_cast<uint8_t>(v);
+        }
+    }
+}
+
+// Index of the table for a letter written by _fill_tables.
+static inline
+size_t
+_table_index(const LetterType letter)
+{
+    return letter > 0 ? 2 * (letter - 1) : 2 * (-letter - 1) + 1;
+}
+
+////////////////////////////////////////////////////////////////////////////
+// ssse3
+
+LOW_INDEX_TARGET("sse2")
+static
+unsigned int
+_find_empty_slot_sse2(
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    unsigned int n,
+    const unsigned int end)
+{
+    const __m128i zero = _mm_setzero_si128();
+    for (; n + 16 <= end; n += 16) {
+        const __m128i a = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(outgoing + n));
+        const __m128i b = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(incoming + n));
+        const uint32_t mask = _mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(a, zero), _mm_cmpeq_epi8(b, zero)));
+        if (mask) {
+            return n + _count_trailing_zeros(mask);
+        }
+    }
+    return _find_empty_slot_scalar(outgoing, incoming, n, end);
+}
+
+// Lift the relators at all (up to 16) vertices at once: the lanes of a
+// vector hold the current vertex for each start vertex and a letter is
+// applied by one byte shuffle.
+LOW_INDEX_TARGET("ssse3")
+static
+bool
+_relators_lift_ssse3(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const std::vector<Relator> &relators)
+{
+    alignas(16) uint8_t tables[2 * _max_lift_rank][16];
+    _fill_tables(rank, degree, outgoing, incoming, 16, &tables[0][0]);
+
+    const __m128i identity = _mm_setr_epi8(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+    for (const Relator &relator : relators) {
+        __m128i v = identity;
+        for (const LetterType letter : relator) {
+            v = _mm_shuffle_epi8(
+                _mm_load_si128(reinterpret_cast<const __m128i*>(
+                                   tables[_table_index(letter)])),
+                v);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, identity)) != 0xffff) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static const Kernels _ssse3_kernels = {
+    "ssse3", _find_empty_slot_sse2,
+    16, _max_lift_rank, _relators_lift_ssse3 };
+
+////////////////////////////////////////////////////////////////////////////
+// avx2
+
+LOW_INDEX_TARGET("avx2")
+static
+unsigned int
+_find_empty_slot_avx2(
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    unsigned int n,
+    const unsigned int end)
+{
+    const __m256i zero = _mm256_setzero_si256();
+    for (; n + 32 <= end; n += 32) {
+        const __m256i a = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(outgoing + n));
+        const __m256i b = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(incoming + n));
+        const uint32_t mask = _mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(a, zero),
+                            _mm256_cmpeq_epi8(b, zero)));
+        if (mask) {
+            return n + _count_trailing_zeros(mask);
+        }
+    }
+    return _find_empty_slot_sse2(outgoing, incoming, n, end);
+}
+
+// As _relators_lift_ssse3 for up to 32 vertices. The byte shuffle of AVX2
+// only works within 16-byte lanes, so a table lookup is done as shuffle of
+// the lower and the upper half of the table and picking the right result.
+LOW_INDEX_TARGET("avx2")
+static
+bool
+_relators_lift_avx2(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const std::vector<Relator> &relators)
+{
+    alignas(32) uint8_t tables[2 * _max_lift_rank][32];
+    _fill_tables(rank, degree, outgoing, incoming, 32, &tables[0][0]);
+
+    // Each half of a table in both lanes.
+    __m256i lower[2 * _max_lift_rank];
+    __m256i upper[2 * _max_lift_rank];
+    for (size_t i = 0; i < 2 * rank; i++) {
+        lower[i] = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(tables[i])));
+        upper[i] = _mm256_broadcastsi128_si256(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(tables[i] + 16)));
+    }
+
+    const __m256i identity = _mm256_setr_epi8(
+        0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+        16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31);
+    const __m256i fifteen = _mm256_set1_epi8(15);
+    for (const Relator &relator : relators) {
+        __m256i v = identity;
+        for (const LetterType letter : relator) {
+            const size_t i = _table_index(letter);
+            v = _mm256_blendv_epi8(
+                _mm256_shuffle_epi8(lower[i], v),
+                _mm256_shuffle_epi8(upper[i], v),
+                _mm256_cmpgt_epi8(v, fifteen));
+        }
+        if (static_cast<uint32_t>(_mm256_movemask_epi8(
+                _mm256_cmpeq_epi8(v, identity))) != 0xffffffffu) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+bool
+_relators_lift_avx2_dispatch(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const std::vector<Relator> &relators)
+{
+    // Fewer and cheaper instructions for small degrees.
+    if (degree <= 16) {
+        return _relators_lift_ssse3(
+            rank, degree, outgoing, incoming, relators);
+    }
+    return _relators_lift_avx2(rank, degree, outgoing, incoming, relators);
+}
+
+static const Kernels _avx2_kernels = {
+    "avx2", _find_empty_slot_avx2,
+    32, _max_lift_rank, _relators_lift_avx2_dispatch };
+
+////////////////////////////////////////////////////////////////////////////
+// avx512
+
+LOW_INDEX_TARGET("avx512f,avx512bw")
+static
+unsigned int
+_find_empty_slot_avx512(
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    unsigned int n,
+    const unsigned int end)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    for (; n < end; n += 64) {
+        // Masked loads do not touch the memory beyond end.
+        const __mmask64 lanes =
+            end - n >= 64 ? ~__mmask64(0) : (__mmask64(1) << (end - n)) - 1;
+        const __m512i a = _mm512_maskz_loadu_epi8(lanes, outgoing + n);
+        const __m512i b = _mm512_maskz_loadu_epi8(lanes, incoming + n);
+        const uint64_t mask =
+            (_mm512_cmpeq_epi8_mask(a, zero) |
+             _mm512_cmpeq_epi8_mask(b, zero)) & lanes;
+        if (mask) {
+            return n + _count_trailing_zeros64(mask);
+        }
+    }
+    return end;
+}
+
+// As _relators_lift_ssse3 for up to 64 vertices, using the byte
+// permutation across the whole vector.
+LOW_INDEX_TARGET("avx512f,avx512bw,avx512vbmi")
+static
+bool
+_relators_lift_avx512(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const std::vector<Relator> &relators)
+{
+    alignas(64) uint8_t tables[2 * _max_lift_rank][64];
+    _fill_tables(rank, degree, outgoing, incoming, 64, &tables[0][0]);
+
+    alignas(64) uint8_t identity_bytes[64];
+    for (uint8_t i = 0; i < 64; i++) {
+        identity_bytes[i] = i;
+    }
+    const __m512i identity = _mm512_load_si512(identity_bytes);
+    for (const Relator &relator : relators) {
+        __m512i v = identity;
+        for (const LetterType letter : relator) {
+            // The masked form avoids a spurious -Wmaybe-uninitialized
+            // from the headers of gcc 12.
+            v = _mm512_maskz_permutexvar_epi8(
+                ~__mmask64(0),
+                v, _mm512_load_si512(tables[_table_index(letter)]));
+        }
+        if (_mm512_cmpneq_epi8_mask(v, identity)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static
+bool
+_relators_lift_avx512_dispatch(
+    const RankType rank,
+    const DegreeType degree,
+    const DegreeType * const outgoing,
+    const DegreeType * const incoming,
+    const std::vector<Relator> &relators)
+{
+    if (degree <= 16) {
+        return _relators_lift_ssse3(
+            rank, degree, outgoing, incoming, relators);
+    }
+    return _relators_lift_avx512(rank, degree, outgoing, incoming, relators);
+}
+
+static const Kernels _avx512_kernels = {
+    "avx512", _find_empty_slot_avx512,
+    64, _max_lift_rank, _relators_lift_avx512_dispatch };
+
+// What the CPU (and the operating system) supports.
+struct _CpuFeatures
+{
+    bool ssse3;
+    bool avx2;
+    bool avx512;
+};
+
+static
+_CpuFeatures
+_cpu_features()
+{
+    _CpuFeatures result;
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int max_leaf = info[0];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    result.ssse3 = (info[2] & (1 << 9)) != 0;
+    // Whether the operating system saves the AVX (and AVX-512) registers.
+    const uint64_t xcr0 = osxsave ? _xgetbv(0) : 0;
+    const bool avx_state = (xcr0 & 0x6) == 0x6;
+    const bool avx512_state = (xcr0 & 0xe6) == 0xe6;
+    int leaf7[4] = { 0, 0, 0, 0 };
+    if (max_leaf >= 7) {
+        __cpuidex(leaf7, 7, 0);
+    }
+    result.avx2 = avx_state && (leaf7[1] & (1 << 5)) != 0;
+    result.avx512 =
+        avx512_state &&
+        (leaf7[1] & (1 << 16)) != 0 &&   // AVX512F
+        (leaf7[1] & (1 << 30)) != 0 &&   // AVX512BW
+        (leaf7[2] & (1 << 1)) != 0;      // AVX512VBMI
+#else
+    // Also checks that the operating system saves the registers.
+    __builtin_cpu_init();
+    result.ssse3 = __builtin_cpu_supports("ssse3");
+    result.avx2 = __builtin_cpu_supports("avx2");
+    result.avx512 =
+        __builtin_cpu_supports("avx512f") &&
+        __builtin_cpu_supports("avx512bw") &&
+        __builtin_cpu_supports("avx512vbmi");
+#endif
+    return result;
+}
+
+#endif // LOW_INDEX_X86_KERNELS
+
+// The variants supported by the CPU, from least to most capable.
+static
+std::vector<const Kernels *>
+_supported_kernels()
+{
+    std::vector<const Kernels *> result = { &_scalar_kernels };
+#ifdef LOW_INDEX_X86_KERNELS
+    const _CpuFeatures features = _cpu_features();
+    if (features.ssse3) {
+        result.push_back(&_ssse3_kernels);
+        if (features.avx2) {
+            result.push_back(&_avx2_kernels);
+            if (features.avx512) {
+                result.push_back(&_avx512_kernels);
+            }
+        }
+    }
+#endif
+    return result;
+}
+
+static
+const Kernels *
+_find_kernels(const std::string &name)
+{
+    const std::vector<const Kernels *> supported = _supported_kernels();
+    if (name == "auto") {
+        return supported.back();
+    }
+    for (const Kernels * const k : supported) {
+        if (name == k->name) {
+            return k;
+        }
+    }
+    throw std::domain_error(
+        "Kernel variant '" + name + "' is unknown or not supported by "
+        "this CPU.");
+}
+
+// The variant selected at startup, see LOW_INDEX_KERNEL_VARIANT.
+static
+const Kernels *
+_initial_kernels()
+{
+    const char * const name = std::getenv("LOW_INDEX_KERNEL_VARIANT");
+    if (name && *name) {
+        try {
+            return _find_kernels(name);
+        } catch (const std::domain_error &) {
+            // Fall back to scalar rather than failing at startup.
+            return &_scalar_kernels;
+        }
+    }
+    return _find_kernels("auto");
+}
+
+// Constant-initialized, so that it can be used by other initializers.
+std::atomic<const Kernels *> _selected_kernels(&_scalar_kernels);
+
+static const bool _kernels_initialized =
+    (_selected_kernels.store(_initial_kernels()), true);
+
+std::string
+kernel_variant()
+{
+    return kernels().name;
+}
+
+std::vector<std::string>
+kernel_variants()
+{
+    std::vector<std::string> result;
+    for (const Kernels * const k : _supported_kernels()) {
+        result.push_back(k->name);
+    }
+    return result;
+}
+
+void
+set_kernel_variant(const std::string &name)
+{
+    _selected_kernels.store(_find_kernels(name));
+}
+
+} // Namespace low_index
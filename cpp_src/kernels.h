@@ -0,0 +1,74 @@
+#ifndef LOW_INDEX_KERNELS_H
+#define LOW_INDEX_KERNELS_H
+
+#include "types.h"
+
+#include <atomic>
+#include <string>
+
+namespace low_index {
+
+/// Variants of the innermost loops of the search, compiled for different
+/// instruction sets.
+///
+/// The python extension is built for a generic CPU, so the variants using
+/// newer instructions are compiled with the corresponding target attributes
+/// and the best variant supported by the CPU is selected at runtime.
+/// The variants are, from least to most capable:
+/// - "scalar": plain C++.
+/// - "ssse3": SSE2 and SSSE3 (x86-64 only).
+/// - "avx2": AVX2 (x86-64 only).
+/// - "avx512": AVX-512 BW and VBMI (x86-64 only).
+///
+/// The environment variable LOW_INDEX_KERNEL_VARIANT can be set to the name
+/// of a variant to use instead of the best one, e.g., "scalar" for testing.
+struct Kernels
+{
+    /// Name of the variant.
+    const char * name;
+
+    /// The first n in [begin, end) such that outgoing[n] or incoming[n]
+    /// is zero, end if there is no such n. See
+    /// CoveringSubgraph::first_empty_slot.
+    unsigned int (*find_empty_slot)(const DegreeType * outgoing,
+                                    const DegreeType * incoming,
+                                    unsigned int begin,
+                                    unsigned int end);
+
+    /// The largest degree and rank supported by relators_lift.
+    DegreeType max_lift_degree;
+    RankType max_lift_rank;
+
+    /// Whether all relators lift to loops at every vertex of the complete
+    /// covering subgraph given by the outgoing and incoming tables. See
+    /// AbstractSimsNode::relators_lift.
+    bool (*relators_lift)(RankType rank,
+                          DegreeType degree,
+                          const DegreeType * outgoing,
+                          const DegreeType * incoming,
+                          const std::vector<Relator> &relators);
+};
+
+extern std::atomic<const Kernels *> _selected_kernels;
+
+/// The kernels used by the search.
+inline const Kernels &kernels() {
+    return *_selected_kernels.load(std::memory_order_relaxed);
+}
+
+/// The name of the variant of the kernels used by the search.
+std::string kernel_variant();
+
+/// The names of the variants supported by this CPU, from least to most
+/// capable.
+std::vector<std::string> kernel_variants();
+
+/// Use the variant of the kernels with the given name, or the best one
+/// supported by the CPU if the name is "auto". Throws std::domain_error if
+/// the CPU does not support the variant. The results of the search do not
+/// depend on the variant.
+void set_kernel_variant(const std::string &name);
+
+} // Namespace low_index
+
+#endif
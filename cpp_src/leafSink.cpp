@@ -0,0 +1,60 @@
+#include "leafSink.h"
+
+#include "resultFile.h"
+
+namespace low_index {
+
+LeafSink::~LeafSink() = default;
+
+CoverListSink::CoverListSink(
+    const std::vector<std::vector<Relator>> &long_relator_sets,
+    std::vector<CoverList> * const complete_nodes)
+  : _long_relator_sets(long_relator_sets)
+  , _complete_nodes(complete_nodes)
+{
+}
+
+void
+CoverListSink::add(
+    const AbstractSimsNode &node,
+    SearchCounters * const counters)
+{
+    // Only the outgoing table is stored, so there is no need for the
+    // lift state anymore.
+    for (size_t i = 0; i < _long_relator_sets.size(); i++) {
+        const std::vector<Relator> &relators = _long_relator_sets[i];
+        if (!relators.empty()) {
+            counters->add(SearchCounters::long_relator_checks);
+            if (!node.relators_lift(relators)) {
+                counters->add(SearchCounters::long_relator_failures);
+                continue;
+            }
+        }
+        counters->add(SearchCounters::covers_found);
+        (*_complete_nodes)[i].push_back(node);
+        unpublished_memory += cover_memory(node);
+    }
+}
+
+void
+SegmentSink::add(
+    const AbstractSimsNode &node,
+    SearchCounters * const counters)
+{
+    counters->add(SearchCounters::covers_found);
+    _segment->write(node);
+}
+
+void
+CountSink::add(
+    const AbstractSimsNode &node,
+    SearchCounters * const counters)
+{
+    counters->add(SearchCounters::covers_found);
+    const DegreeType d = node.degree() - 1;
+    _conjugacy_class_counts[d].fetch_add(1, std::memory_order_relaxed);
+    _subgroup_counts[d].fetch_add(node.conjugacy_class_size(),
+                                  std::memory_order_relaxed);
+}
+
+} // Namespace low_index
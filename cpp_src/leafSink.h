@@ -0,0 +1,96 @@
+#ifndef LOW_INDEX_LEAF_SINK_H
+#define LOW_INDEX_LEAF_SINK_H
+
+#include "coverList.h"
+#include "searchStatistics.h"
+
+#include <atomic>
+
+namespace low_index {
+
+class ResultSegmentWriter;
+
+/// Where a thread of a SimsTreeBase puts the complete covering subgraphs
+/// (leaves of the search tree) that are results, that is, for which the
+/// relators given to the tree lift.
+///
+/// There is one implementation for each of SimsTreeBase::list (and
+/// list_batched), list_to_file and count. The tree picks one when the
+/// search starts so that it does not need to branch on it for every leaf.
+class LeafSink
+{
+public:
+    virtual ~LeafSink();
+
+    /// Add a complete covering subgraph that is a result.
+    virtual void add(const AbstractSimsNode &node,
+                     SearchCounters * counters) = 0;
+
+    /// Memory of the covering subgraphs stored by add that the tree has
+    /// not accounted for yet, see SimsTreeBase::_publish_memory.
+    size_t unpublished_memory;
+
+protected:
+    LeafSink() : unpublished_memory(0) { }
+};
+
+/// Stores the results in one CoverList for each set of long relators that
+/// lift (see SimsTreeBase::list_batched).
+class CoverListSink : public LeafSink
+{
+public:
+    CoverListSink(
+        const std::vector<std::vector<Relator>> &long_relator_sets,
+        std::vector<CoverList> * complete_nodes);
+
+    void add(const AbstractSimsNode &node,
+             SearchCounters * counters) override;
+
+    /// Memory of a complete node stored in a CoverList.
+    static size_t cover_memory(const AbstractSimsNode &node) {
+        return
+            sizeof(const DegreeType *) +
+            (1 + node.rank() * node.degree()) * sizeof(DegreeType);
+    }
+
+private:
+    const std::vector<std::vector<Relator>> &_long_relator_sets;
+    std::vector<CoverList> * const _complete_nodes;
+};
+
+/// Writes the results to a segment of a result file (see
+/// SimsTreeBase::list_to_file).
+class SegmentSink : public LeafSink
+{
+public:
+    SegmentSink(ResultSegmentWriter * segment) : _segment(segment) { }
+
+    void add(const AbstractSimsNode &node,
+             SearchCounters * counters) override;
+
+private:
+    ResultSegmentWriter * const _segment;
+};
+
+/// Only counts the results by degree (see SimsTreeBase::count).
+class CountSink : public LeafSink
+{
+public:
+    /// The arrays have one entry for each degree 1, ..., max_degree.
+    CountSink(std::atomic<uint64_t> * conjugacy_class_counts,
+              std::atomic<uint64_t> * subgroup_counts)
+      : _conjugacy_class_counts(conjugacy_class_counts)
+      , _subgroup_counts(subgroup_counts)
+    { }
+
+    void add(const AbstractSimsNode &node,
+             SearchCounters * counters) override;
+
+private:
+    std::atomic<uint64_t> * const _conjugacy_class_counts;
+    std::atomic<uint64_t> * const _subgroup_counts;
+};
+
+} // Namespace low_index
+
+#endif
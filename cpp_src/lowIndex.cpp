@@ -1,24 +1,44 @@
 #include "lowIndex.h"
 
 #include "words.h"
+#include "coverStore.h"
+#include "resultFile.h"
 #include "simsTree.h"
 #include "simsTreeMultiThreaded.h"
 
+#include <algorithm>
+#include <cstdio>
 #include <thread>
 #include <memory>
+#include <stdexcept>
 
 namespace low_index {
 
 const std::string spin_short_strategy = "spin_short";
 
-std::vector<std::vector<std::vector<DegreeType>>>
-permutation_reps(
+// Use all cores if num_threads is 0.
+static
+unsigned int
+_resolve_num_threads(const unsigned int num_threads)
+{
+    return
+        (num_threads > 0)
+            ? num_threads
+            : std::thread::hardware_concurrency();
+}
+
+// Instantiate appropriate SimsTree implementation
+static
+std::unique_ptr<SimsTreeBase>
+_create_sims_tree(
     const RankType rank,
     const std::vector<Relator> &short_relators,
     const std::vector<Relator> &long_relators,
     const DegreeType max_degree,
     const std::string &strategy,
-    const unsigned int num_threads)
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    const double deadline = 0)
 {
     // Apply strategy to short relators.
     const std::vector<Relator> all_short_relators =
@@ -28,11 +48,8 @@ permutation_reps(
 
     // Determine number of threads to use
     const unsigned int resolved_num_threads =
-        (num_threads > 0)
-            ? num_threads
-            : std::thread::hardware_concurrency();
+        _resolve_num_threads(num_threads);
 
-    // Instantiate appropriate SimsTree implementation
     std::unique_ptr<SimsTreeBase> t;
     if (resolved_num_threads > 1) {
         t.reset(
@@ -45,14 +62,281 @@ permutation_reps(
                 rank, max_degree, all_short_relators, long_relators));
     }
 
-    // Convert SimsNode's to permutation representations.
+    if (deadline > 0) {
+        // Do not change the caller's token.
+        token = std::make_shared<CancellationToken>(std::move(token));
+        token->set_deadline(deadline);
+    }
+    t->set_cancellation_token(std::move(token));
+    return t;
+}
+
+// Report through is_complete whether the search stopped early. If the
+// caller did not ask for that, it cannot take a partial result and we
+// throw instead.
+static
+void
+_check_complete(const SimsTreeBase &t, bool * const is_complete)
+{
+    if (is_complete) {
+        *is_complete = t.is_complete();
+    } else if (!t.is_complete()) {
+        throw SearchInterrupted();
+    }
+}
+
+// Convert SimsNode's to permutation representations.
+static
+std::vector<std::vector<std::vector<DegreeType>>>
+_permutation_reps(const std::vector<SimsNode> &nodes)
+{
     std::vector<std::vector<std::vector<DegreeType>>> result;
-    for (const SimsNode &n : t->list()) {
+    result.reserve(nodes.size());
+    for (const SimsNode &n : nodes) {
         result.push_back(n.permutation_rep());
     }
     return result;
 }
 
+// Same for a CoverList.
+static
+std::vector<std::vector<std::vector<DegreeType>>>
+_permutation_reps(const CoverList &covers)
+{
+    std::vector<std::vector<std::vector<DegreeType>>> result;
+    result.reserve(covers.size());
+    for (size_t i = 0; i < covers.size(); i++) {
+        result.push_back(covers.permutation_rep(i));
+    }
+    return result;
+}
+
+std::vector<std::vector<std::vector<DegreeType>>>
+permutation_reps(
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const unsigned int shard_index,
+    const unsigned int num_shards,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::unique_ptr<SimsTreeBase> t = _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, num_threads, std::move(token), deadline);
+    t->set_shard(shard_index, num_shards);
+    const CoverList covers = t->list_compact();
+    _check_complete(*t, is_complete);
+    return _permutation_reps(covers);
+}
+
+PermutationRepSet
+permutation_rep_set(
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::unique_ptr<SimsTreeBase> t = _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, num_threads, std::move(token), deadline);
+    const CoverList covers = t->list_compact();
+    _check_complete(*t, is_complete);
+    return PermutationRepSet(rank, max_degree, covers);
+}
+
+TreeSizeEstimate
+estimate_tree_size(
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const DegreeType max_degree,
+    const size_t num_probes,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const uint64_t seed)
+{
+    // The probes are run by estimate_size, so the tree does not need
+    // threads of its own.
+    return _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, 1)->estimate_size(
+            num_probes, seed, _resolve_num_threads(num_threads));
+}
+
+CoverSample
+sample_covers(
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const DegreeType max_degree,
+    const size_t num_samples,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const uint64_t seed)
+{
+    // Same as estimate_tree_size.
+    return _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, 1)->sample_covers(
+            num_samples, seed, _resolve_num_threads(num_threads));
+}
+
+// The key to sort the permutation representations into the order of
+// SimsTree::list(). Same as the key in merge_shards but computed from the
+// permutations instead of the CoveringSubgraph.
+static
+std::vector<DegreeType>
+_sims_tree_order_key(const std::vector<std::vector<DegreeType>> &rep)
+{
+    const size_t degree = rep.empty() ? 0 : rep[0].size();
+
+    std::vector<std::vector<DegreeType>> inverses;
+    inverses.reserve(rep.size());
+    for (const std::vector<DegreeType> &perm : rep) {
+        if (perm.size() != degree) {
+            throw std::domain_error(
+                "merge_permutation_reps: Permutations have different "
+                "sizes.");
+        }
+        std::vector<DegreeType> inverse(degree);
+        for (size_t v = 0; v < degree; v++) {
+            if (perm[v] >= degree) {
+                throw std::domain_error(
+                    "merge_permutation_reps: Not a permutation.");
+            }
+            inverse[perm[v]] = v;
+        }
+        inverses.push_back(std::move(inverse));
+    }
+
+    std::vector<DegreeType> result;
+    result.reserve(2 * rep.size() * degree);
+    for (size_t v = 0; v < degree; v++) {
+        for (size_t l = 0; l < rep.size(); l++) {
+            result.push_back(rep[l][v]);
+            result.push_back(inverses[l][v]);
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<std::vector<DegreeType>>>
+merge_permutation_reps(
+    const std::vector<std::vector<std::vector<std::vector<DegreeType>>>> &shards)
+{
+    using Rep = std::vector<std::vector<DegreeType>>;
+
+    std::vector<std::pair<std::vector<DegreeType>, const Rep*>> keyed_reps;
+    for (const std::vector<Rep> &reps : shards) {
+        for (const Rep &rep : reps) {
+            keyed_reps.emplace_back(_sims_tree_order_key(rep), &rep);
+        }
+    }
+    std::sort(
+        keyed_reps.begin(), keyed_reps.end(),
+        [](const std::pair<std::vector<DegreeType>, const Rep*> &a,
+           const std::pair<std::vector<DegreeType>, const Rep*> &b) {
+            return a.first < b.first; });
+
+    std::vector<Rep> result;
+    result.reserve(keyed_reps.size());
+    for (const auto &keyed_rep : keyed_reps) {
+        result.push_back(*keyed_rep.second);
+    }
+    return result;
+}
+
+std::vector<std::vector<std::vector<std::vector<DegreeType>>>>
+permutation_reps_batched(
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const std::vector<std::vector<Relator>> &long_relator_sets,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::vector<std::vector<std::vector<std::vector<DegreeType>>>> result;
+    result.reserve(long_relator_sets.size());
+    // Nothing to do - and list_batched expects at least one set.
+    if (long_relator_sets.empty()) {
+        return result;
+    }
+    std::unique_ptr<SimsTreeBase> t = _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, num_threads, std::move(token), deadline);
+    for (const std::vector<SimsNode> &nodes :
+             t->list_batched(long_relator_sets)) {
+        result.push_back(_permutation_reps(nodes));
+    }
+    _check_complete(*t, is_complete);
+    return result;
+}
+
+void
+create_cover_store(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::unique_ptr<SimsTreeBase> t = _create_sims_tree(
+        rank, short_relators, { }, max_degree,
+        strategy, num_threads, std::move(token), deadline);
+    // Stream the covering subgraphs through a temporary result file
+    // instead of keeping them in memory.
+    const std::string results_filename = filename + ".results";
+    try {
+        t->list_to_file(results_filename);
+        _check_complete(*t, is_complete);
+        write_cover_store(filename, ResultFile(results_filename));
+    } catch (...) {
+        std::remove(results_filename.c_str());
+        throw;
+    }
+    std::remove(results_filename.c_str());
+}
+
+size_t
+create_result_file(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const bool delta_compressed,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::unique_ptr<SimsTreeBase> t = _create_sims_tree(
+        rank, short_relators, long_relators, max_degree,
+        strategy, num_threads, std::move(token), deadline);
+    const size_t n = t->list_to_file(filename, delta_compressed);
+    _check_complete(*t, is_complete);
+    return n;
+}
+
 // Parse a list of SnapPy-words
 static
 std::vector<Relator>
@@ -75,7 +359,12 @@ permutation_reps(
     const std::vector<std::string> &long_relators,
     const DegreeType max_degree,
     const std::string &strategy,
-    const unsigned int num_threads)
+    const unsigned int num_threads,
+    const unsigned int shard_index,
+    const unsigned int num_shards,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
 {
     return permutation_reps(
         rank,
@@ -83,7 +372,164 @@ permutation_reps(
         parse_words(rank, long_relators),
         max_degree,
         strategy,
-        num_threads);
+        num_threads,
+        shard_index,
+        num_shards,
+        std::move(token),
+        deadline,
+        is_complete);
+}
+
+PermutationRepSet
+permutation_rep_set(
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    return permutation_rep_set(
+        rank,
+        parse_words(rank, short_relators),
+        parse_words(rank, long_relators),
+        max_degree,
+        strategy,
+        num_threads,
+        std::move(token),
+        deadline,
+        is_complete);
+}
+
+std::vector<std::vector<std::vector<std::vector<DegreeType>>>>
+permutation_reps_batched(
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const std::vector<std::vector<std::string>> &long_relator_sets,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    std::vector<std::vector<Relator>> parsed_long_relator_sets;
+    parsed_long_relator_sets.reserve(long_relator_sets.size());
+    for (const std::vector<std::string> &words : long_relator_sets) {
+        parsed_long_relator_sets.push_back(parse_words(rank, words));
+    }
+
+    return permutation_reps_batched(
+        rank,
+        parse_words(rank, short_relators),
+        parse_words(rank, long_relators),
+        parsed_long_relator_sets,
+        max_degree,
+        strategy,
+        num_threads,
+        std::move(token),
+        deadline,
+        is_complete);
+}
+
+void
+create_cover_store(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    create_cover_store(
+        filename,
+        rank,
+        parse_words(rank, short_relators),
+        max_degree,
+        strategy,
+        num_threads,
+        std::move(token),
+        deadline,
+        is_complete);
+}
+
+TreeSizeEstimate
+estimate_tree_size(
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const DegreeType max_degree,
+    const size_t num_probes,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const uint64_t seed)
+{
+    return estimate_tree_size(
+        rank,
+        parse_words(rank, short_relators),
+        parse_words(rank, long_relators),
+        max_degree,
+        num_probes,
+        strategy,
+        num_threads,
+        seed);
+}
+
+CoverSample
+sample_covers(
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const DegreeType max_degree,
+    const size_t num_samples,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const uint64_t seed)
+{
+    return sample_covers(
+        rank,
+        parse_words(rank, short_relators),
+        parse_words(rank, long_relators),
+        max_degree,
+        num_samples,
+        strategy,
+        num_threads,
+        seed);
+}
+
+size_t
+create_result_file(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const bool delta_compressed,
+    std::shared_ptr<CancellationToken> token,
+    const double deadline,
+    bool * const is_complete)
+{
+    return create_result_file(
+        filename,
+        rank,
+        parse_words(rank, short_relators),
+        parse_words(rank, long_relators),
+        max_degree,
+        strategy,
+        num_threads,
+        delta_compressed,
+        std::move(token),
+        deadline,
+        is_complete);
 }
 
 }
@@ -2,7 +2,11 @@
 #define LOW_INDEX_LOW_INDEX_H
 
 #include "types.h"
+#include "cancellation.h"
+#include "permutationRepSet.h"
+#include "sampling.h"
 
+#include <memory>
 #include <utility>
 #include <string>
 
@@ -61,6 +65,27 @@ extern const std::string spin_short_strategy;
 /// num_threads = 0 automatically determines the number of threads by using
 /// the number of cores reported by the operating system. num_threads = 1
 /// forces the single-threaded implementation.
+///
+/// To split the computation across several processes or machines, run
+/// permutation_reps with the same arguments and with
+/// shard_index = 0, ..., num_shards - 1 and then combine the results with
+/// merge_permutation_reps. Each shard only searches part of the search
+/// tree (see SimsTreeBase::set_shard) and the shards do not need to
+/// communicate.
+///
+/// To stop the search early, pass a CancellationToken and/or a deadline
+/// in seconds (ignored unless positive). If is_complete is given, it is
+/// set to whether the search finished (see SimsTreeBase::is_complete)
+/// and a search that was stopped early returns the permutation
+/// representations found so far. Otherwise, SearchInterrupted is thrown
+/// in that case. SearchInterrupted is also thrown if the search was
+/// interrupted (see set_interrupt_check) and neither a token nor a
+/// deadline was given.
+///
+/// In python, permutation_reps (and the variants below) do not take
+/// token, deadline and is_complete. permutation_reps_partial (and so on)
+/// take token and deadline and return the result and is_complete as a
+/// pair.
 std::vector<std::vector<std::vector<DegreeType>>>
 permutation_reps(
     RankType rank,
@@ -68,7 +93,12 @@ permutation_reps(
     const std::vector<Relator> &long_relators,
     DegreeType max_degree,
     const std::string &strategy = spin_short_strategy,
-    unsigned int num_threads = 0);
+    unsigned int num_threads = 0,
+    unsigned int shard_index = 0,
+    unsigned int num_shards = 1,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
 
 /// An overload of permutation_reps that takes the relators as
 /// SnapPy-style words.
@@ -86,7 +116,231 @@ permutation_reps(
     const std::vector<std::string> &long_relators,
     DegreeType max_degree,
     const std::string &strategy = spin_short_strategy,
-    unsigned int num_threads = 0);
+    unsigned int num_threads = 0,
+    unsigned int shard_index = 0,
+    unsigned int num_shards = 1,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// A variant of permutation_reps returning the result as a
+/// PermutationRepSet.
+///
+/// This avoids allocating memory for each permutation and, in python,
+/// creating a list for each permutation. The order of the permutation
+/// representations in the PermutationRepSet is the same as the one returned
+/// by permutation_reps.
+PermutationRepSet
+permutation_rep_set(
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// An overload of permutation_rep_set that takes the relators as
+/// SnapPy-style words.
+PermutationRepSet
+permutation_rep_set(
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// Estimate the size of the search tree that permutation_reps would
+/// traverse (and thus how long it takes) with the given number of random
+/// probes. See SimsTreeBase::estimate_size.
+///
+/// The arguments are the same as for permutation_reps. The probes are
+/// split among num_threads threads.
+TreeSizeEstimate
+estimate_tree_size(
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    DegreeType max_degree,
+    size_t num_probes,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    uint64_t seed = 0);
+
+/// An overload of estimate_tree_size that takes the relators as
+/// SnapPy-style words.
+TreeSizeEstimate
+estimate_tree_size(
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    DegreeType max_degree,
+    size_t num_probes,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    uint64_t seed = 0);
+
+/// Draw random covers with importance weights, see
+/// SimsTreeBase::sample_covers.
+///
+/// The arguments are the same as for permutation_reps. The probes are
+/// split among num_threads threads.
+CoverSample
+sample_covers(
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    DegreeType max_degree,
+    size_t num_samples,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    uint64_t seed = 0);
+
+/// An overload of sample_covers that takes the relators as SnapPy-style
+/// words.
+CoverSample
+sample_covers(
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    DegreeType max_degree,
+    size_t num_samples,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    uint64_t seed = 0);
+
+/// Combine the results of permutation_reps for all shards into the result
+/// of permutation_reps without sharding (including the order).
+///
+/// The order of the given shards does not matter.
+std::vector<std::vector<std::vector<DegreeType>>>
+merge_permutation_reps(
+    const std::vector<std::vector<std::vector<std::vector<DegreeType>>>> &shards);
+
+/// A variant of permutation_reps for a family of groups sharing the same
+/// short_relators but differing in the long relators.
+///
+/// The i-th entry of the result is the same (including order) as
+/// permutation_reps for the group with short_relators and
+/// long_relators + long_relator_sets[i] as relators.
+///
+/// The search tree is only traversed once and each complete covering
+/// subgraph found is checked against all sets of long relators. This is
+/// much faster than calling permutation_reps for each set separately, e.g.,
+/// when enumerating the covers for many Dehn-fillings of the same cusped
+/// manifold.
+std::vector<std::vector<std::vector<std::vector<DegreeType>>>>
+permutation_reps_batched(
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const std::vector<std::vector<Relator>> &long_relator_sets,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// An overload of permutation_reps_batched that takes the relators as
+/// SnapPy-style words.
+std::vector<std::vector<std::vector<std::vector<DegreeType>>>>
+permutation_reps_batched(
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    const std::vector<std::vector<std::string>> &long_relator_sets,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+
+/// Find all complete covering subgraphs for which the short relators
+/// lift and write them to a file that can be opened with CoverStore.
+///
+/// See permutation_reps for the arguments. CoverStore::query can then be
+/// used to quickly find the covering subgraphs for which given long
+/// relators lift (without traversing the search tree again).
+///
+/// The covering subgraphs are streamed through a temporary result file
+/// next to the given file (see SimsTreeBase::list_to_file), so they do
+/// not need to fit into memory.
+///
+/// If is_complete is given and the search was stopped early, the file
+/// only contains the covering subgraphs found so far.
+void
+create_cover_store(
+    const std::string &filename,
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// An overload of create_cover_store that takes the relators as
+/// SnapPy-style words.
+void
+create_cover_store(
+    const std::string &filename,
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// A variant of permutation_reps writing the complete covering subgraphs
+/// to a file that can be read with ResultFile (instead of keeping them in
+/// memory). Returns the number of complete covering subgraphs.
+/// If delta_compressed is set, the file needs to be read with DeltaStream
+/// instead.
+///
+/// See SimsTreeBase::list_to_file. If is_complete is given and the search
+/// was stopped early, the file only contains the complete covering
+/// subgraphs found so far.
+size_t
+create_result_file(
+    const std::string &filename,
+    RankType rank,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    bool delta_compressed = false,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
+
+/// An overload of create_result_file that takes the relators as
+/// SnapPy-style words.
+size_t
+create_result_file(
+    const std::string &filename,
+    RankType rank,
+    const std::vector<std::string> &short_relators,
+    const std::vector<std::string> &long_relators,
+    DegreeType max_degree,
+    const std::string &strategy = spin_short_strategy,
+    unsigned int num_threads = 0,
+    bool delta_compressed = false,
+    std::shared_ptr<CancellationToken> token = nullptr,
+    double deadline = 0,
+    bool * is_complete = nullptr);
 
 }
 
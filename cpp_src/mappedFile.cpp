@@ -0,0 +1,107 @@
+#include "mappedFile.h"
+
+#include <stdexcept>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace low_index {
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string &filename)
+  : _data(nullptr)
+  , _size(0)
+  , _file(INVALID_HANDLE_VALUE)
+  , _mapping(nullptr)
+{
+    _file = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size)) {
+        CloseHandle(_file);
+        throw std::runtime_error("Could not determine size of " + filename);
+    }
+    _size = static_cast<size_t>(size.QuadPart);
+    if (_size == 0) {
+        // Mapping an empty file is an error on Windows.
+        return;
+    }
+    _mapping = CreateFileMappingA(
+        _file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping) {
+        CloseHandle(_file);
+        throw std::runtime_error("Could not map " + filename);
+    }
+    _data = static_cast<const uint8_t*>(
+        MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!_data) {
+        CloseHandle(_mapping);
+        CloseHandle(_file);
+        throw std::runtime_error("Could not map " + filename);
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping) {
+        CloseHandle(_mapping);
+    }
+    CloseHandle(_file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string &filename)
+  : _data(nullptr)
+  , _size(0)
+{
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        throw std::runtime_error("Could not determine size of " + filename);
+    }
+    _size = static_cast<size_t>(st.st_size);
+    if (_size == 0) {
+        // Mapping an empty file is an error.
+        close(fd);
+        return;
+    }
+    void * const p = mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping stays valid after closing the file descriptor.
+    close(fd);
+    if (p == MAP_FAILED) {
+        throw std::runtime_error("Could not map " + filename);
+    }
+    _data = static_cast<const uint8_t*>(p);
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) {
+        munmap(const_cast<uint8_t*>(_data), _size);
+    }
+}
+
+#endif
+
+} // Namespace low_index
@@ -0,0 +1,45 @@
+#ifndef LOW_INDEX_MAPPED_FILE_H
+#define LOW_INDEX_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace low_index {
+
+/// An RAII class to map a file read-only into memory.
+///
+/// Uses mmap on POSIX systems and MapViewOfFile on Windows. The pages
+/// are only loaded by the operating system when accessed, so files larger
+/// than the available memory can be mapped.
+///
+class MappedFile
+{
+public:
+    /// Map the given file. Throws std::runtime_error on failure.
+    MappedFile(const std::string &filename);
+
+    ~MappedFile();
+
+    /// Start of the mapped memory.
+    const uint8_t * data() const { return _data; }
+    /// Size of the file in bytes.
+    size_t size() const { return _size; }
+
+private:
+    // Follow rule-of-three/rule-of-five.
+    MappedFile(const MappedFile &other) = delete;
+    MappedFile& operator=(const MappedFile& other) = delete;
+
+    const uint8_t * _data;
+    size_t _size;
+#ifdef _WIN32
+    // Handles for file and file mapping object.
+    void * _file;
+    void * _mapping;
+#endif
+};
+
+} // Namespace low_index
+
+#endif
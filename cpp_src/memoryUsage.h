@@ -0,0 +1,50 @@
+#ifndef LOW_INDEX_MEMORY_USAGE_H
+#define LOW_INDEX_MEMORY_USAGE_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+namespace low_index {
+
+/// The memory (in bytes) used by a search, see SimsTreeBase::memory_usage.
+///
+/// This accounts for the data structures of the search, not for the
+/// overhead of the allocator, so the resident memory of the process is
+/// somewhat larger.
+struct MemoryUsage
+{
+    /// The memory allocated by each thread to recurse a node: room for
+    /// rank * max_degree + 2 nodes (see SimsNodeStack).
+    size_t stack_frames;
+    /// The nodes whose subtrees still need to be searched, that is,
+    /// the parts of the search tree that SimsTreeMultiThreaded
+    /// materializes to distribute work between the threads.
+    size_t pending_nodes;
+    /// The complete covering subgraphs found (in the compact form of
+    /// CoverList). Those written to a file by list_to_file are not
+    /// included.
+    size_t complete_nodes;
+    /// The short and long relators.
+    size_t relators;
+    /// Sum of the above.
+    size_t total;
+    /// The largest total during the last call to list() (or a variant).
+    size_t peak;
+};
+
+/// Thrown by SimsTreeBase::list() (and its variants) when the search was
+/// stopped because it would have used more memory than the limit given to
+/// SimsTreeBase::set_memory_limit.
+class MemoryLimitExceeded : public std::runtime_error
+{
+public:
+    MemoryLimitExceeded(const size_t limit)
+      : std::runtime_error(
+            "The search would use more than " + std::to_string(limit) +
+            " bytes, the limit set with set_memory_limit.") { }
+};
+
+} // Namespace low_index
+
+#endif
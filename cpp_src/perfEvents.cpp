@@ -0,0 +1,106 @@
+#include "perfEvents.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+#endif
+
+namespace low_index {
+
+#ifdef __linux__
+
+static int
+_open_event(const uint64_t config, const int group_fd)
+{
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    // pid = 0, cpu = -1: the calling thread on any cpu.
+    return static_cast<int>(
+        syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+PerfEventGroup::PerfEventGroup()
+{
+    static const uint64_t configs[num_events] = {
+        PERF_COUNT_HW_CPU_CYCLES,
+        PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES,
+        PERF_COUNT_HW_BRANCH_MISSES };
+
+    for (int i = 0; i < num_events; i++) {
+        _fds[i] = -1;
+    }
+    for (int i = 0; i < num_events; i++) {
+        const int fd = _open_event(configs[i], i == 0 ? -1 : _fds[0]);
+        if (fd == -1) {
+            // All or nothing.
+            for (int j = 0; j < i; j++) {
+                close(_fds[j]);
+                _fds[j] = -1;
+            }
+            return;
+        }
+        _fds[i] = fd;
+    }
+}
+
+PerfEventGroup::~PerfEventGroup()
+{
+    for (int i = num_events - 1; i >= 0; i--) {
+        if (_fds[i] != -1) {
+            close(_fds[i]);
+        }
+    }
+}
+
+bool
+PerfEventGroup::read(uint64_t values[num_events]) const
+{
+    if (!is_open()) {
+        return false;
+    }
+    // Layout for PERF_FORMAT_GROUP: number of counters, then the values.
+    uint64_t buffer[1 + num_events];
+    if (::read(_fds[0], buffer, sizeof(buffer)) !=
+            static_cast<ssize_t>(sizeof(buffer)) ||
+        buffer[0] != num_events) {
+        return false;
+    }
+    for (int i = 0; i < num_events; i++) {
+        values[i] = buffer[1 + i];
+    }
+    return true;
+}
+
+#else
+
+PerfEventGroup::PerfEventGroup()
+{
+    for (int i = 0; i < num_events; i++) {
+        _fds[i] = -1;
+    }
+}
+
+PerfEventGroup::~PerfEventGroup()
+{
+}
+
+bool
+PerfEventGroup::read(uint64_t values[num_events]) const
+{
+    (void)values;
+    return false;
+}
+
+#endif
+
+} // Namespace low_index
@@ -0,0 +1,49 @@
+#ifndef LOW_INDEX_PERF_EVENTS_H
+#define LOW_INDEX_PERF_EVENTS_H
+
+#include <cstdint>
+
+namespace low_index {
+
+/// Hardware performance counters of the calling thread, using the
+/// perf_event_open system call on Linux.
+///
+/// Only counts user space. The counters are unavailable (is_open() is
+/// false) on other platforms, if the kernel or (virtual) machine does not
+/// support them or if /proc/sys/kernel/perf_event_paranoid forbids it.
+class PerfEventGroup
+{
+public:
+    enum Event
+    {
+        cycles,
+        instructions,
+        cache_misses,
+        branch_misses,
+        num_events
+    };
+
+    /// Open the counters for the calling thread. They only count while
+    /// this thread runs.
+    PerfEventGroup();
+    ~PerfEventGroup();
+
+    PerfEventGroup(const PerfEventGroup&) = delete;
+    PerfEventGroup& operator=(const PerfEventGroup&) = delete;
+
+    /// Whether all counters could be opened.
+    bool is_open() const { return _fds[0] != -1; }
+
+    /// Read the current values of the counters. Returns false if the
+    /// counters are not open or reading failed.
+    bool read(uint64_t values[num_events]) const;
+
+private:
+    // The first one is the group leader so that all counters are
+    // scheduled together and can be read with one system call.
+    int _fds[num_events];
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,148 @@
+#include "permutationRepSet.h"
+
+#include <stdexcept>
+
+namespace low_index {
+
+PermutationRepSet::PermutationRepSet(
+    const RankType rank,
+    const DegreeType max_degree,
+    const std::vector<SimsNode> &nodes)
+  : _rank(rank)
+  , _max_degree(max_degree)
+{
+    std::vector<_Table> tables;
+    tables.reserve(nodes.size());
+    for (const SimsNode &node : nodes) {
+        if (node.rank() != rank) {
+            throw std::domain_error(
+                "PermutationRepSet: Covering subgraph has wrong rank.");
+        }
+        if (node.degree() > max_degree) {
+            throw std::domain_error(
+                "PermutationRepSet: Covering subgraph has too large "
+                "degree.");
+        }
+        if (!node.is_complete()) {
+            throw std::domain_error(
+                "PermutationRepSet: The graph is not a covering.");
+        }
+        tables.emplace_back(node.degree(), node.outgoing_table());
+    }
+    _init(tables);
+}
+
+PermutationRepSet::PermutationRepSet(
+    const RankType rank,
+    const DegreeType max_degree,
+    const CoverList &covers)
+  : _rank(rank)
+  , _max_degree(max_degree)
+{
+    if (!covers.empty() && covers.rank() != rank) {
+        throw std::domain_error(
+            "PermutationRepSet: Covering subgraph has wrong rank.");
+    }
+    std::vector<_Table> tables;
+    tables.reserve(covers.size());
+    for (size_t i = 0; i < covers.size(); i++) {
+        if (covers.degree(i) > max_degree) {
+            throw std::domain_error(
+                "PermutationRepSet: Covering subgraph has too large "
+                "degree.");
+        }
+        tables.emplace_back(covers.degree(i), covers.outgoing_table(i));
+    }
+    _init(tables);
+}
+
+void
+PermutationRepSet::_init(const std::vector<_Table> &tables)
+{
+    const RankType rank = _rank;
+    const DegreeType max_degree = _max_degree;
+
+    // Count the permutation representations of each degree to lay out
+    // _data.
+    _num_reps.resize(max_degree, 0);
+    for (const _Table &table : tables) {
+        _num_reps[table.first - 1]++;
+    }
+
+    _degree_offsets.reserve(max_degree + 1);
+    _degree_offsets.push_back(0);
+    for (DegreeType d = 1; d <= max_degree; d++) {
+        _degree_offsets.push_back(
+            _degree_offsets.back() + _num_reps[d - 1] * rank * d);
+    }
+
+    _data.resize(_degree_offsets.back());
+    _degrees.reserve(tables.size());
+    _offsets.reserve(tables.size());
+
+    // Where the next permutation representation of degree d goes.
+    std::vector<size_t> next_offsets(
+        _degree_offsets.begin(), _degree_offsets.end() - 1);
+
+    for (const _Table &table : tables) {
+        const DegreeType d = table.first;
+        const size_t offset = next_offsets[d - 1];
+        next_offsets[d - 1] += rank * d;
+        _degrees.push_back(d);
+        _offsets.push_back(offset);
+
+        // Transpose the outgoing table (which is indexed by vertex first)
+        // and convert to 0-based.
+        const DegreeType * const outgoing = table.second;
+        DegreeType * const perms = _data.data() + offset;
+        for (DegreeType v = 0; v < d; v++) {
+            for (RankType l = 0; l < rank; l++) {
+                perms[l * d + v] = outgoing[v * rank + l] - 1;
+            }
+        }
+    }
+}
+
+DegreeType
+PermutationRepSet::degree(const size_t i) const
+{
+    if (i >= size()) {
+        throw std::out_of_range(
+            "Index of permutation representation out of range.");
+    }
+    return _degrees[i];
+}
+
+std::vector<std::vector<DegreeType>>
+PermutationRepSet::permutation_rep(const size_t i) const
+{
+    const DegreeType d = degree(i);
+    const DegreeType * const perms = _data.data() + _offsets[i];
+
+    std::vector<std::vector<DegreeType>> result;
+    result.reserve(_rank);
+    for (RankType l = 0; l < _rank; l++) {
+        result.emplace_back(perms + l * d, perms + (l + 1) * d);
+    }
+    return result;
+}
+
+size_t
+PermutationRepSet::num_reps(const DegreeType degree) const
+{
+    if (degree < 1 || degree > _max_degree) {
+        return 0;
+    }
+    return _num_reps[degree - 1];
+}
+
+const DegreeType *
+PermutationRepSet::data(const DegreeType degree) const
+{
+    if (degree < 1 || degree > _max_degree) {
+        throw std::out_of_range("Degree out of range.");
+    }
+    return _data.data() + _degree_offsets[degree - 1];
+}
+
+} // Namespace low_index
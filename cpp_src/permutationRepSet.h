@@ -0,0 +1,93 @@
+#ifndef LOW_INDEX_PERMUTATION_REP_SET_H
+#define LOW_INDEX_PERMUTATION_REP_SET_H
+
+#include "coverList.h"
+
+namespace low_index {
+
+/// A compact container for the permutation representations of complete
+/// covering subgraphs.
+///
+/// Returning permutation representations as nested vectors (as
+/// permutation_reps does) requires a heap allocation for each permutation,
+/// which is costly, in particular when converting them to python lists.
+/// This container instead stores all permutations in one flat buffer.
+///
+/// Within this buffer, the permutation representations are grouped by
+/// degree. The permutation representations of degree d form an array
+/// of shape num_reps(d) x rank() x d where the entry at (i, l, v) is the
+/// image of v under the permutation for generator l (0-based). This array
+/// starts at data(d) and is exposed to python through the buffer protocol,
+/// e.g., numpy.asarray(reps.array(d)).
+///
+/// The permutation representations of a degree are in the same order as
+/// the complete covering subgraphs given to the constructor. The container
+/// also remembers the order across degrees so that
+/// permutation_rep(0), permutation_rep(1), ... gives the same result as
+/// permutation_reps.
+///
+class PermutationRepSet
+{
+public:
+    /// Create the permutation representations for the given complete
+    /// covering subgraphs which need to have the given rank and a degree
+    /// of at most max_degree. Throws std::domain_error otherwise.
+    PermutationRepSet(
+        RankType rank,
+        DegreeType max_degree,
+        const std::vector<SimsNode> &nodes);
+
+    /// Create the permutation representations for the given complete
+    /// covering subgraphs which need to have the given rank and a degree
+    /// of at most max_degree. Throws std::domain_error otherwise.
+    PermutationRepSet(
+        RankType rank,
+        DegreeType max_degree,
+        const CoverList &covers);
+
+    /// Number of generators.
+    RankType rank() const { return _rank; }
+    /// Maximal degree of the permutation representations.
+    DegreeType max_degree() const { return _max_degree; }
+    /// Number of permutation representations.
+    size_t size() const { return _degrees.size(); }
+
+    /// Degree of the i-th permutation representation.
+    DegreeType degree(size_t i) const;
+    /// The i-th permutation representation in the same form as an
+    /// entry of the result of permutation_reps.
+    std::vector<std::vector<DegreeType>> permutation_rep(size_t i) const;
+
+    /// Number of permutation representations of the given degree.
+    size_t num_reps(DegreeType degree) const;
+    /// Start of the num_reps(degree) x rank() x degree array of the
+    /// permutation representations of the given degree.
+    const DegreeType * data(DegreeType degree) const;
+
+private:
+    // Degree and outgoing table of a complete covering subgraph.
+    using _Table = std::pair<DegreeType, const DegreeType *>;
+
+    // Called by the constructors after validating the tables.
+    void _init(const std::vector<_Table> &tables);
+
+    RankType _rank;
+    DegreeType _max_degree;
+
+    // All permutations.
+    std::vector<DegreeType> _data;
+    // Degree and offset into _data of the i-th permutation representation.
+    std::vector<DegreeType> _degrees;
+    std::vector<size_t> _offsets;
+    // Number of permutation representations of degree d at
+    // _num_reps[d - 1].
+    std::vector<size_t> _num_reps;
+    // Offset into _data where the permutation representations of degree d
+    // start at _degree_offsets[d - 1] and _degree_offsets[max_degree] is the
+    // size of _data.
+    std::vector<size_t> _degree_offsets;
+};
+
+} // Namespace low_index
+
+#endif
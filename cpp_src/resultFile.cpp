@@ -0,0 +1,393 @@
+#include "resultFile.h"
+
+#include "deltaStream.h"
+
+#include <cstdio>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+
+namespace low_index {
+
+static const char _magic[] = { 'L', 'I', 'R', 'F' };
+static const uint32_t _version = 2;
+// Offsets of the number of covering subgraphs and of the index.
+static const size_t _size_offset = 16;
+static const size_t _index_offset_offset = 24;
+static const size_t _header_size = 32;
+// Append the records of a segment to the file when reaching this size.
+static const size_t _segment_buffer_size = 1 << 20;
+
+ResultSegmentWriter::ResultSegmentWriter(
+    ResultFileWriter * const file,
+    const RankType rank,
+    const DegreeType max_degree,
+    const bool delta_compressed)
+  : _file(file)
+  , _rank(rank)
+  , _record_size(1 + rank * max_degree)
+  , _delta_compressed(delta_compressed)
+  , _buffer_capacity(_segment_buffer_size)
+  , _size(0)
+  , _num_flushed_records(0)
+  , _num_covers(max_degree, 0)
+  , _num_flushed_bytes(0)
+{
+    // A delta compressed record has at most 9 more bytes for the prefix.
+    _buffer.reserve(_buffer_capacity + _record_size + 9);
+    begin_run();
+}
+
+void
+ResultSegmentWriter::begin_run()
+{
+    if (!_delta_compressed) {
+        return;
+    }
+    _previous.clear();
+    if (_run_starts.empty() || _run_starts.back().first != _size) {
+        _run_starts.push_back({_size, _num_flushed_bytes + _buffer.size()});
+    }
+}
+
+void
+ResultSegmentWriter::_write_delta(
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+{
+    append_delta_record(&_buffer, _rank, degree, outgoing, &_previous);
+    _num_covers[degree - 1]++;
+    _size++;
+    if (_buffer.size() >= _buffer_capacity) {
+        _flush();
+    }
+}
+
+void
+ResultSegmentWriter::_flush()
+{
+    if (_buffer.empty()) {
+        return;
+    }
+    const uint64_t offset = _file->_append_block(_buffer);
+    _blocks.push_back({offset, _num_flushed_bytes, _buffer.size(),
+                       _num_flushed_records, _size - _num_flushed_records});
+    _num_flushed_bytes += _buffer.size();
+    _num_flushed_records = _size;
+    _buffer.clear();
+}
+
+uint64_t
+ResultSegmentWriter::_byte_position(const size_t record) const
+{
+    if (!_delta_compressed) {
+        return record * _record_size;
+    }
+    if (record == _num_flushed_records) {
+        return _num_flushed_bytes;
+    }
+    const std::vector<std::pair<uint64_t, uint64_t>>::const_iterator it =
+        std::lower_bound(
+            _run_starts.begin(), _run_starts.end(),
+            std::pair<uint64_t, uint64_t>(record, 0));
+    if (it == _run_starts.end() || it->first != record) {
+        throw std::runtime_error("Run does not start with begin_run.");
+    }
+    return it->second;
+}
+
+void
+ResultSegmentWriter::_add_extents(
+    const size_t begin,
+    const size_t count,
+    std::vector<FileExtent> * const extents) const
+{
+    const size_t end = begin + count;
+    if (end > _num_flushed_records) {
+        throw std::runtime_error("Run exceeds segment.");
+    }
+    uint64_t b = _byte_position(begin);
+    const uint64_t e = _byte_position(end);
+    uint64_t record = begin;
+
+    // First block containing b. A block always holds whole records.
+    std::vector<_Block>::const_iterator block = std::upper_bound(
+        _blocks.begin(), _blocks.end(), b,
+        [](const uint64_t v, const _Block &block) {
+            return v < block.begin; });
+    --block;
+
+    while (b < e) {
+        const uint64_t block_end = block->begin + block->num_bytes;
+        const uint64_t n = std::min(e, block_end) - b;
+        const uint64_t offset = block->offset + (b - block->begin);
+        const uint64_t next_record = std::min<uint64_t>(
+            end, block->first_record + block->num_records);
+        // Merge with previous extent if physically consecutive.
+        if (!extents->empty() &&
+            extents->back().offset + extents->back().num_bytes == offset) {
+            extents->back().num_bytes += n;
+            extents->back().num_records += next_record - record;
+        } else {
+            extents->push_back({offset, n, next_record - record});
+        }
+        b += n;
+        record = next_record;
+        ++block;
+    }
+}
+
+ResultFileWriter::ResultFileWriter(
+    const std::string &filename,
+    const RankType rank,
+    const DegreeType max_degree,
+    const bool delta_compressed)
+  : _filename(filename)
+  , _rank(rank)
+  , _max_degree(max_degree)
+  , _delta_compressed(delta_compressed)
+  , _out(filename, std::ios::binary)
+  , _finished(false)
+{
+    if (!_out) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+    // Placeholder for the header written by finish.
+    const std::string header =
+        delta_compressed
+            ? delta_stream_header(rank, max_degree, 0, 0)
+            : std::string(_header_size, 0);
+    _out.write(header.data(), header.size());
+    _end = header.size();
+}
+
+ResultFileWriter::~ResultFileWriter()
+{
+    if (!_finished) {
+        _out.close();
+        std::remove(_filename.c_str());
+    }
+}
+
+ResultSegmentWriter *
+ResultFileWriter::add_segment()
+{
+    _segments.emplace_back(
+        new ResultSegmentWriter(
+            this, _rank, _max_degree, _delta_compressed));
+    return _segments.back().get();
+}
+
+void
+ResultFileWriter::add_run(
+    const size_t segment,
+    const size_t begin,
+    const size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+    // Merge with previous run if consecutive.
+    if (!_runs.empty()) {
+        _Run &last = _runs.back();
+        if (last.segment == segment && last.begin + last.count == begin) {
+            last.count += count;
+            return;
+        }
+    }
+    _runs.push_back({segment, begin, count});
+}
+
+uint64_t
+ResultFileWriter::_append_block(const std::string &bytes)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t offset = _end;
+    _out.write(bytes.data(), bytes.size());
+    if (!_out) {
+        throw std::runtime_error("Could not write " + _filename);
+    }
+    _end += bytes.size();
+    return offset;
+}
+
+size_t
+ResultFileWriter::finish()
+{
+    std::vector<uint64_t> num_covers(_max_degree, 0);
+    uint64_t size = 0;
+    for (std::unique_ptr<ResultSegmentWriter> &segment : _segments) {
+        segment->_flush();
+        for (DegreeType d = 0; d < _max_degree; d++) {
+            num_covers[d] += segment->_num_covers[d];
+        }
+        size += segment->size();
+    }
+
+    std::vector<FileExtent> extents;
+    uint64_t num_listed = 0;
+    for (const _Run &run : _runs) {
+        _segments[run.segment]->_add_extents(run.begin, run.count, &extents);
+        num_listed += run.count;
+    }
+    if (num_listed != size) {
+        throw std::runtime_error(
+            "Runs do not cover all segments when writing " + _filename);
+    }
+
+    const uint64_t index_offset = _end;
+    std::string index;
+    std::string header;
+    if (_delta_compressed) {
+        header = delta_stream_header(_rank, _max_degree, size, index_offset);
+    } else {
+        for (const uint64_t n : num_covers) {
+            append_uint<uint64_t>(&index, n);
+        }
+        header.assign(_magic, sizeof(_magic));
+        append_uint<uint32_t>(&header, _version);
+        append_uint<uint16_t>(&header, _rank);
+        append_uint<uint8_t>(&header, _max_degree);
+        header.resize(_size_offset, 0);
+        append_uint<uint64_t>(&header, size);
+        append_uint<uint64_t>(&header, index_offset);
+    }
+    append_extents(&index, extents);
+    _out.write(index.data(), index.size());
+    _out.seekp(0);
+    _out.write(header.data(), header.size());
+    _out.close();
+    if (!_out) {
+        throw std::runtime_error("Could not write " + _filename);
+    }
+    _finished = true;
+
+    return size;
+}
+
+ResultFile::ResultFile(const std::string &filename)
+  : _file(filename)
+{
+    const uint8_t * const data = _file.data();
+
+    if (_file.size() < _header_size ||
+        std::memcmp(data, _magic, sizeof(_magic)) != 0) {
+        throw std::runtime_error(filename + " is not a result file.");
+    }
+    if (read_uint<uint32_t>(data + 4) != _version) {
+        throw std::runtime_error(
+            filename + " has unsupported result file version.");
+    }
+    _rank = read_uint<uint16_t>(data + 8);
+    _max_degree = read_uint<uint8_t>(data + 10);
+    _size = read_uint<uint64_t>(data + _size_offset);
+
+    const uint64_t index_offset =
+        read_uint<uint64_t>(data + _index_offset_offset);
+    if (index_offset < _header_size || index_offset > _file.size()) {
+        throw std::runtime_error(filename + " has invalid index offset.");
+    }
+
+    try {
+        ByteReader reader(data + index_offset, _file.size() - index_offset);
+        for (DegreeType d = 1; d <= _max_degree; d++) {
+            _num_covers.push_back(reader.read_uint<uint64_t>());
+        }
+        _extents = read_extents(&reader, _header_size, index_offset);
+        if (!reader.at_end()) {
+            throw std::runtime_error("Unexpected data after index.");
+        }
+    } catch (const std::runtime_error &e) {
+        throw std::runtime_error(
+            filename + " has invalid index: " + e.what());
+    }
+
+    size_t n = 0;
+    for (const size_t num_covers : _num_covers) {
+        if (num_covers > _size - n) {
+            throw std::runtime_error(
+                filename + " has wrong number of records.");
+        }
+        n += num_covers;
+    }
+    if (n != _size) {
+        throw std::runtime_error(filename + " has wrong number of records.");
+    }
+
+    n = 0;
+    for (const FileExtent &extent : _extents) {
+        // num_bytes is bounded by the file size, so this cannot overflow.
+        if (extent.num_records > _size - n ||
+            extent.num_bytes % record_size() != 0 ||
+            extent.num_bytes / record_size() != extent.num_records) {
+            throw std::runtime_error(
+                filename + " has extent of wrong size.");
+        }
+        _extent_begin.push_back(n);
+        n += extent.num_records;
+    }
+    _extent_begin.push_back(n);
+    if (n != _size) {
+        throw std::runtime_error(filename + " has wrong number of records.");
+    }
+}
+
+size_t
+ResultFile::num_covers(const DegreeType degree) const
+{
+    if (degree < 1 || degree > _max_degree) {
+        return 0;
+    }
+    return _num_covers[degree - 1];
+}
+
+const uint8_t *
+ResultFile::extent_records(const size_t i) const
+{
+    if (i >= _extents.size()) {
+        throw std::out_of_range("Index of extent out of range.");
+    }
+    return _file.data() + _extents[i].offset;
+}
+
+size_t
+ResultFile::extent_size(const size_t i) const
+{
+    if (i >= _extents.size()) {
+        throw std::out_of_range("Index of extent out of range.");
+    }
+    return _extents[i].num_records;
+}
+
+const uint8_t *
+ResultFile::_record(const size_t i) const
+{
+    if (i >= _size) {
+        throw std::out_of_range("Index of covering subgraph out of range.");
+    }
+    // Last extent starting at or before i.
+    const size_t e = std::upper_bound(
+        _extent_begin.begin(), _extent_begin.end(), i)
+        - _extent_begin.begin() - 1;
+    return
+        _file.data() + _extents[e].offset +
+        (i - _extent_begin[e]) * record_size();
+}
+
+DegreeType
+ResultFile::degree(const size_t i) const
+{
+    const DegreeType d = *_record(i);
+    if (d < 1 || d > _max_degree) {
+        throw std::runtime_error("Result file has invalid degree.");
+    }
+    return d;
+}
+
+SimsNode
+ResultFile::cover(const size_t i) const
+{
+    return SimsNode(_rank, _max_degree, 0, degree(i), _record(i) + 1);
+}
+
+} // Namespace low_index
@@ -0,0 +1,275 @@
+#ifndef LOW_INDEX_RESULT_FILE_H
+#define LOW_INDEX_RESULT_FILE_H
+
+#include "simsNode.h"
+#include "binaryEncoding.h"
+#include "mappedFile.h"
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace low_index {
+
+/// The file format written by SimsTreeBase::list_to_file and read by
+/// ResultFile.
+///
+/// It stores complete covering subgraphs as records of a fixed size so
+/// that they can be accessed without parsing the file, e.g., as numpy
+/// array.
+///
+/// The records are written by several threads, each appending blocks of
+/// records to the file as it finds them. Thus, the records are not stored
+/// in the order of SimsTreeBase::list(). Instead, the index at the end of
+/// the file lists extents, that is, ranges of consecutive records in the
+/// file, such that concatenating the extents gives the records in the order
+/// of SimsTreeBase::list(). A file written by one thread has at most one
+/// extent.
+///
+/// File format (all integers are little-endian):
+/// - Header:
+///   - 4 bytes magic "LIRF"
+///   - uint32 version (currently 2)
+///   - uint16 rank
+///   - uint8 max_degree
+///   - 5 bytes reserved (zero)
+///   - uint64 number of covering subgraphs
+///   - uint64 byte offset of the index
+/// - Blocks of records. Each record is 1 + rank * max_degree bytes:
+///   - uint8 degree
+///   - CoveringSubgraph::outgoing_table (rank * degree bytes), padded
+///     with zeros to rank * max_degree bytes.
+/// - Index:
+///   - For each degree d = 1, ..., max_degree: uint64 number of covering
+///     subgraphs of degree d.
+///   - The extents, see append_extents.
+
+class ResultFileWriter;
+
+/// Writes records (in the above format or, if delta_compressed was given
+/// to the ResultFileWriter, in the format of DeltaStreamWriter) for
+/// complete covering subgraphs to the file of a ResultFileWriter.
+///
+/// Used by one thread of a SimsTreeBase implementation. The records are
+/// encoded right away, buffered and appended as a block to the file when
+/// the buffer is full.
+class ResultSegmentWriter
+{
+public:
+    /// Start a new run, that is, records which can be passed to
+    /// ResultFileWriter::add_run. Only needed when delta compressing: the
+    /// next record is then encoded without reference to the previous
+    /// record (which might not precede it in the result file).
+    void begin_run();
+
+    /// Append record for covering subgraph.
+    void write(const CoveringSubgraph &node) {
+        write(node.degree(), node.outgoing_table());
+    }
+
+    /// Append record for covering subgraph given by degree and outgoing
+    /// table (without checking it).
+    void write(const DegreeType degree, const DegreeType * const outgoing) {
+        if (_delta_compressed) {
+            _write_delta(degree, outgoing);
+            return;
+        }
+        const size_t n = _buffer.size();
+        _buffer.resize(n + _record_size, 0);
+        _buffer[n] = static_cast<char>(degree);
+        std::copy(outgoing, outgoing + _rank * degree,
+                  _buffer.begin() + n + 1);
+        _num_covers[degree - 1]++;
+        _size++;
+        if (_buffer.size() >= _buffer_capacity) {
+            _flush();
+        }
+    }
+
+    /// Number of records written so far.
+    size_t size() const { return _size; }
+
+private:
+    friend class ResultFileWriter;
+
+    ResultSegmentWriter(ResultFileWriter * file,
+                        RankType rank,
+                        DegreeType max_degree,
+                        bool delta_compressed);
+
+    // Implementation of write when _delta_compressed is set.
+    void _write_delta(DegreeType degree, const DegreeType * outgoing);
+
+    // Append the buffer as block to the file.
+    void _flush();
+
+    // The records first_record, ..., first_record + num_records - 1 of
+    // the segment, that is the bytes [begin, begin + num_bytes) of the
+    // segment seen as one sequence of bytes, are at offset in the file.
+    struct _Block
+    {
+        uint64_t offset;
+        uint64_t begin;
+        uint64_t num_bytes;
+        uint64_t first_record;
+        uint64_t num_records;
+    };
+
+    // Position of a record in the segment seen as one sequence of bytes.
+    // Only defined for the start of a run and the end of the segment when
+    // delta compressing.
+    uint64_t _byte_position(size_t record) const;
+
+    // Add the extents for the records in [begin, begin + count) to
+    // extents.
+    void _add_extents(size_t begin, size_t count,
+                      std::vector<FileExtent> * extents) const;
+
+    ResultFileWriter * const _file;
+    const RankType _rank;
+    const size_t _record_size;
+    const bool _delta_compressed;
+    // Records not written to the file yet.
+    std::string _buffer;
+    size_t _buffer_capacity;
+    size_t _size;
+    // Records of the segment in _blocks.
+    size_t _num_flushed_records;
+    // Outgoing table of the previous record when delta compressing.
+    std::vector<DegreeType> _previous;
+    // Pairs of index and byte position of the first record of each run
+    // when delta compressing.
+    std::vector<std::pair<uint64_t, uint64_t>> _run_starts;
+    // Number of records of degree d at _num_covers[d - 1].
+    std::vector<uint64_t> _num_covers;
+    std::vector<_Block> _blocks;
+    // Number of bytes in _blocks.
+    uint64_t _num_flushed_bytes;
+};
+
+/// Writes a file in the above format with the records written by several
+/// ResultSegmentWriter's.
+///
+/// Each ResultSegmentWriter (typically one for each thread) appends its
+/// records directly to the file. The order in which the records are listed
+/// by the index is given by runs, i.e., consecutive records of one segment.
+///
+/// If delta_compressed is set, the file is written in the format of
+/// DeltaStreamWriter instead. The segments then encode their records as
+/// they are written, so the runs need to start where
+/// ResultSegmentWriter::begin_run was called.
+class ResultFileWriter
+{
+public:
+    /// Open file for writing. Throws std::runtime_error on failure.
+    ResultFileWriter(const std::string &filename,
+                     RankType rank,
+                     DegreeType max_degree,
+                     bool delta_compressed = false);
+
+    /// Removes the file if finish was not called.
+    ~ResultFileWriter();
+
+    /// Add a new segment. Not thread-safe.
+    ResultSegmentWriter * add_segment();
+
+    /// Append the count records starting at begin in the segment with
+    /// the given index (in order of add_segment) to the result file.
+    /// Not thread-safe.
+    void add_run(size_t segment, size_t begin, size_t count);
+
+    /// Write the index. Returns the number of covering subgraphs.
+    size_t finish();
+
+private:
+    friend class ResultSegmentWriter;
+
+    // Follow rule-of-three/rule-of-five.
+    ResultFileWriter(const ResultFileWriter &other) = delete;
+    ResultFileWriter& operator=(const ResultFileWriter& other) = delete;
+
+    // Append bytes to the file and return their offset. Thread-safe.
+    uint64_t _append_block(const std::string &bytes);
+
+    const std::string _filename;
+    const RankType _rank;
+    const DegreeType _max_degree;
+    const bool _delta_compressed;
+    std::vector<std::unique_ptr<ResultSegmentWriter>> _segments;
+
+    // Protects _out and _end.
+    std::mutex _mutex;
+    std::ofstream _out;
+    // Offset of the next block.
+    uint64_t _end;
+    // Whether finish was called.
+    bool _finished;
+
+    struct _Run
+    {
+        size_t segment;
+        size_t begin;
+        size_t count;
+    };
+    std::vector<_Run> _runs;
+};
+
+/// A reader for a file written by SimsTreeBase::list_to_file.
+///
+/// The file is memory-mapped, so opening it is cheap and it can be larger
+/// than the available memory.
+///
+class ResultFile
+{
+public:
+    /// Open and map file. Throws std::runtime_error if the file cannot
+    /// be read or is not in the right format.
+    ResultFile(const std::string &filename);
+
+    /// Rank of the covering subgraphs.
+    RankType rank() const { return _rank; }
+    /// Maximal degree of the covering subgraphs.
+    DegreeType max_degree() const { return _max_degree; }
+    /// Total number of covering subgraphs in file.
+    size_t size() const { return _size; }
+    /// Number of covering subgraphs in file of given degree.
+    size_t num_covers(DegreeType degree) const;
+
+    /// Degree of the i-th covering subgraph.
+    DegreeType degree(size_t i) const;
+    /// The i-th covering subgraph in the file.
+    SimsNode cover(size_t i) const;
+
+    /// Size of a record in bytes, that is 1 + rank() * max_degree().
+    size_t record_size() const { return 1 + _rank * _max_degree; }
+
+    /// Number of extents, i.e., arrays of consecutive records such that
+    /// concatenating them gives the records in the order of
+    /// SimsTreeBase::list(). The extents can be read in parallel.
+    size_t num_extents() const { return _extents.size(); }
+    /// Start of the records of the i-th extent.
+    const uint8_t * extent_records(size_t i) const;
+    /// Number of records of the i-th extent.
+    size_t extent_size(size_t i) const;
+
+private:
+    // The memory-mapped file.
+    MappedFile _file;
+
+    RankType _rank;
+    DegreeType _max_degree;
+    size_t _size;
+    std::vector<size_t> _num_covers;
+    std::vector<FileExtent> _extents;
+    // Index of the first record of the i-th extent at _extent_begin[i]
+    // (and size() at the end).
+    std::vector<size_t> _extent_begin;
+
+    // Start of the i-th record.
+    const uint8_t * _record(size_t i) const;
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,119 @@
+#include "sampling.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace low_index {
+
+TreeSizeAccumulator::TreeSizeAccumulator(const size_t max_degree)
+  : _num_probes(0)
+  , _nodes_probed(0)
+  , _nodes_sum(max_degree + 1, 0.0)
+  , _nodes_sum_squares(max_degree + 1, 0.0)
+  , _covers_sum(max_degree + 1, 0.0)
+  , _covers_sum_squares(max_degree + 1, 0.0)
+{
+}
+
+// Add values and their total to sums.
+static
+void
+_add_to_sums(
+    const std::vector<double> &values,
+    std::vector<double> * const sum,
+    std::vector<double> * const sum_squares)
+{
+    const size_t n = values.size();
+    double total = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        (*sum)[i] += values[i];
+        (*sum_squares)[i] += values[i] * values[i];
+        total += values[i];
+    }
+    (*sum)[n] += total;
+    (*sum_squares)[n] += total * total;
+}
+
+void
+TreeSizeAccumulator::add_probe(
+    const std::vector<double> &nodes,
+    const std::vector<double> &covers,
+    const size_t nodes_probed)
+{
+    _add_to_sums(nodes, &_nodes_sum, &_nodes_sum_squares);
+    _add_to_sums(covers, &_covers_sum, &_covers_sum_squares);
+    _num_probes++;
+    _nodes_probed += nodes_probed;
+}
+
+void
+TreeSizeAccumulator::merge(const TreeSizeAccumulator &other)
+{
+    for (size_t i = 0; i < _nodes_sum.size(); i++) {
+        _nodes_sum[i] += other._nodes_sum[i];
+        _nodes_sum_squares[i] += other._nodes_sum_squares[i];
+        _covers_sum[i] += other._covers_sum[i];
+        _covers_sum_squares[i] += other._covers_sum_squares[i];
+    }
+    _num_probes += other._num_probes;
+    _nodes_probed += other._nodes_probed;
+}
+
+// Mean and standard error of the mean given the sum and the sum of
+// squares of n samples.
+static
+void
+_mean_and_error(
+    const double sum,
+    const double sum_squares,
+    const size_t n,
+    double * const mean,
+    double * const error)
+{
+    if (n == 0) {
+        *mean = 0.0;
+        *error = 0.0;
+        return;
+    }
+    *mean = sum / n;
+    if (n == 1) {
+        *error = 0.0;
+        return;
+    }
+    const double variance =
+        std::max(0.0, (sum_squares - n * *mean * *mean) / (n - 1));
+    *error = std::sqrt(variance / n);
+}
+
+TreeSizeEstimate
+TreeSizeAccumulator::result(const double seconds) const
+{
+    const size_t max_degree = _nodes_sum.size() - 1;
+
+    TreeSizeEstimate result;
+    result.num_probes = _num_probes;
+    result.nodes.resize(max_degree);
+    result.nodes_error.resize(max_degree);
+    result.covers.resize(max_degree);
+    result.covers_error.resize(max_degree);
+    for (size_t i = 0; i < max_degree; i++) {
+        _mean_and_error(_nodes_sum[i], _nodes_sum_squares[i], _num_probes,
+                        &result.nodes[i], &result.nodes_error[i]);
+        _mean_and_error(_covers_sum[i], _covers_sum_squares[i], _num_probes,
+                        &result.covers[i], &result.covers_error[i]);
+    }
+    _mean_and_error(_nodes_sum[max_degree], _nodes_sum_squares[max_degree],
+                    _num_probes,
+                    &result.total_nodes, &result.total_nodes_error);
+    _mean_and_error(_covers_sum[max_degree], _covers_sum_squares[max_degree],
+                    _num_probes,
+                    &result.total_covers, &result.total_covers_error);
+    result.nodes_probed = _nodes_probed;
+    result.estimated_seconds =
+        _nodes_probed > 0
+            ? result.total_nodes * seconds / _nodes_probed
+            : 0.0;
+    return result;
+}
+
+} // Namespace low_index
@@ -0,0 +1,138 @@
+#ifndef LOW_INDEX_SAMPLING_H
+#define LOW_INDEX_SAMPLING_H
+
+#include "coverList.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace low_index {
+
+/// A small pseudo-random number generator (splitmix64) used by the
+/// randomized methods of SimsTreeBase.
+///
+/// Unlike the generators and distributions of <random>, it gives the
+/// same sequence on all platforms so that the results only depend on the
+/// seed.
+class RandomGenerator
+{
+public:
+    explicit RandomGenerator(const uint64_t seed) : _state(seed) { }
+
+    /// A generator for the i-th of several independent streams derived
+    /// from one seed, e.g., one stream for each random probe.
+    static RandomGenerator stream(const uint64_t seed, const uint64_t i) {
+        RandomGenerator g(seed ^ (i * 0xd1342543de82ef95ULL));
+        return RandomGenerator(g());
+    }
+
+    /// Next pseudo-random 64-bit integer.
+    uint64_t operator()() {
+        uint64_t z = (_state += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31);
+    }
+
+    /// Pseudo-random integer in 0, ..., n - 1 (n has to be positive).
+    /// The bias is negligible for the small n used here.
+    size_t below(const size_t n) { return (*this)() % n; }
+
+private:
+    uint64_t _state;
+};
+
+/// The result of SimsTreeBase::estimate_size.
+///
+/// Each random probe gives an unbiased estimate of the number of nodes and
+/// complete covering subgraphs. The values here are the means over all
+/// probes. The errors are the standard errors of these means, so that
+/// value +/- 2 * error is roughly a 95% confidence interval. Note that
+/// the estimates of individual probes can vary wildly for unbalanced
+/// search trees, so the intervals are only trustworthy for a large number
+/// of probes.
+struct TreeSizeEstimate
+{
+    /// Number of random probes.
+    size_t num_probes;
+    /// Estimated number of nodes of the search tree with d vertices at
+    /// index d - 1.
+    std::vector<double> nodes;
+    /// Standard errors for nodes.
+    std::vector<double> nodes_error;
+    /// Estimated number of complete covering subgraphs of degree d
+    /// found by list() at index d - 1.
+    std::vector<double> covers;
+    /// Standard errors for covers.
+    std::vector<double> covers_error;
+    /// Estimated total number of nodes of the search tree.
+    double total_nodes;
+    /// Standard error for total_nodes.
+    double total_nodes_error;
+    /// Estimated total number of complete covering subgraphs.
+    double total_covers;
+    /// Standard error for total_covers.
+    double total_covers_error;
+    /// Number of nodes visited by all probes together.
+    size_t nodes_probed;
+    /// Estimated time in seconds for a single-threaded list(),
+    /// extrapolating the time the probes took per node.
+    double estimated_seconds;
+};
+
+/// The result of SimsTreeBase::sample_covers.
+///
+/// Contains the covers found by the random probes together with their
+/// importance weights, that is, the inverse of the probability that a
+/// probe reaches the cover. Probes that ended in a leaf that is not a
+/// result of list() contribute nothing.
+///
+/// For a function f on the covers, the sum of weights[i] * f(covers[i])
+/// divided by num_samples is an unbiased estimate of the sum of f over all
+/// covers found by list(). Dividing by the sum of the weights instead
+/// estimates the mean of f over all covers, e.g., the fraction of covers
+/// with a given property.
+struct CoverSample
+{
+    /// Number of random probes.
+    size_t num_samples;
+    /// The covers found, in the order of the probes.
+    CoverList covers;
+    /// The weight of each cover.
+    std::vector<double> weights;
+    /// The index of the probe that found each cover.
+    std::vector<size_t> probes;
+};
+
+/// Accumulates the per-probe estimates of SimsTreeBase::estimate_size.
+class TreeSizeAccumulator
+{
+public:
+    TreeSizeAccumulator(size_t max_degree);
+
+    /// Add the estimates of one probe (indexed by degree - 1).
+    void add_probe(const std::vector<double> &nodes,
+                   const std::vector<double> &covers,
+                   size_t nodes_probed);
+
+    /// Add the probes of another accumulator.
+    void merge(const TreeSizeAccumulator &other);
+
+    /// Compute means and standard errors.
+    TreeSizeEstimate result(double seconds) const;
+
+private:
+    size_t _num_probes;
+    size_t _nodes_probed;
+    // Sums and sums of squares of the estimates of the probes. The
+    // entry at max_degree is for the total.
+    std::vector<double> _nodes_sum;
+    std::vector<double> _nodes_sum_squares;
+    std::vector<double> _covers_sum;
+    std::vector<double> _covers_sum_squares;
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,113 @@
+#include "searchStatistics.h"
+
+namespace low_index {
+
+SearchCounters::SearchCounters(const unsigned int max_num_edges)
+  : _nodes_visited(new std::atomic<uint64_t>[max_num_edges + 1])
+  , _max_num_edges(max_num_edges)
+  , _phase_start_time(0)
+  , _perf_available(false)
+{
+    for (std::atomic<uint64_t> &counter : _counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+    for (std::atomic<uint64_t> &time : _phase_times) {
+        time.store(0, std::memory_order_relaxed);
+    }
+    for (auto &counts : _perf_counts) {
+        for (std::atomic<uint64_t> &counter : counts) {
+            counter.store(0, std::memory_order_relaxed);
+        }
+    }
+    for (unsigned int i = 0; i <= max_num_edges; i++) {
+        _nodes_visited[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void
+SearchCounters::add_to(SearchStatistics * const statistics) const
+{
+    statistics->nodes_visited.resize(_max_num_edges + 1, 0);
+    for (unsigned int i = 0; i <= _max_num_edges; i++) {
+        statistics->nodes_visited[i] +=
+            _nodes_visited[i].load(std::memory_order_relaxed);
+    }
+
+    uint64_t counters[num_counters];
+    for (int i = 0; i < num_counters; i++) {
+        counters[i] = _counters[i].load(std::memory_order_relaxed);
+    }
+    statistics->children_tried += counters[children_tried];
+    statistics->relators_pruned += counters[relators_pruned];
+    statistics->minimality_pruned += counters[minimality_pruned];
+    statistics->shard_pruned += counters[shard_pruned];
+    statistics->deductions += counters[deductions];
+    statistics->long_relator_checks += counters[long_relator_checks];
+    statistics->long_relator_failures += counters[long_relator_failures];
+    statistics->covers_found += counters[covers_found];
+
+    static const char * const phase_names[num_phases] = {
+        "slot", "copy", "lift", "minimality", "leaf" };
+    if (statistics_enabled) {
+        for (int i = 0; i < num_phases; i++) {
+            statistics->phase_seconds[phase_names[i]] +=
+                _phase_times[i].load(std::memory_order_relaxed) * 1e-9;
+        }
+    }
+
+    if (!_perf_available) {
+        return;
+    }
+    for (int i = 0; i < num_phases; i++) {
+        PerfCounts &counts = statistics->perf_counters[phase_names[i]];
+        counts.calls +=
+            _perf_counts[i][0].load(std::memory_order_relaxed);
+        counts.cycles +=
+            _perf_counts[i][1 + PerfEventGroup::cycles].load(
+                std::memory_order_relaxed);
+        counts.instructions +=
+            _perf_counts[i][1 + PerfEventGroup::instructions].load(
+                std::memory_order_relaxed);
+        counts.cache_misses +=
+            _perf_counts[i][1 + PerfEventGroup::cache_misses].load(
+                std::memory_order_relaxed);
+        counts.branch_misses +=
+            _perf_counts[i][1 + PerfEventGroup::branch_misses].load(
+                std::memory_order_relaxed);
+    }
+}
+
+void
+SearchCounters::open_perf_counters()
+{
+#ifdef LOW_INDEX_PERF_COUNTERS
+    std::unique_ptr<PerfEventGroup> events(new PerfEventGroup());
+    if (events->is_open() && events->read(_phase_start)) {
+        _perf_events = std::move(events);
+        _perf_available = true;
+    }
+#endif
+}
+
+void
+SearchCounters::close_perf_counters()
+{
+    _perf_events.reset();
+}
+
+void
+SearchCounters::_end_phase(const Phase phase)
+{
+    uint64_t values[PerfEventGroup::num_events];
+    if (!_perf_events->read(values)) {
+        return;
+    }
+    std::atomic<uint64_t> * const counts = _perf_counts[phase];
+    _increase(&counts[0], 1);
+    for (int i = 0; i < PerfEventGroup::num_events; i++) {
+        _increase(&counts[1 + i], values[i] - _phase_start[i]);
+        _phase_start[i] = values[i];
+    }
+}
+
+} // Namespace low_index
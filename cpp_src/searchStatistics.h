@@ -0,0 +1,240 @@
+#ifndef LOW_INDEX_SEARCH_STATISTICS_H
+#define LOW_INDEX_SEARCH_STATISTICS_H
+
+#include "perfEvents.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace low_index {
+
+/// Whether the search statistics are compiled in, see
+/// SimsTreeBase::statistics. Define the macro LOW_INDEX_STATISTICS when
+/// compiling (e.g., set the environment variable LOW_INDEX_STATISTICS=1
+/// when running setup.py) to enable them.
+#ifdef LOW_INDEX_STATISTICS
+const bool statistics_enabled = true;
+#else
+const bool statistics_enabled = false;
+#endif
+
+/// Whether the hardware performance counters are compiled in, see
+/// SearchStatistics::perf_counters. Define the macro
+/// LOW_INDEX_PERF_COUNTERS when compiling (e.g., set the environment
+/// variable LOW_INDEX_PERF_COUNTERS=1 when running setup.py) to enable
+/// them.
+#ifdef LOW_INDEX_PERF_COUNTERS
+const bool perf_counters_enabled = true;
+#else
+const bool perf_counters_enabled = false;
+#endif
+
+/// Hardware performance counters for one phase of a search, summed over
+/// all threads, see SearchStatistics::perf_counters.
+struct PerfCounts
+{
+    /// Number of times the phase was run.
+    uint64_t calls;
+    uint64_t cycles;
+    uint64_t instructions;
+    uint64_t cache_misses;
+    uint64_t branch_misses;
+
+    /// instructions / cycles.
+    double instructions_per_cycle() const {
+        return cycles ? double(instructions) / cycles : 0.0;
+    }
+};
+
+/// A snapshot of the counters of a search, see SimsTreeBase::statistics.
+///
+/// All counters are summed over all threads. If statistics_enabled is
+/// false, all counters are zero.
+struct SearchStatistics
+{
+    /// Number of nodes of the search tree visited, indexed by the number
+    /// of edges of the node.
+    std::vector<uint64_t> nodes_visited;
+    /// Number of children of incomplete nodes that were tried, i.e.,
+    /// edges added to a node.
+    uint64_t children_tried;
+    /// Number of children rejected by relators_may_lift - including
+    /// complete nodes for which the short relators do not lift.
+    uint64_t relators_pruned;
+    /// Number of children rejected by may_be_minimal.
+    uint64_t minimality_pruned;
+    /// Number of children skipped because they belong to a different
+    /// shard, see SimsTreeBase::set_shard.
+    uint64_t shard_pruned;
+    /// Number of edges added by relators_may_lift (as deductions of the
+    /// short relators).
+    uint64_t deductions;
+    /// Number of times a complete node was checked against a (non-empty)
+    /// set of long relators.
+    uint64_t long_relator_checks;
+    /// Number of those checks where the long relators did not lift.
+    uint64_t long_relator_failures;
+    /// Number of complete covering subgraphs found (counted once for
+    /// each set of long relators given to SimsTreeBase::list_batched it
+    /// is a result for).
+    uint64_t covers_found;
+    /// Seconds since list() (or a variant) was called - or how long it
+    /// took if it has finished.
+    double elapsed;
+    /// Seconds spent in each phase of the search (see perf_counters),
+    /// summed over all threads.
+    ///
+    /// Empty if statistics_enabled is false. The clock is read around
+    /// each phase, which adds some overhead to the search and the times.
+    std::map<std::string, double> phase_seconds;
+    /// The hardware performance counters for each phase of the search:
+    /// "slot" (finding the first empty slot of a node), "copy" (copying
+    /// a node and adding an edge), "lift" (relators_may_lift),
+    /// "minimality" (may_be_minimal) and "leaf" (checking a complete
+    /// node).
+    ///
+    /// Empty if perf_counters_enabled is false or the counters are not
+    /// available, see PerfEventGroup. Reading the counters around each
+    /// phase needs a system call, so the search is considerably slower
+    /// and the counts include some of the overhead.
+    std::map<std::string, PerfCounts> perf_counters;
+};
+
+/// The counters written by one thread of a search.
+///
+/// Only one thread writes to them but any thread can read them. If
+/// statistics_enabled is false, the methods to count are empty and
+/// optimized away.
+class SearchCounters
+{
+public:
+    enum Counter
+    {
+        children_tried,
+        relators_pruned,
+        minimality_pruned,
+        shard_pruned,
+        deductions,
+        long_relator_checks,
+        long_relator_failures,
+        covers_found,
+        num_counters
+    };
+
+    /// The phases of the search for SearchStatistics::perf_counters.
+    enum Phase
+    {
+        slot_phase,
+        copy_phase,
+        lift_phase,
+        minimality_phase,
+        leaf_phase,
+        num_phases
+    };
+
+    /// max_num_edges is the maximal number of edges of a node.
+    SearchCounters(unsigned int max_num_edges);
+
+    /// Increase counter by n.
+    void add(const Counter counter, const uint64_t n = 1) {
+#ifdef LOW_INDEX_STATISTICS
+        _increase(&_counters[counter], n);
+#else
+        (void)counter; (void)n;
+#endif
+    }
+
+    /// Count a visit of a node with the given number of edges.
+    void visit(const unsigned int num_edges) {
+#ifdef LOW_INDEX_STATISTICS
+        _increase(&_nodes_visited[num_edges], 1);
+#else
+        (void)num_edges;
+#endif
+    }
+
+    /// Open the hardware performance counters. Must be called by the
+    /// thread that does the search (and calls begin_phase and end_phase)
+    /// before it starts. Does nothing if perf_counters_enabled is false.
+    void open_perf_counters();
+    /// Close the hardware performance counters (from the same thread).
+    void close_perf_counters();
+
+    /// Start a phase.
+    void begin_phase() {
+#ifdef LOW_INDEX_STATISTICS
+        _phase_start_time = _now();
+#endif
+#ifdef LOW_INDEX_PERF_COUNTERS
+        if (_perf_events) {
+            _perf_events->read(_phase_start);
+        }
+#endif
+    }
+
+    /// Attribute the hardware events since the last call to begin_phase
+    /// or end_phase to the given phase. This also starts the next phase,
+    /// so consecutive phases do not need to call begin_phase again.
+    void end_phase(const Phase phase) {
+#ifdef LOW_INDEX_STATISTICS
+        const uint64_t now = _now();
+        _increase(&_phase_times[phase], now - _phase_start_time);
+        _phase_start_time = now;
+#endif
+#ifdef LOW_INDEX_PERF_COUNTERS
+        if (_perf_events) {
+            _end_phase(phase);
+        }
+#endif
+        (void)phase;
+    }
+
+    /// Add the counters to the snapshot.
+    void add_to(SearchStatistics * statistics) const;
+
+private:
+    // Since there is only one writer, there is no need for an (expensive)
+    // atomic read-modify-write. The atomics just make reading from a
+    // different thread well-defined.
+    static void _increase(std::atomic<uint64_t> * counter, const uint64_t n) {
+        counter->store(
+            counter->load(std::memory_order_relaxed) + n,
+            std::memory_order_relaxed);
+    }
+
+    void _end_phase(Phase phase);
+
+    // Nanoseconds of a monotonic clock.
+    static uint64_t _now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::atomic<uint64_t> _counters[num_counters];
+    std::unique_ptr<std::atomic<uint64_t>[]> _nodes_visited;
+    const unsigned int _max_num_edges;
+
+    // Start of the current phase and nanoseconds spent in each phase.
+    uint64_t _phase_start_time;
+    std::atomic<uint64_t> _phase_times[num_phases];
+
+    // Only set while the search is running in the thread that opened it.
+    std::unique_ptr<PerfEventGroup> _perf_events;
+    uint64_t _phase_start[PerfEventGroup::num_events];
+    // Whether the counters were opened successfully at some point.
+    std::atomic<bool> _perf_available;
+    // For each phase: calls and then the events.
+    std::atomic<uint64_t>
+        _perf_counts[num_phases][1 + PerfEventGroup::num_events];
+    // Avoid false sharing with the counters of other threads.
+    char _padding[64];
+};
+
+} // Namespace low_index
+
+#endif
@@ -1,5 +1,8 @@
 #include "simsNode.h"
 
+#include "binaryEncoding.h"
+
+#include <cstring>
 #include <limits>
 #include <stdexcept>
 
@@ -52,6 +55,17 @@ SimsNode::SimsNode(
     _initialize_memory();
 }
 
+SimsNode::SimsNode(
+    const RankType rank,
+    const DegreeType max_degree,
+    const unsigned int num_relators,
+    const DegreeType degree,
+    const DegreeType * const outgoing)
+ : SimsNode(rank, max_degree, num_relators)
+{
+    set_outgoing_table(degree, outgoing);
+}
+
 SimsNode::SimsNode(
     const AbstractSimsNode &other)
  : AbstractSimsNode(other)
@@ -85,4 +99,118 @@ SimsNode::SimsNode(SimsNode &&other)
     _memory_size = other._memory_size;
 }
 
+static const char _encoding_magic[] = { 'L', 'I', 'S', 'N' };
+static const uint8_t _encoding_version = 1;
+static const uint8_t _encoding_flag_lift_state = 1;
+
+// Bytes of the lift state for each relator and vertex.
+static const size_t _lift_state_size =
+    sizeof(RelatorLengthType) + sizeof(DegreeType);
+
+std::string
+encode_sims_nodes(
+    const std::vector<SimsNode> &nodes,
+    const bool with_lift_state)
+{
+    std::string result(_encoding_magic, sizeof(_encoding_magic));
+    append_uint<uint8_t>(&result, _encoding_version);
+    append_uint<uint8_t>(
+        &result, with_lift_state ? _encoding_flag_lift_state : 0);
+
+    RankType rank = 0;
+    DegreeType max_degree = 0;
+    unsigned int num_relators = 0;
+    if (!nodes.empty()) {
+        rank = nodes[0].rank();
+        max_degree = nodes[0].max_degree();
+        num_relators = nodes[0].num_relators();
+    }
+    append_uint<uint16_t>(&result, rank);
+    append_uint<uint8_t>(&result, max_degree);
+    append_uint<uint32_t>(&result, num_relators);
+    append_uint<uint64_t>(&result, nodes.size());
+    const size_t header_size = result.size();
+
+    for (const SimsNode &node : nodes) {
+        if (node.rank() != rank ||
+            node.max_degree() != max_degree ||
+            node.num_relators() != num_relators) {
+            throw std::domain_error(
+                "encode_sims_nodes: All nodes need to have the same rank, "
+                "max_degree and num_relators.");
+        }
+        node.encode(&result, with_lift_state);
+    }
+
+    // See decode_sims_nodes.
+    if (!with_lift_state &&
+        uint64_t(num_relators) * max_degree * _lift_state_size >
+                                        result.size() - header_size) {
+        throw std::domain_error(
+            "encode_sims_nodes: The nodes support too many relators to "
+            "be encoded without lift state.");
+    }
+
+    return result;
+}
+
+std::vector<SimsNode>
+decode_sims_nodes(const std::string &bytes)
+{
+    ByteReader reader(
+        reinterpret_cast<const uint8_t*>(bytes.data()), bytes.size());
+
+    if (bytes.size() < sizeof(_encoding_magic) ||
+        std::memcmp(reader.read_bytes(sizeof(_encoding_magic)),
+                    _encoding_magic, sizeof(_encoding_magic)) != 0) {
+        throw std::runtime_error(
+            "decode_sims_nodes: Not an encoding of SimsNode's.");
+    }
+    if (reader.read_uint<uint8_t>() != _encoding_version) {
+        throw std::runtime_error(
+            "decode_sims_nodes: Unsupported version.");
+    }
+    const bool with_lift_state =
+        reader.read_uint<uint8_t>() & _encoding_flag_lift_state;
+    const RankType rank = reader.read_uint<uint16_t>();
+    const DegreeType max_degree = reader.read_uint<uint8_t>();
+    const unsigned int num_relators = reader.read_uint<uint32_t>();
+    const uint64_t num_nodes = reader.read_uint<uint64_t>();
+
+    std::vector<SimsNode> result;
+    if (num_nodes == 0) {
+        return result;
+    }
+
+    // Bound the memory allocated below by the size of the bytes. Each
+    // node has degree at least 1 and thus takes at least the following
+    // number of bytes. Without the lift state, the memory for the lift
+    // state of a node would not be bounded by that, so the encoding has
+    // to be at least as large (see encode_sims_nodes).
+    const uint64_t min_node_size =
+        1 + uint64_t(rank) +
+        (with_lift_state ? uint64_t(num_relators) * _lift_state_size : 0);
+    if (num_nodes > reader.remaining() / min_node_size ||
+        (!with_lift_state &&
+         uint64_t(num_relators) * max_degree * _lift_state_size >
+                                                reader.remaining())) {
+        throw std::runtime_error("Unexpected end of data.");
+    }
+    result.reserve(num_nodes);
+
+    const SimsNode prototype(rank, max_degree, num_relators);
+    for (uint64_t i = 0; i < num_nodes; i++) {
+        SimsNode node(prototype);
+        node.decode(&reader, with_lift_state);
+        result.push_back(std::move(node));
+    }
+
+    if (!reader.at_end()) {
+        throw std::runtime_error(
+            "decode_sims_nodes: Unexpected trailing data.");
+    }
+
+    return result;
+}
+
 } // Namespace low_index
@@ -28,6 +28,14 @@ public:
              DegreeType max_degree,
              unsigned int num_relators = 0);
 
+    /// Create SimsNode from a table of outgoing edges, see
+    /// AbstractSimsNode::set_outgoing_table.
+    SimsNode(RankType rank,
+             DegreeType max_degree,
+             unsigned int num_relators,
+             DegreeType degree,
+             const DegreeType *outgoing);
+
     /// Copy a different subclass of SimsNode.
     SimsNode(const AbstractSimsNode &other);
     /// Copy a SimsNode.
@@ -45,6 +53,42 @@ private:
     std::unique_ptr<uint8_t[]> _memory;
 };
 
+/// Encode SimsNode's compactly as bytes, e.g., to send them to a different
+/// process or to store them. Use decode_sims_nodes to recover them.
+///
+/// All nodes need to have the same rank, max_degree and num_relators.
+/// If with_lift_state is false, the acceleration structure of
+/// relators_may_lift is not encoded. This makes the encoding of incomplete
+/// nodes smaller, but relators_may_lift has to be called with target 0
+/// after decoding before adding further edges. Throws std::domain_error
+/// if the nodes support so many relators that their lift state would be
+/// larger than the encoding without it (use with_lift_state then).
+///
+/// Format (all integers are little-endian):
+/// - 4 bytes magic "LISN"
+/// - uint8 version (currently 1)
+/// - uint8 flags (1 if the lift state is included)
+/// - uint16 rank
+/// - uint8 max_degree
+/// - uint32 num_relators
+/// - uint64 number of nodes
+/// - AbstractSimsNode::encode of each node
+std::string
+encode_sims_nodes(
+    const std::vector<SimsNode> &nodes,
+    bool with_lift_state = true);
+
+/// Decode SimsNode's encoded with encode_sims_nodes.
+///
+/// Throws std::runtime_error if the bytes are not such an encoding and
+/// std::domain_error if they do not describe valid graphs. The memory
+/// used by the result is bounded by a multiple of the size of the bytes.
+/// The lift state is checked against the degree, but it can only be
+/// checked against the relators by AbstractSimsNode::check_lift_state
+/// (which SimsTreeBase does for its root).
+std::vector<SimsNode>
+decode_sims_nodes(const std::string &bytes);
+
 } // Namespace low_index
 
 #endif
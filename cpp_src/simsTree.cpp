@@ -1,48 +1,155 @@
 #include "simsTree.h"
 #include "stackedSimsNode.h"
+#include "resultFile.h"
 
 namespace low_index {
 
+// Reading the clock is not free, so only check every so many calls to
+// _recurse whether a checkpoint is due or the search should stop.
+static const unsigned int _checkpoint_check_period = 1 << 16;
+
 SimsTree::SimsTree(
     const RankType rank,
     const DegreeType max_degree,
     const std::vector<Relator> &short_relators,
     const std::vector<Relator> &long_relators)
   : SimsTreeBase(rank, max_degree, short_relators, long_relators)
+  , _checkpoint_countdown(_checkpoint_check_period)
+  , _checkpoint_requested(false)
+  , _segment(nullptr)
 {
+    _create_counters(1);
 }
 
-std::vector<SimsNode>
+SimsTree::SimsTree(
+    const SimsNode &root,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators)
+  : SimsTreeBase(root, short_relators, long_relators)
+  , _checkpoint_countdown(_checkpoint_check_period)
+  , _checkpoint_requested(false)
+  , _segment(nullptr)
+{
+    _create_counters(1);
+}
+
+std::vector<CoverList>
 SimsTree::_list()
 {
-    // Allocate all memory needed to recurse up front.
-    SimsNodeStack stack(_root);
-    _recurse(stack.get_node());
+    const size_t num_sets = _long_relator_sets.size();
+    _complete_nodes.resize(num_sets);
+    if (_result_writer) {
+        _segment = _result_writer->add_segment();
+    }
+    _counters[0]->open_perf_counters();
+    _leaf_sink = _create_leaf_sink(&_complete_nodes, _segment);
+
+    // Process the items of the frontier (that is just the root unless
+    // we resume) in order.
+    std::vector<_FrontierItem> frontier = _initial_frontier();
+    size_t i = 0;
+    while (i < frontier.size()) {
+        _FrontierItem &item = frontier[i];
+        i++;
+        for (size_t j = 0; j < num_sets; j++) {
+            _complete_nodes[j].append(std::move(item.complete_nodes[j]));
+        }
+        if (!item.node) {
+            continue;
+        }
+
+        {
+            // Allocate all memory needed to recurse up front.
+            SimsNodeStack stack(*item.node);
+            item.node.reset();
+            _recurse(stack.get_node());
+        }
+        _publish_memory(&_leaf_sink->unpublished_memory);
+
+        if (_checkpoint_requested) {
+            // _recurse stopped (because a checkpoint is due or the
+            // search was cancelled). The frontier is now given by the complete
+            // nodes found so far, the _pending_nodes and the items we have
+            // not processed yet.
+            std::vector<_FrontierItem> new_frontier;
+            new_frontier.push_back(
+                { std::move(_complete_nodes), nullptr });
+            for (std::unique_ptr<SimsNode> &node : _pending_nodes) {
+                new_frontier.push_back(
+                    { std::vector<CoverList>(num_sets),
+                      std::move(node) });
+            }
+            for (; i < frontier.size(); i++) {
+                new_frontier.push_back(std::move(frontier[i]));
+            }
+
+            if (_stopped) {
+                // Save the frontier if checkpoints were requested and
+                // return the complete nodes found so far.
+                if (!_checkpoint_filename.empty()) {
+                    _write_checkpoint(new_frontier);
+                }
+                _complete_nodes = std::vector<CoverList>(num_sets);
+                for (_FrontierItem &item : new_frontier) {
+                    for (size_t j = 0; j < num_sets; j++) {
+                        _complete_nodes[j].append(
+                            std::move(item.complete_nodes[j]));
+                    }
+                }
+                _pending_nodes.clear();
+                _checkpoint_requested = false;
+                break;
+            }
+
+            _write_checkpoint(new_frontier);
+
+            // And continue with the new frontier.
+            frontier = std::move(new_frontier);
+            i = 0;
+            _complete_nodes = std::vector<CoverList>(num_sets);
+            _pending_nodes.clear();
+            _checkpoint_requested = false;
+        }
+    }
+
+    if (_segment) {
+        // Everything was written in order to the one segment.
+        _result_writer->add_run(0, 0, _segment->size());
+    }
+
+    _counters[0]->close_perf_counters();
+
     return std::move(_complete_nodes);
 }
 
 void
 SimsTree::_recurse(const StackedSimsNode &n)
 {
+    SearchCounters * const counters = _counters[0].get();
+    counters->visit(n.num_edges());
+
     if(n.is_complete()) {
-        if (!n.relators_lift(_long_relators)) {
-            return;
-        }
-        // Even though the graph is complete and thus relators_may_lift
-        // won't add edges itself, it is still marked as non-const.
-        // So make a copy - allocating memory on the heap, which we need
-        // to do anyway to add the result to _complete_nodes.
-        SimsNode copy(n);
-        if (!copy.relators_may_lift(_short_relators, {0,0}, 0)) {
-            return;
-        }
-        _complete_nodes.push_back(std::move(copy));
+        counters->begin_phase();
+        _add_complete_node(n, counters, _leaf_sink.get());
+        counters->end_phase(SearchCounters::leaf_phase);
         return;
     }
 
+    _checkpoint_countdown--;
+    if (_checkpoint_countdown == 0) {
+        _checkpoint_countdown = _checkpoint_check_period;
+        // So that _stop_due sees whether the memory limit is exceeded.
+        _publish_memory(&_leaf_sink->unpublished_memory);
+        if (_stop_due() || _checkpoint_due()) {
+            _checkpoint_requested = true;
+        }
+    }
+
     // Find vertex and letter so that no edge labeled by letter starts at the
     // vertex.
+    counters->begin_phase();
     const std::pair<LetterType, DegreeType> slot = n.first_empty_slot();
+    counters->end_phase(SearchCounters::slot_phase);
     const DegreeType m = std::min<DegreeType>(n.degree() + 1, n.max_degree());
     // Iterate through vertices where this edge could end.
     for (DegreeType v = 1; v <= m; v++) {
@@ -51,12 +158,35 @@ SimsTree::_recurse(const StackedSimsNode &n)
         if (n.act_by(-slot.first, v) != 0) {
             continue;
         }
+        counters->add(SearchCounters::children_tried);
+        counters->begin_phase();
         StackedSimsNode new_subgraph(n);
         new_subgraph.add_edge(slot.first, slot.second, v);
-        if (!new_subgraph.relators_may_lift(_short_relators, slot, v)) {
+        counters->end_phase(SearchCounters::copy_phase);
+        const bool may_lift =
+            new_subgraph.relators_may_lift(_short_relators, slot, v);
+        counters->end_phase(SearchCounters::lift_phase);
+        if (!may_lift) {
+            counters->add(SearchCounters::relators_pruned);
+            continue;
+        }
+        counters->add(SearchCounters::deductions,
+                      new_subgraph.num_edges() - n.num_edges() - 1);
+        const bool may_be_minimal = new_subgraph.may_be_minimal();
+        counters->end_phase(SearchCounters::minimality_phase);
+        if (!may_be_minimal) {
+            counters->add(SearchCounters::minimality_pruned);
+            continue;
+        }
+        if (!_is_in_shard(n, new_subgraph)) {
+            counters->add(SearchCounters::shard_pruned);
             continue;
         }
-        if (!new_subgraph.may_be_minimal()) {
+        if (_checkpoint_requested) {
+            // Record the subtree as still to be searched. Note that
+            // the nodes recorded by the nested calls to _recurse come
+            // before the ones recorded here in SimsTree order.
+            _pending_nodes.emplace_back(new SimsNode(new_subgraph));
             continue;
         }
         _recurse(new_subgraph);
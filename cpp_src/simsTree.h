@@ -2,6 +2,7 @@
 #define LOW_INDEX_SIMS_TREE_H
 
 #include "simsTreeBase.h"
+#include "leafSink.h"
 
 namespace low_index {
 
@@ -21,13 +22,41 @@ public:
         const std::vector<Relator> &short_relators,
         const std::vector<Relator> &long_relators);
 
+    /// Use the given SimsNode as root instead of the SimsNode with no
+    /// edges, e.g., one of the nodes returned by SimsTreeBase::bloom.
+    ///
+    /// The rank and max_degree are taken from the root. The root needs to
+    /// support the short_relators, see AbstractSimsNode::num_relators.
+    /// If the root has edges, relators_may_lift must have been called
+    /// with the short_relators after adding them.
+    SimsTree(
+        const SimsNode &root,
+        const std::vector<Relator> &short_relators,
+        const std::vector<Relator> &long_relators);
+
 protected:
-    std::vector<SimsNode> _list() override;
+    std::vector<CoverList> _list() override;
 
 private:
     void _recurse(const class StackedSimsNode &n);
 
-    std::vector<SimsNode> _complete_nodes;
+    // One list for each set in _long_relator_sets.
+    std::vector<CoverList> _complete_nodes;
+
+    // Number of calls to _recurse until we check again whether a
+    // checkpoint is due.
+    unsigned int _checkpoint_countdown;
+    // Set when a checkpoint is due or the search should stop. _recurse
+    // then stops recursing and adds the nodes still to be recursed to
+    // _pending_nodes instead.
+    bool _checkpoint_requested;
+    std::vector<std::unique_ptr<SimsNode>> _pending_nodes;
+
+    // Where to write the complete nodes when list_to_file is called.
+    ResultSegmentWriter * _segment;
+
+    // See SimsTreeBase::_create_leaf_sink.
+    std::unique_ptr<LeafSink> _leaf_sink;
 };
 
 } // Namespace low_index
@@ -1,7 +1,17 @@
 #include "simsTreeBase.h"
 
+#include "binaryEncoding.h"
+#include "leafSink.h"
+#include "mappedFile.h"
+#include "resultFile.h"
+#include "stackedSimsNode.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
 #include <stdexcept>
+#include <thread>
 
 namespace low_index {
 
@@ -10,10 +20,41 @@ SimsTreeBase::SimsTreeBase(
     const DegreeType max_degree,
     const std::vector<Relator> &short_relators,
     const std::vector<Relator> &long_relators)
-  : _root(rank, max_degree, short_relators.size())
+  : SimsTreeBase(
+        SimsNode(rank, max_degree, short_relators.size()),
+        short_relators,
+        long_relators)
+{
+}
+
+SimsTreeBase::SimsTreeBase(
+    const SimsNode &root,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators)
+  : _root(root)
   , _short_relators(short_relators)
   , _long_relators(long_relators)
+  , _stopped(false)
+  , _interrupted(false)
+  , _stack_memory(0)
+  , _relators_memory(0)
+  , _complete_node_memory(0)
+  , _peak_memory(0)
+  , _memory_limit(0)
+  , _memory_limit_exceeded(false)
+  , _checkpoint_interval(0)
+  , _start_time(0)
+  , _end_time(0)
+  , _shard_index(0)
+  , _num_shards(1)
+  , _shard_depth(default_shard_depth)
+  , _shard_edges(root.num_edges() + default_shard_depth)
 {
+    if (root.num_relators() != short_relators.size()) {
+        throw std::domain_error(
+            "The root has to support as many relators as there are "
+            "short relators.");
+    }
     for (const Relator &relator : short_relators) {
         if (!(relator.size() < std::numeric_limits<RelatorLengthType>::max())) {
             throw std::domain_error(
@@ -23,13 +64,795 @@ SimsTreeBase::SimsTreeBase(
                         std::numeric_limits<RelatorLengthType>::max())));
         }
     }
+    // The root might have been decoded from untrusted bytes.
+    root.check_lift_state(short_relators);
 }
 
 SimsTreeBase::~SimsTreeBase() = default;
 
+const unsigned int SimsTreeBase::default_shard_depth;
+
 std::vector<SimsNode>
 SimsTreeBase::list() {
-    return _list();
+    return list_compact().to_sims_nodes();
+}
+
+CoverList
+SimsTreeBase::list_compact() {
+    // A single set of no additional long relators.
+    return std::move(
+        _list_batched(std::vector<std::vector<Relator>>(1))[0]);
+}
+
+std::vector<std::vector<SimsNode>>
+SimsTreeBase::list_batched(
+    const std::vector<std::vector<Relator>> &long_relator_sets)
+{
+    std::vector<std::vector<SimsNode>> result;
+    for (const CoverList &covers : _list_batched(long_relator_sets)) {
+        result.push_back(covers.to_sims_nodes());
+    }
+    return result;
+}
+
+std::vector<CoverList>
+SimsTreeBase::_list_batched(
+    const std::vector<std::vector<Relator>> &long_relator_sets)
+{
+    if (long_relator_sets.empty()) {
+        throw std::domain_error(
+            "list_batched requires at least one set of long relators");
+    }
+    _long_relator_sets = long_relator_sets;
+    _next_checkpoint =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            _checkpoint_interval);
+    _stopped = false;
+    _interrupted = false;
+
+    // Each thread allocates one SimsNodeStack at a time.
+    _stack_memory = _counters.size() * SimsNodeStack::memory_size(_root);
+    _relators_memory = 0;
+    for (const Relator &relator : _short_relators) {
+        _relators_memory += _memory_of_relator(relator);
+    }
+    for (const Relator &relator : _long_relators) {
+        _relators_memory += _memory_of_relator(relator);
+    }
+    for (const std::vector<Relator> &relators : _long_relator_sets) {
+        for (const Relator &relator : relators) {
+            _relators_memory += _memory_of_relator(relator);
+        }
+    }
+    _complete_node_memory = 0;
+    _peak_memory = 0;
+    _memory_limit_exceeded = false;
+    _memory_grew();
+    if (_memory_limit_exceeded) {
+        throw MemoryLimitExceeded(_memory_limit);
+    }
+
+    _start_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    std::vector<CoverList> result = _list();
+    _end_time = std::chrono::steady_clock::now().time_since_epoch().count();
+    if (_memory_limit_exceeded) {
+        throw MemoryLimitExceeded(_memory_limit);
+    }
+    if (_interrupted && !_cancellation_token) {
+        // Only a caller who set a token expects a partial result.
+        throw SearchInterrupted();
+    }
+    return result;
+}
+
+MemoryUsage
+SimsTreeBase::memory_usage() const
+{
+    MemoryUsage result;
+    result.stack_frames = _stack_memory;
+    result.pending_nodes = _pending_memory();
+    result.complete_nodes = _complete_node_memory;
+    result.relators = _relators_memory;
+    result.total =
+        result.stack_frames + result.pending_nodes +
+        result.complete_nodes + result.relators;
+    result.peak = std::max<size_t>(_peak_memory, result.total);
+    return result;
+}
+
+void
+SimsTreeBase::set_memory_limit(const size_t bytes)
+{
+    _memory_limit = bytes;
+}
+
+void
+SimsTreeBase::_memory_grew() const
+{
+    const size_t total =
+        _stack_memory + _relators_memory + _pending_memory() +
+        _complete_node_memory;
+    size_t peak = _peak_memory;
+    while (total > peak && !_peak_memory.compare_exchange_weak(peak, total)) {
+    }
+    if (_memory_limit != 0 && total > _memory_limit) {
+        _memory_limit_exceeded = true;
+    }
+}
+
+void
+SimsTreeBase::set_cancellation_token(
+    std::shared_ptr<CancellationToken> token)
+{
+    _cancellation_token = std::move(token);
+}
+
+bool
+SimsTreeBase::is_complete() const
+{
+    return _end_time != 0 && !_stopped;
+}
+
+bool
+SimsTreeBase::_stop_due()
+{
+    if (interrupt_requested()) {
+        _interrupted = true;
+        _stopped = true;
+    }
+    if ((_cancellation_token && _cancellation_token->is_cancelled()) ||
+        _memory_limit_exceeded) {
+        _stopped = true;
+    }
+    return _stopped;
+}
+
+SimsNode
+SimsTreeBase::_random_path(
+    RandomGenerator * const rng,
+    std::vector<double> * const node_weights,
+    size_t * const num_nodes,
+    double * const weight) const
+{
+    // SimsNode has no operator=, so hold it through a pointer.
+    std::unique_ptr<SimsNode> node(new SimsNode(_root));
+    *weight = 1.0;
+    std::vector<SimsNode> children;
+    while (true) {
+        (*node_weights)[node->degree() - 1] += *weight;
+        (*num_nodes)++;
+        if (node->is_complete()) {
+            break;
+        }
+        children.clear();
+        _add_children(*node, &children);
+        if (children.empty()) {
+            break;
+        }
+        *weight *= children.size();
+        node.reset(
+            new SimsNode(std::move(children[rng->below(children.size())])));
+    }
+    return std::move(*node);
+}
+
+bool
+SimsTreeBase::_is_result(const SimsNode &leaf) const
+{
+    if (!leaf.is_complete()) {
+        return false;
+    }
+    if (_shard_index != 0 && leaf.num_edges() < _shard_edges) {
+        // Only matters for a complete root, see _is_in_shard.
+        return false;
+    }
+    return
+        leaf.relators_lift(_long_relators) &&
+        leaf.short_relators_lift(_short_relators);
+}
+
+template<typename Probe>
+void
+SimsTreeBase::_run_probes(
+    const size_t num_probes,
+    const unsigned int num_threads,
+    const Probe &probe)
+{
+    // The probes are pulled by the threads in order.
+    std::atomic<size_t> next_probe(0);
+
+    auto worker = [&](const unsigned int thread_index) {
+        while (true) {
+            const size_t i = next_probe++;
+            if (i >= num_probes) {
+                break;
+            }
+            probe(i, thread_index);
+        }
+    };
+
+    if (num_threads <= 1) {
+        worker(0);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (unsigned int i = 0; i < num_threads; i++) {
+        threads.emplace_back(worker, i);
+    }
+    for (std::thread &t : threads) {
+        t.join();
+    }
+}
+
+TreeSizeEstimate
+SimsTreeBase::estimate_size(
+    const size_t num_probes,
+    const uint64_t seed,
+    const unsigned int num_threads) const
+{
+    const DegreeType max_degree = _root.max_degree();
+    const auto start = std::chrono::steady_clock::now();
+
+    const unsigned int n = std::max(num_threads, 1u);
+    std::vector<TreeSizeAccumulator> accumulators(
+        n, TreeSizeAccumulator(max_degree));
+
+    _run_probes(
+        num_probes, n,
+        [&](const size_t i, const unsigned int thread_index) {
+            std::vector<double> nodes(max_degree);
+            std::vector<double> covers(max_degree);
+            RandomGenerator rng = RandomGenerator::stream(seed, i);
+            size_t num_nodes = 0;
+            double weight;
+            SimsNode leaf = _random_path(&rng, &nodes, &num_nodes, &weight);
+            if (_is_result(leaf)) {
+                covers[leaf.degree() - 1] += weight;
+            }
+            accumulators[thread_index].add_probe(nodes, covers, num_nodes);
+        });
+
+    for (size_t i = 1; i < accumulators.size(); i++) {
+        accumulators[0].merge(accumulators[i]);
+    }
+
+    // The probes ran in parallel, so the time spent per node is the
+    // elapsed time multiplied by the number of threads.
+    const double seconds =
+        std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count() * n;
+    return accumulators[0].result(seconds);
+}
+
+CoverSample
+SimsTreeBase::sample_covers(
+    const size_t num_samples,
+    const uint64_t seed,
+    const unsigned int num_threads) const
+{
+    const DegreeType max_degree = _root.max_degree();
+
+    const unsigned int n = std::max(num_threads, 1u);
+    std::vector<CoverSample> samples(n);
+
+    _run_probes(
+        num_samples, n,
+        [&](const size_t i, const unsigned int thread_index) {
+            std::vector<double> nodes(max_degree);
+            RandomGenerator rng = RandomGenerator::stream(seed, i);
+            size_t num_nodes = 0;
+            double weight;
+            SimsNode leaf = _random_path(&rng, &nodes, &num_nodes, &weight);
+            if (_is_result(leaf)) {
+                CoverSample &sample = samples[thread_index];
+                sample.covers.push_back(leaf);
+                sample.weights.push_back(weight);
+                sample.probes.push_back(i);
+            }
+        });
+
+    // Each thread pulled the probes in increasing order, so sorting
+    // the covers of all threads by probe gives the order that does not
+    // depend on the number of threads.
+    std::vector<std::pair<size_t, std::pair<unsigned int, size_t>>> order;
+    for (unsigned int t = 0; t < n; t++) {
+        for (size_t j = 0; j < samples[t].probes.size(); j++) {
+            order.push_back({samples[t].probes[j], {t, j}});
+        }
+    }
+    std::sort(order.begin(), order.end());
+
+    CoverSample result;
+    result.num_samples = num_samples;
+    result.weights.reserve(order.size());
+    result.probes.reserve(order.size());
+    for (const auto &entry : order) {
+        const CoverSample &sample = samples[entry.second.first];
+        const size_t j = entry.second.second;
+        result.covers.push_back(
+            _root.rank(), max_degree,
+            sample.covers.degree(j), sample.covers.outgoing_table(j));
+        result.weights.push_back(sample.weights[j]);
+        result.probes.push_back(entry.first);
+    }
+    return result;
+}
+
+void
+SimsTreeBase::_create_counters(const unsigned int num_threads)
+{
+    for (unsigned int i = 0; i < num_threads; i++) {
+        _counters.emplace_back(
+            new SearchCounters(_root.rank() * _root.max_degree()));
+    }
+}
+
+SearchStatistics
+SimsTreeBase::statistics() const
+{
+    SearchStatistics result = SearchStatistics();
+    for (const std::unique_ptr<SearchCounters> &counters : _counters) {
+        counters->add_to(&result);
+    }
+
+    const std::chrono::steady_clock::rep start = _start_time;
+    std::chrono::steady_clock::rep end = _end_time;
+    if (start != 0) {
+        if (end == 0) {
+            end = std::chrono::steady_clock::now().time_since_epoch().count();
+        }
+        result.elapsed =
+            std::chrono::duration<double>(
+                std::chrono::steady_clock::duration(end - start)).count();
+    }
+    return result;
+}
+
+std::vector<SimsNode>
+SimsTreeBase::bloom(const size_t num_nodes) const
+{
+    std::vector<SimsNode> nodes;
+    nodes.push_back(_root);
+
+    while (nodes.size() < num_nodes) {
+        // Replace each incomplete node by its children - which keeps
+        // the nodes in the order of list().
+        std::vector<SimsNode> expanded;
+        bool all_complete = true;
+        for (SimsNode &node : nodes) {
+            if (node.is_complete()) {
+                expanded.push_back(std::move(node));
+            } else {
+                _add_children(node, &expanded);
+                all_complete = false;
+            }
+        }
+        nodes = std::move(expanded);
+        if (all_complete) {
+            break;
+        }
+    }
+
+    return nodes;
+}
+
+void
+SimsTreeBase::_add_children(
+    const SimsNode &node,
+    std::vector<SimsNode> * const children) const
+{
+    const std::pair<LetterType, DegreeType> slot = node.first_empty_slot();
+    const DegreeType m =
+        std::min<DegreeType>(node.degree() + 1, node.max_degree());
+    for (DegreeType v = 1; v <= m; v++) {
+        if (node.act_by(-slot.first, v) != 0) {
+            continue;
+        }
+        SimsNode child(node);
+        child.add_edge(slot.first, slot.second, v);
+        if (!child.relators_may_lift(_short_relators, slot, v)) {
+            continue;
+        }
+        if (!child.may_be_minimal()) {
+            continue;
+        }
+        if (!_is_in_shard(node, child)) {
+            continue;
+        }
+        children->push_back(std::move(child));
+    }
+}
+
+size_t
+SimsTreeBase::list_to_file(
+    const std::string &filename,
+    const bool delta_compressed)
+{
+    if (!_checkpoint_filename.empty() || !_resume_filename.empty()) {
+        throw std::domain_error(
+            "list_to_file cannot be combined with checkpoints");
+    }
+    _result_writer.reset(
+        new ResultFileWriter(filename, _root.rank(), _root.max_degree(),
+                             delta_compressed));
+    // The implementation writes the complete nodes to the segments of
+    // _result_writer instead of returning them.
+    try {
+        list_compact();
+        const size_t result = _result_writer->finish();
+        _result_writer.reset();
+        return result;
+    } catch (...) {
+        // Removes the unfinished file. A later list() returns the
+        // complete nodes again.
+        _result_writer.reset();
+        throw;
+    }
+}
+
+SubgroupCounts
+SimsTreeBase::count()
+{
+    if (!_checkpoint_filename.empty() || !_resume_filename.empty()) {
+        throw std::domain_error(
+            "count cannot be combined with checkpoints");
+    }
+    const DegreeType max_degree = _root.max_degree();
+    _conjugacy_class_counts.reset(new std::atomic<uint64_t>[max_degree]());
+    _subgroup_counts.reset(new std::atomic<uint64_t>[max_degree]());
+    // The implementation counts the complete nodes in
+    // _add_complete_node instead of returning them.
+    try {
+        list_compact();
+    } catch (...) {
+        // So that a later list() returns the complete nodes again.
+        _conjugacy_class_counts.reset();
+        _subgroup_counts.reset();
+        throw;
+    }
+
+    SubgroupCounts result;
+    for (DegreeType d = 0; d < max_degree; d++) {
+        result.conjugacy_classes.push_back(_conjugacy_class_counts[d]);
+        result.subgroups.push_back(_subgroup_counts[d]);
+    }
+    _conjugacy_class_counts.reset();
+    _subgroup_counts.reset();
+    return result;
+}
+
+void
+SimsTreeBase::set_checkpoint(
+    const std::string &filename,
+    const double interval)
+{
+    _checkpoint_filename = filename;
+    _checkpoint_interval = std::chrono::duration<double>(interval);
+}
+
+void
+SimsTreeBase::resume(const std::string &filename)
+{
+    _resume_filename = filename;
+}
+
+void
+SimsTreeBase::set_shard(
+    const unsigned int shard_index,
+    const unsigned int num_shards,
+    const unsigned int shard_depth)
+{
+    if (num_shards == 0) {
+        throw std::domain_error("num_shards has to be positive");
+    }
+    if (shard_index >= num_shards) {
+        throw std::domain_error("shard_index has to be less than num_shards");
+    }
+    if (shard_depth == 0) {
+        throw std::domain_error("shard_depth has to be positive");
+    }
+    _shard_index = shard_index;
+    _num_shards = num_shards;
+    _shard_depth = shard_depth;
+    _shard_edges = _root.num_edges() + shard_depth;
+}
+
+unsigned int
+SimsTreeBase::_shard_of(const AbstractSimsNode &node) const
+{
+    // 32-bit FNV-1a hash of the outgoing edges - which determine the
+    // incoming edges. This only depends on the node and not on the
+    // platform.
+    uint32_t hash = 2166136261u;
+    const DegreeType * const outgoing = node.outgoing_table();
+    const size_t n = node.rank() * node.degree();
+    for (size_t i = 0; i < n; i++) {
+        hash ^= outgoing[i];
+        hash *= 16777619u;
+    }
+    return hash % _num_shards;
+}
+
+static const char _checkpoint_magic[] = { 'L', 'I', 'C', 'P' };
+static const uint32_t _checkpoint_version = 1;
+
+static
+void
+_encode_relators(
+    const std::vector<Relator> &relators,
+    std::string * const bytes)
+{
+    append_uint<uint32_t>(bytes, relators.size());
+    for (const Relator &relator : relators) {
+        append_uint<uint32_t>(bytes, relator.size());
+        for (const LetterType letter : relator) {
+            append_uint<RankType>(bytes, static_cast<RankType>(letter));
+        }
+    }
+}
+
+std::string
+SimsTreeBase::_encode_arguments() const
+{
+    std::string result;
+    append_uint<RankType>(&result, _root.rank());
+    append_uint<DegreeType>(&result, _root.max_degree());
+    _root.encode(&result, true);
+    _encode_relators(_short_relators, &result);
+    _encode_relators(_long_relators, &result);
+    append_uint<uint32_t>(&result, _long_relator_sets.size());
+    for (const std::vector<Relator> &relators : _long_relator_sets) {
+        _encode_relators(relators, &result);
+    }
+    append_uint<uint32_t>(&result, _shard_index);
+    append_uint<uint32_t>(&result, _num_shards);
+    append_uint<uint32_t>(&result, _shard_depth);
+    return result;
+}
+
+// File format of a checkpoint (see also binaryEncoding.h):
+// - 4 bytes magic "LICP"
+// - uint32 version
+// - uint32 length and bytes of SimsTreeBase::_encode_arguments
+// - uint64 number of items of frontier
+// - For each item:
+//   - For each set of long relators:
+//     - uint64 number of complete nodes
+//     - AbstractSimsNode::encode of each complete node (without lift
+//       state)
+//   - uint8 whether item has an incomplete node
+//   - AbstractSimsNode::encode of that node (with lift state)
+void
+SimsTreeBase::_write_checkpoint(
+    const std::vector<_FrontierItem> &frontier)
+{
+    std::string bytes(_checkpoint_magic, sizeof(_checkpoint_magic));
+    append_uint<uint32_t>(&bytes, _checkpoint_version);
+    const std::string arguments = _encode_arguments();
+    append_uint<uint32_t>(&bytes, arguments.size());
+    bytes += arguments;
+    append_uint<uint64_t>(&bytes, frontier.size());
+    for (const _FrontierItem &item : frontier) {
+        for (const CoverList &nodes : item.complete_nodes) {
+            append_uint<uint64_t>(&bytes, nodes.size());
+            for (size_t i = 0; i < nodes.size(); i++) {
+                // Same as AbstractSimsNode::encode without lift state.
+                const DegreeType d = nodes.degree(i);
+                append_uint<uint8_t>(&bytes, d);
+                bytes.append(
+                    reinterpret_cast<const char*>(nodes.outgoing_table(i)),
+                    _root.rank() * d);
+            }
+        }
+        append_uint<uint8_t>(&bytes, item.node ? 1 : 0);
+        if (item.node) {
+            item.node->encode(&bytes, true);
+        }
+    }
+
+    // Write to a temporary file first and then rename it so that
+    // a process being killed while writing does not leave us with a
+    // corrupted checkpoint.
+    const std::string tmp_filename = _checkpoint_filename + ".tmp";
+    {
+        std::ofstream out(tmp_filename, std::ios::binary);
+        out.write(bytes.data(), bytes.size());
+        if (!out) {
+            throw std::runtime_error("Could not write " + tmp_filename);
+        }
+    }
+#ifdef _WIN32
+    // rename does not replace an existing file on Windows.
+    std::remove(_checkpoint_filename.c_str());
+#endif
+    if (std::rename(tmp_filename.c_str(), _checkpoint_filename.c_str())
+            != 0) {
+        throw std::runtime_error("Could not write " + _checkpoint_filename);
+    }
+
+    _next_checkpoint =
+        std::chrono::steady_clock::now() +
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            _checkpoint_interval);
+}
+
+std::vector<SimsTreeBase::_FrontierItem>
+SimsTreeBase::_initial_frontier() const
+{
+    std::vector<_FrontierItem> result;
+
+    if (_resume_filename.empty()) {
+        // Start with the root - unless it is complete and thus belongs to
+        // the first shard, see _is_in_shard.
+        std::unique_ptr<SimsNode> root;
+        if (_shard_index == 0 || !_root.is_complete()) {
+            root.reset(new SimsNode(_root));
+        }
+        result.push_back(
+            { std::vector<CoverList>(_long_relator_sets.size()),
+              std::move(root) });
+        return result;
+    }
+
+    const MappedFile file(_resume_filename);
+    ByteReader reader(file.data(), file.size());
+
+    if (std::memcmp(reader.read_bytes(sizeof(_checkpoint_magic)),
+                    _checkpoint_magic, sizeof(_checkpoint_magic)) != 0) {
+        throw std::runtime_error(
+            _resume_filename + " is not a checkpoint.");
+    }
+    if (reader.read_uint<uint32_t>() != _checkpoint_version) {
+        throw std::runtime_error(
+            _resume_filename + " has unsupported checkpoint version.");
+    }
+    const std::string arguments = _encode_arguments();
+    const uint32_t arguments_size = reader.read_uint<uint32_t>();
+    if (arguments_size != arguments.size() ||
+        std::memcmp(reader.read_bytes(arguments_size),
+                    arguments.data(), arguments_size) != 0) {
+        throw std::domain_error(
+            _resume_filename +
+            " was written for different relators, max_degree or shard.");
+    }
+
+    const uint64_t num_items = reader.read_uint<uint64_t>();
+    for (uint64_t i = 0; i < num_items; i++) {
+        _FrontierItem item;
+        item.complete_nodes.resize(_long_relator_sets.size());
+        for (CoverList &nodes : item.complete_nodes) {
+            const uint64_t num_nodes = reader.read_uint<uint64_t>();
+            for (uint64_t j = 0; j < num_nodes; j++) {
+                // Decoding into a SimsNode validates the graph.
+                SimsNode node(_root);
+                node.decode(&reader, false);
+                nodes.push_back(node);
+            }
+        }
+        if (reader.read_uint<uint8_t>()) {
+            item.node.reset(new SimsNode(_root));
+            item.node->decode(&reader, true);
+            item.node->check_lift_state(_short_relators);
+        }
+        result.push_back(std::move(item));
+    }
+
+    if (!reader.at_end()) {
+        throw std::runtime_error(
+            _resume_filename + " has unexpected trailing data.");
+    }
+
+    return result;
+}
+
+std::unique_ptr<LeafSink>
+SimsTreeBase::_create_leaf_sink(
+    std::vector<CoverList> * const complete_nodes,
+    ResultSegmentWriter * const segment) const
+{
+    if (_subgroup_counts) {
+        return std::unique_ptr<LeafSink>(
+            new CountSink(_conjugacy_class_counts.get(),
+                          _subgroup_counts.get()));
+    }
+    if (segment) {
+        return std::unique_ptr<LeafSink>(new SegmentSink(segment));
+    }
+    return std::unique_ptr<LeafSink>(
+        new CoverListSink(_long_relator_sets, complete_nodes));
+}
+
+void
+SimsTreeBase::_add_complete_node(
+    const AbstractSimsNode &node,
+    SearchCounters * const counters,
+    LeafSink * const sink) const
+{
+    if (!_long_relators.empty()) {
+        counters->add(SearchCounters::long_relator_checks);
+        if (!node.relators_lift(_long_relators)) {
+            counters->add(SearchCounters::long_relator_failures);
+            return;
+        }
+    }
+    // Lifts the short relators from where the search left off without
+    // modifying the node.
+    if (!node.short_relators_lift(_short_relators)) {
+        counters->add(SearchCounters::relators_pruned);
+        return;
+    }
+
+    sink->add(node, counters);
+    if (sink->unpublished_memory >= _memory_batch_size) {
+        _publish_memory(&sink->unpublished_memory);
+    }
+}
+
+void
+SimsTreeBase::_publish_memory(size_t * const unpublished_memory) const
+{
+    if (*unpublished_memory == 0) {
+        return;
+    }
+    _complete_node_memory.fetch_add(
+        *unpublished_memory, std::memory_order_relaxed);
+    *unpublished_memory = 0;
+    _memory_grew();
+}
+
+// The key used by merge_shards. Comparing the keys lexicographically
+// gives the order of SimsTree::list().
+//
+// The key lists the outgoing and incoming edges in the same order in
+// which CoveringSubgraph::first_empty_slot visits them. For two different
+// complete covering subgraphs, consider the last common ancestor in the
+// search tree and the slot that was filled in two different ways to create
+// the next ancestors. All slots coming before it in this order are filled
+// the same way in both covering subgraphs. The subtree of the smaller
+// vertex filling the slot is searched first.
+static
+std::vector<DegreeType>
+_sims_tree_order_key(const SimsNode &node)
+{
+    std::vector<DegreeType> result;
+    result.reserve(2 * node.rank() * node.degree());
+    for (DegreeType v = 1; v <= node.degree(); v++) {
+        for (RankType l = 1; l <= node.rank(); l++) {
+            result.push_back(node.act_by(l, v));
+            result.push_back(node.act_by(-l, v));
+        }
+    }
+    return result;
+}
+
+std::vector<SimsNode>
+merge_shards(std::vector<std::vector<SimsNode>> shards)
+{
+    std::vector<std::pair<std::vector<DegreeType>, SimsNode*>> keyed_nodes;
+    for (std::vector<SimsNode> &nodes : shards) {
+        for (SimsNode &node : nodes) {
+            if (!node.is_complete()) {
+                throw std::domain_error(
+                    "merge_shards: The graph is not a covering.");
+            }
+            keyed_nodes.emplace_back(_sims_tree_order_key(node), &node);
+        }
+    }
+    std::sort(
+        keyed_nodes.begin(), keyed_nodes.end(),
+        [](const std::pair<std::vector<DegreeType>, SimsNode*> &a,
+           const std::pair<std::vector<DegreeType>, SimsNode*> &b) {
+            return a.first < b.first; });
+
+    std::vector<SimsNode> result;
+    result.reserve(keyed_nodes.size());
+    for (const auto &keyed_node : keyed_nodes) {
+        result.push_back(std::move(*keyed_node.second));
+    }
+    return result;
 }
 
 }
@@ -1,11 +1,24 @@
 #ifndef LOW_INDEX_SIMS_TREE_BASE_H
 #define LOW_INDEX_SIMS_TREE_BASE_H
 
-#include "simsNode.h"
+#include "cancellation.h"
+#include "coverList.h"
+#include "memoryUsage.h"
+#include "sampling.h"
+#include "searchStatistics.h"
+#include "subgroupCounts.h"
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
 
 namespace low_index {
 
+class LeafSink;
+class ResultFileWriter;
+class ResultSegmentWriter;
+
 /// A base class for algorithms to find all covering graphs of a given
 /// finitely presented group G up to a given degree.
 ///
@@ -27,6 +40,216 @@ public:
     ///
     std::vector<SimsNode> list();
 
+    /// Same as list() but returning the complete covering subgraphs as a
+    /// CoverList which takes a fraction of the memory.
+    ///
+    /// Same caveat as for list() applies.
+    CoverList list_compact();
+
+    /// Find all complete covering subgraphs for the given group G for
+    /// each of the given sets of (additional) long relators.
+    ///
+    /// That is, the i-th entry of the result contains the complete
+    /// covering subgraphs (in the same order as list()) for which the
+    /// short_relators, the long_relators and the relators in
+    /// long_relator_sets[i] lift.
+    ///
+    /// This is much faster than creating a separate tree for each set
+    /// of long relators since the search tree (which only depends on the
+    /// short_relators) is only traversed once and each complete leaf is
+    /// checked against all sets. A typical application are the Dehn-fillings
+    /// of a cusped manifold: the short_relators come from the fundamental
+    /// group of the cusped manifold and each set of long relators consists
+    /// of the word for a filling curve.
+    ///
+    /// Same caveat as for list() applies.
+    ///
+    std::vector<std::vector<SimsNode>> list_batched(
+        const std::vector<std::vector<Relator>> &long_relator_sets);
+
+    /// Find all complete covering subgraphs for the given group G and
+    /// write them to the given file (in the same order as list()) instead
+    /// of keeping them in memory. Returns the number of complete covering
+    /// subgraphs. The file can be read with ResultFile or, if
+    /// delta_compressed is set, with DeltaStream (which is typically
+    /// less than half the size but can only be read sequentially).
+    ///
+    /// Each thread appends blocks of the complete covering subgraphs it
+    /// finds directly to the given file. When the search is finished, an
+    /// index listing these blocks in the order of list() is written to the
+    /// end of the file.
+    ///
+    /// Cannot be combined with set_checkpoint or resume.
+    /// Same caveat as for list() applies.
+    size_t list_to_file(const std::string &filename,
+                        bool delta_compressed = false);
+
+    /// Count the complete covering subgraphs of each degree and the
+    /// subgroups they correspond to instead of returning them, e.g., to
+    /// compute the subgroup growth of G.
+    ///
+    /// The number of conjugacy classes of subgroups of index d is the
+    /// number of complete covering subgraphs of degree d returned by
+    /// list(). The number of all subgroups of index d is computed in the
+    /// same pass by adding AbstractSimsNode::conjugacy_class_size for each
+    /// of them, so no complete covering subgraph is kept in memory.
+    ///
+    /// The counts for the shards of a search (see set_shard) add up to
+    /// the counts of the whole search.
+    ///
+    /// Cannot be combined with set_checkpoint or resume.
+    /// Same caveat as for list() applies.
+    SubgroupCounts count();
+
+    /// Periodically (every interval seconds) write the state of the search
+    /// to the given file while list() or list_batched() is running.
+    ///
+    /// The state consists of the complete covering subgraphs found so far
+    /// and the (incomplete) covering subgraphs whose subtrees still need to
+    /// be searched. A later run can continue from this state with resume.
+    ///
+    /// The file is replaced atomically so that it always contains a
+    /// consistent state even if the process is killed while writing.
+    void set_checkpoint(const std::string &filename, double interval);
+
+    /// Continue the search from the state saved in the given file (see
+    /// set_checkpoint) instead of starting from the root when list() or
+    /// list_batched() is called.
+    ///
+    /// The result (including the order) is the same as that of an
+    /// uninterrupted run. The tree has to be constructed with the same
+    /// arguments and list() or list_batched() called with the same
+    /// arguments as for the run that wrote the file (but the number of
+    /// threads may differ). Otherwise, list() throws std::domain_error.
+    void resume(const std::string &filename);
+
+    /// Stop list() (or a variant) early when the given token is
+    /// cancelled (or its deadline has passed). The search then returns
+    /// the complete covering subgraphs found so far (in the same order as
+    /// list()) and is_complete() returns false.
+    ///
+    /// If set_checkpoint was called, a checkpoint is written when the
+    /// search stops so that a later run can resume it.
+    ///
+    /// This also applies when the search is interrupted (see
+    /// set_interrupt_check). Without a token, list() (or a variant)
+    /// throws SearchInterrupted in that case (KeyboardInterrupt in
+    /// python) instead of returning a partial result.
+    ///
+    /// The token is checked periodically, so the search stops within a
+    /// fraction of a second. The same token can be given to several trees.
+    void set_cancellation_token(std::shared_ptr<CancellationToken> token);
+
+    /// Whether list() (or a variant) has finished searching the whole
+    /// search tree, that is, it was neither cancelled (see
+    /// set_cancellation_token) nor interrupted (see set_interrupt_check,
+    /// e.g., by Ctrl-C in python).
+    bool is_complete() const;
+
+    /// Only search the part of the search tree belonging to the given
+    /// shard so that the search can be split across several processes
+    /// or machines without any coordination between them.
+    ///
+    /// Consider the incomplete covering subgraphs of the search tree
+    /// that have at least shard_depth edges more than the root while their
+    /// parent has fewer. Each such covering subgraph (and thus its subtree)
+    /// is assigned to one of the num_shards shards by a hash of its edges.
+    /// The few complete covering subgraphs with fewer edges are assigned
+    /// to the shard with index 0.
+    ///
+    /// Thus, the results of list() for shard_index = 0, ..., num_shards - 1
+    /// are disjoint and their union is the result of list() without
+    /// sharding. The results of each shard are in the same order as
+    /// list() without sharding, so merge_shards can restore that order.
+    ///
+    /// The assignment of subtrees to shards depends on the relators and
+    /// max_degree but is independent of the implementation of
+    /// SimsTreeBase, the number of threads and the platform. All shards
+    /// have to use the same shard_depth. A larger shard_depth gives more
+    /// and smaller subtrees which are likely to be balanced better
+    /// between the shards.
+    void set_shard(unsigned int shard_index,
+                   unsigned int num_shards,
+                   unsigned int shard_depth = default_shard_depth);
+
+    /// Default value for shard_depth in set_shard.
+    static const unsigned int default_shard_depth = 8;
+
+    /// Expand the search tree breadth-first starting from the root of
+    /// this tree until there are at least num_nodes nodes or all nodes are
+    /// complete and return the nodes.
+    ///
+    /// The nodes are returned in the order of list(). That is, constructing
+    /// a tree with the same relators for each node as root (see, e.g.,
+    /// SimsTree) and concatenating the results of list() gives the same
+    /// result as list() of this tree. This can be used to write custom
+    /// parallel drivers or to split a large subtree further.
+    ///
+    /// Note that complete nodes are returned as they are, that is, it is
+    /// left to the tree constructed for them to check the long relators.
+    std::vector<SimsNode> bloom(size_t num_nodes) const;
+
+    /// Estimate the size of the search tree (and thus how long list()
+    /// takes) without traversing it, using Knuth's method.
+    ///
+    /// Each probe walks down a random path from the root to a leaf of
+    /// the search tree, choosing uniformly among the children of each node
+    /// (with the same pruning as list()). Counting each node on the path
+    /// with weight the inverse of the probability of reaching it gives an
+    /// unbiased estimate for the number of nodes in the search tree.
+    ///
+    /// Probe i uses a pseudo-random generator determined by seed and i, so
+    /// the result only depends on seed and num_probes (up to floating point
+    /// rounding when num_threads > 1). The probes are split among
+    /// num_threads threads.
+    ///
+    /// This is cheap compared to list(), so it can be used to decide
+    /// whether a run is feasible, how many threads to use or which
+    /// relators to use as short relators.
+    TreeSizeEstimate estimate_size(size_t num_probes,
+                                   uint64_t seed = 0,
+                                   unsigned int num_threads = 1) const;
+
+    /// Draw random covers with importance weights, e.g., to estimate the
+    /// fraction of covers with some property when list() is hopeless.
+    ///
+    /// Uses the same random probes as estimate_size (with the same seed,
+    /// probe i ends in the same leaf). Probes ending in a leaf that is not
+    /// a result of list() do not yield a cover, so there are usually fewer
+    /// covers than num_samples. The probes are split among num_threads
+    /// threads and the result does not depend on num_threads.
+    CoverSample sample_covers(size_t num_samples,
+                              uint64_t seed = 0,
+                              unsigned int num_threads = 1) const;
+
+    /// A snapshot of the counters of the search, e.g., to see why a
+    /// search is slow or to monitor its progress.
+    ///
+    /// Can be called from a different thread while list() (or a variant)
+    /// is running. The counters are only compiled in if statistics_enabled
+    /// is true.
+    SearchStatistics statistics() const;
+
+    /// The memory used by the search with a breakdown into its parts,
+    /// e.g., to size batch jobs. Can be called from a different thread
+    /// while list() (or a variant) is running. After it has finished,
+    /// this is the memory used at the end of the search (including the
+    /// complete covering subgraphs returned) and the peak.
+    MemoryUsage memory_usage() const;
+
+    /// Stop list() (or a variant) and throw MemoryLimitExceeded when the
+    /// total of memory_usage() exceeds the given number of bytes. If
+    /// set_checkpoint was called, a checkpoint is written first.
+    ///
+    /// If the memory needed to just start the search (the stack frames
+    /// and relators) exceeds the limit, list() throws right away.
+    /// Otherwise, the limit is checked periodically (like the
+    /// cancellation token), so the search can exceed it slightly before
+    /// it stops.
+    ///
+    /// 0 (the default) means no limit.
+    void set_memory_limit(size_t bytes);
+
     virtual ~SimsTreeBase();
     
 protected:
@@ -37,14 +260,232 @@ protected:
         const std::vector<Relator> &short_relators,
         const std::vector<Relator> &long_relators);
 
-    // Implements list()
-    virtual std::vector<SimsNode> _list() = 0;
-   
+    /// Use the given SimsNode as root.
+    ///
+    /// The root needs to support the short_relators, that is,
+    /// root.num_relators() == short_relators.size(). Throws std::domain_error
+    /// otherwise.
+    SimsTreeBase(
+        const SimsNode &root,
+        const std::vector<Relator> &short_relators,
+        const std::vector<Relator> &long_relators);
+
+    // Implements list_batched() with the sets stored in
+    // _long_relator_sets. The result has one entry for each set.
+    virtual std::vector<CoverList> _list() = 0;
+
+    // Calls _list() after setting _long_relator_sets and preparing the
+    // checkpoints.
+    std::vector<CoverList> _list_batched(
+        const std::vector<std::vector<Relator>> &long_relator_sets);
+
+    // Part of the frontier of the search tree.
+    //
+    // In SimsTree order, the complete_nodes of an item come before
+    // the complete nodes found in the subtree of node, which come before
+    // the complete nodes of the next item.
+    struct _FrontierItem
+    {
+        // Complete nodes found already - one list for each set in
+        // _long_relator_sets.
+        std::vector<CoverList> complete_nodes;
+        // Node whose subtree still needs to be searched. Can be nullptr.
+        std::unique_ptr<SimsNode> node;
+    };
+
+    // The frontier to start with when _list is called: just _root or
+    // the frontier read from the file given to resume.
+    std::vector<_FrontierItem> _initial_frontier() const;
+
+    // Whether set_checkpoint was called and interval has passed since
+    // the last time _checkpoint_written was called.
+    bool _checkpoint_due() const {
+        return
+            !_checkpoint_filename.empty() &&
+            std::chrono::steady_clock::now() >= _next_checkpoint;
+    }
+
+    // Whether the search should stop because the token given to
+    // set_cancellation_token was cancelled or the user interrupted the
+    // search (see interrupt_requested). Sets _stopped if so.
+    //
+    // Reads the clock, so it should be called only periodically.
+    bool _stop_due();
+
+    // The memory of the nodes whose subtrees still need to be searched,
+    // see MemoryUsage::pending_nodes.
+    virtual size_t _pending_memory() const { return 0; }
+
+    // To be called when the memory used by the search grew. Updates the
+    // peak and flags the search to stop (see _stop_due) if the limit
+    // given to set_memory_limit is exceeded.
+    void _memory_grew() const;
+
+    // Write frontier to the checkpoint file.
+    void _write_checkpoint(const std::vector<_FrontierItem> &frontier);
+
+    // Create the sink for the complete nodes found by a thread: counting
+    // them if count was called, writing them to segment if list_to_file
+    // was called and adding them to complete_nodes (one entry for each
+    // set in _long_relator_sets) otherwise.
+    std::unique_ptr<LeafSink> _create_leaf_sink(
+        std::vector<CoverList> * complete_nodes,
+        ResultSegmentWriter * segment) const;
+
+    // Called by the implementations for a complete covering subgraph
+    // (a leaf in the search tree). Checks the relators and adds the node
+    // to sink if it is a result.
+    //
+    // The memory of the nodes stored by the sink is only added to
+    // _complete_node_memory in batches, see _publish_memory.
+    void _add_complete_node(
+        const AbstractSimsNode &node,
+        SearchCounters * counters,
+        LeafSink * sink) const;
+
+    // Add unpublished_memory (see LeafSink::unpublished_memory) to
+    // _complete_node_memory and reset it. The threads call this when a
+    // batch is full and when they finish searching a subtree.
+    void _publish_memory(size_t * unpublished_memory) const;
+
+    // Walk down a random path of the search tree from the root,
+    // choosing uniformly among the children of each node. Adds the inverse
+    // of the probability of reaching each node on the path to
+    // node_weights[d - 1] where d is the degree of the node and increments
+    // num_nodes.
+    //
+    // Returns the leaf at the end of the path and sets weight to the
+    // inverse of the probability of reaching it. The leaf is either
+    // complete or has no children.
+    SimsNode _random_path(RandomGenerator * rng,
+                          std::vector<double> * node_weights,
+                          size_t * num_nodes,
+                          double * weight) const;
+
+    // Run probe(i, thread_index) for i = 0, ..., num_probes - 1 using
+    // num_threads threads.
+    template<typename Probe>
+    static void _run_probes(size_t num_probes,
+                            unsigned int num_threads,
+                            const Probe &probe);
+
+    // Whether a leaf is a result of list().
+    bool _is_result(const SimsNode &leaf) const;
+
+    // Create the counters for the given number of threads. To be called
+    // by the constructor of an implementation.
+    void _create_counters(unsigned int num_threads);
+
+    // Add the children of node in the search tree to children. This does
+    // the same as one step of SimsTree::_recurse.
+    void _add_children(
+        const SimsNode &node,
+        std::vector<SimsNode> * children) const;
+
+    // Whether the subtree of child belongs to the shard given to
+    // set_shard. child is a child of parent in the search tree.
+    //
+    // Nodes that are complete before reaching shard_depth belong to the
+    // first shard.
+    bool _is_in_shard(const AbstractSimsNode &parent,
+                      const AbstractSimsNode &child) const {
+        return
+            _num_shards == 1 ||
+            parent.num_edges() >= _shard_edges ||
+            (child.num_edges() < _shard_edges
+                 ? _shard_index == 0 || !child.is_complete()
+                 : _shard_of(child) == _shard_index);
+    }
+
     const SimsNode _root;
     const std::vector<Relator> _short_relators;
     const std::vector<Relator> _long_relators;
+    // Set by list_batched. Has one empty entry when called through list().
+    std::vector<std::vector<Relator>> _long_relator_sets;
+
+    // Set while list_to_file is running.
+    std::unique_ptr<ResultFileWriter> _result_writer;
+
+    // Set while count is running. The CountSink adds to the entry for
+    // the degree of a node instead of storing it.
+    std::unique_ptr<std::atomic<uint64_t>[]> _conjugacy_class_counts;
+    std::unique_ptr<std::atomic<uint64_t>[]> _subgroup_counts;
+
+    // One for each thread. Not changed after construction so that
+    // statistics() can read them while the threads are running.
+    std::vector<std::unique_ptr<SearchCounters>> _counters;
+
+    // Set by set_checkpoint. Empty if no checkpoints are written.
+    std::string _checkpoint_filename;
+    // When the next checkpoint is due.
+    std::chrono::steady_clock::time_point _next_checkpoint;
+
+    // Set when the search stopped early, see _stop_due.
+    std::atomic<bool> _stopped;
+    // Set when it stopped because of interrupt_requested.
+    std::atomic<bool> _interrupted;
+
+    // Memory of the stack frames and of the relators (including
+    // _long_relator_sets), set when list() (or a variant) is called.
+    size_t _stack_memory;
+    size_t _relators_memory;
+    // Memory of the complete nodes stored by the LeafSinks. Lags
+    // behind by less than _memory_batch_size per thread.
+    mutable std::atomic<size_t> _complete_node_memory;
+    // Maximum of MemoryUsage::total seen by _memory_grew.
+    mutable std::atomic<size_t> _peak_memory;
+    // Set by set_memory_limit.
+    size_t _memory_limit;
+    // Set by _memory_grew when over _memory_limit.
+    mutable std::atomic<bool> _memory_limit_exceeded;
+
+private:
+    // The shard a node is assigned to (see set_shard).
+    unsigned int _shard_of(const AbstractSimsNode &node) const;
+
+    // Memory of a relator.
+    static size_t _memory_of_relator(const Relator &relator) {
+        return sizeof(Relator) + relator.size() * sizeof(LetterType);
+    }
+
+    // Size at which _add_complete_node publishes the memory of the
+    // complete nodes.
+    static const size_t _memory_batch_size = 1 << 16;
+
+    // Encode the arguments of the tree that need to match when resuming.
+    std::string _encode_arguments() const;
+
+    // Set by set_checkpoint.
+    std::chrono::duration<double> _checkpoint_interval;
+
+    // Set by set_cancellation_token.
+    std::shared_ptr<CancellationToken> _cancellation_token;
+
+    // Set by resume.
+    std::string _resume_filename;
+
+    // When list() (or a variant) started and finished as ticks of
+    // std::chrono::steady_clock (0 if not yet).
+    std::atomic<std::chrono::steady_clock::rep> _start_time;
+    std::atomic<std::chrono::steady_clock::rep> _end_time;
+
+    // Set by set_shard.
+    unsigned int _shard_index;
+    unsigned int _num_shards;
+    unsigned int _shard_depth;
+    // Subtrees are assigned to shards when reaching this number of edges,
+    // that is shard_depth more than _root has.
+    unsigned int _shard_edges;
 };
 
+/// Merge the results of SimsTreeBase::list() for the different shards
+/// (see SimsTreeBase::set_shard) into the same order as the result of
+/// SimsTreeBase::list() without sharding.
+///
+/// The order of the given vectors does not matter.
+std::vector<SimsNode>
+merge_shards(std::vector<std::vector<SimsNode>> shards);
+
 }
 
 #endif
@@ -1,11 +1,16 @@
 #include "simsTreeMultiThreaded.h"
 
 #include "stackedSimsNode.h"
+#include "leafSink.h"
+#include "resultFile.h"
 
 #include <thread>
 
 namespace low_index {
 
+// How often the main thread checks whether the search should stop.
+static const std::chrono::milliseconds _stop_check_period(50);
+
 SimsTreeMultiThreaded::SimsTreeMultiThreaded(
     const RankType rank,
     const DegreeType max_degree,
@@ -14,11 +19,84 @@ SimsTreeMultiThreaded::SimsTreeMultiThreaded(
     const unsigned int num_threads)
   : SimsTreeBase(rank, max_degree, short_relators, long_relators)
   , _num_threads(num_threads)
+  , _memory_budget(0)
+  , _frontier_memory(0)
+  , _recursion_stop_requested(false)
+  , _checkpoint_requested(false)
+  , _nodes(nullptr)
+  , _node_index(0)
+  , _num_working_threads(0)
+  , _search_finished(false)
+{
+    _create_counters(num_threads);
+}
+
+SimsTreeMultiThreaded::SimsTreeMultiThreaded(
+    const SimsNode &root,
+    const std::vector<Relator> &short_relators,
+    const std::vector<Relator> &long_relators,
+    const unsigned int num_threads)
+  : SimsTreeBase(root, short_relators, long_relators)
+  , _num_threads(num_threads)
+  , _memory_budget(0)
+  , _frontier_memory(0)
   , _recursion_stop_requested(false)
+  , _checkpoint_requested(false)
   , _nodes(nullptr)
   , _node_index(0)
   , _num_working_threads(0)
+  , _search_finished(false)
+{
+    _create_counters(num_threads);
+}
+
+void
+SimsTreeMultiThreaded::set_memory_budget(const size_t bytes)
+{
+    _memory_budget = bytes;
+}
+
+void
+SimsTreeMultiThreaded::set_trace_file(const std::string &filename)
+{
+    _trace_filename = filename;
+}
+
+size_t
+SimsTreeMultiThreaded::_node_memory() const
+{
+    return
+        sizeof(_Node) +
+        _long_relator_sets.size() * sizeof(CoverList);
+}
+
+size_t
+SimsTreeMultiThreaded::_root_memory() const
+{
+    return sizeof(SimsNode) + _root.memory_size();
+}
+
+size_t
+SimsTreeMultiThreaded::_tree_memory(const std::vector<_Node> &nodes) const
+{
+    size_t result = 0;
+    for (const _Node &node : nodes) {
+        result += _node_memory() + _tree_memory(node.children);
+        if (node.root) {
+            result += _root_memory();
+        }
+    }
+    return result;
+}
+
+void
+SimsTreeMultiThreaded::_add_child(
+    const AbstractSimsNode &new_subgraph,
+    _Node * const result)
 {
+    result->children.emplace_back(new_subgraph, _long_relator_sets.size());
+    _frontier_memory += _node_memory() + _root_memory();
+    _memory_grew();
 }
 
 // Recurse a SimsNode, similar to SimsTree::_recurse but writing the result
@@ -26,40 +104,57 @@ SimsTreeMultiThreaded::SimsTreeMultiThreaded(
 void
 SimsTreeMultiThreaded::_recurse(
     const StackedSimsNode &n,
-    _Node * const result)
+    _Node * const result,
+    SearchCounters * const counters,
+    LeafSink * const sink)
 {
+    counters->visit(n.num_edges());
+
     if(n.is_complete()) {
-        if (!n.relators_lift(_long_relators)) {
-            return;
-        }
-        SimsNode copy(n);
-        if (!copy.relators_may_lift(_short_relators, {0,0}, 0)) {
-            return;
-        }
-        result->complete_nodes.push_back(std::move(copy));
+        counters->begin_phase();
+        _add_complete_node(n, counters, sink);
+        counters->end_phase(SearchCounters::leaf_phase);
         return;
     }
 
+    counters->begin_phase();
     const std::pair<LetterType, DegreeType> slot = n.first_empty_slot();
+    counters->end_phase(SearchCounters::slot_phase);
     const DegreeType m = std::min<DegreeType>(n.degree() + 1, n.max_degree());
     for (DegreeType v = 1; v <= m; v++) {
         if (n.act_by(-slot.first, v) != 0) {
             continue;
         }
+        counters->add(SearchCounters::children_tried);
+        counters->begin_phase();
         StackedSimsNode new_subgraph(n);
         new_subgraph.add_edge(slot.first, slot.second, v);
-        if (!new_subgraph.relators_may_lift(_short_relators, slot, v)) {
+        counters->end_phase(SearchCounters::copy_phase);
+        const bool may_lift =
+            new_subgraph.relators_may_lift(_short_relators, slot, v);
+        counters->end_phase(SearchCounters::lift_phase);
+        if (!may_lift) {
+            counters->add(SearchCounters::relators_pruned);
+            continue;
+        }
+        counters->add(SearchCounters::deductions,
+                      new_subgraph.num_edges() - n.num_edges() - 1);
+        const bool may_be_minimal = new_subgraph.may_be_minimal();
+        counters->end_phase(SearchCounters::minimality_phase);
+        if (!may_be_minimal) {
+            counters->add(SearchCounters::minimality_pruned);
             continue;
         }
-        if (!new_subgraph.may_be_minimal()) {
+        if (!_is_in_shard(n, new_subgraph)) {
+            counters->add(SearchCounters::shard_pruned);
             continue;
         }
 
-        if (!result->children.empty()) {
+        if (!result->children.empty() || _checkpoint_requested) {
             // This thread responded to the recursion stop requested
-            // earlier - all nodes that still need to be recursed
-            // are added to children.
-            result->children.emplace_back(new_subgraph);
+            // earlier or a checkpoint is due - all nodes that still need
+            // to be recursed are added to children.
+            _add_child(new_subgraph, result);
             continue;
         }
 
@@ -68,35 +163,88 @@ SimsTreeMultiThreaded::_recurse(
         if (!n.is_complete()) {
             // Check whether the stop recursion flag was set.
             // Use exchange so that only one thread responds to it.
-            if (_recursion_stop_requested.exchange(false)) {
+            // When over the memory budget, keep recursing instead.
+            if (_within_memory_budget() &&
+                _recursion_stop_requested.exchange(false)) {
                 // Record SimsNode as needing to be recursed.
-                result->children.emplace_back(new_subgraph);
+                _add_child(new_subgraph, result);
                 continue;
             }
         }
 
-        _recurse(new_subgraph, result);
+        _recurse(new_subgraph, result, counters, sink);
     }
 }
 
 void
 SimsTreeMultiThreaded::_recurse(
-    _Node * const node)
+    _Node * const node,
+    const unsigned int thread_index)
 {
+    if (!node->root) {
+        // Only carries complete nodes from a checkpoint.
+        return;
+    }
+
+    if (!_segments.empty()) {
+        _segments[thread_index]->begin_run();
+        node->segment = thread_index;
+        node->runs.push_back(
+            {thread_index, _segments[thread_index]->size(), 0});
+    }
+
     // Allocate all the memory needed to recurse the SimsNode.
-    SimsNodeStack stack(node->root);
-    _recurse(stack.get_node(), node);
+    SimsNodeStack stack(*node->root);
+    // Free memory early and mark node as recursed.
+    node->root.reset();
+    _frontier_memory -= _root_memory();
+    if (_trace) {
+        _trace->begin(thread_index, "subtree",
+                      "edges", stack.get_node().num_edges());
+    }
+    const std::unique_ptr<LeafSink> sink = _create_leaf_sink(
+        &node->complete_nodes,
+        _segments.empty() ? nullptr : _segments[node->segment]);
+    _recurse(stack.get_node(), node, _counters[thread_index].get(),
+             sink.get());
+    _publish_memory(&sink->unpublished_memory);
+    if (_trace) {
+        if (!node->children.empty()) {
+            // Stopped recursing in response to _recursion_stop_requested
+            // (or because a checkpoint is due).
+            _trace->instant(thread_index, "stop response",
+                            "children", node->children.size());
+        }
+        _trace->end(thread_index);
+    }
+
+    for (_Node &child : node->children) {
+        child.parent = node;
+    }
+
+    if (!_segments.empty()) {
+        _Run &run = node->runs.front();
+        run.count = _segments[thread_index]->size() - run.begin;
+    }
 }
 
 void
-SimsTreeMultiThreaded::_thread_worker()
+SimsTreeMultiThreaded::_thread_worker(const unsigned int thread_index)
 {
+    // The counters only count the thread that opened them.
+    _counters[thread_index]->open_perf_counters();
+
     while(true) {
         // All logic to determine whether the queue is empty,
         // pull off the next node or keep track of the number of
         // working threads is protected by the mutex.
         std::unique_lock<std::mutex> lk(_mutex);
 
+        if (_checkpoint_requested) {
+            // Stop so that the checkpoint can be written.
+            break;
+        }
+
         const size_t index = _node_index;
         const size_t n = _nodes->size();
 
@@ -112,11 +260,11 @@ SimsTreeMultiThreaded::_thread_worker()
             // Release lock and recurse the node.
             lk.unlock();
             _Node &node = nodes[index];
-            _recurse(&node);
+            _recurse(&node, thread_index);
             const bool has_children = !node.children.empty();
             lk.lock();
 
-            if (has_children) {
+            if (has_children && !_checkpoint_requested) {
                 // This thread stopped recursing and filled
                 // _Node::children instead.
                 //
@@ -128,6 +276,11 @@ SimsTreeMultiThreaded::_thread_worker()
                 // to it.
                 _nodes = &node.children;
                 _node_index = 0;
+                if (_trace) {
+                    _trace->instant(thread_index, "swap queue",
+                                    "nodes", node.children.size());
+                }
+                node.num_unfinished_children = node.children.size();
 
                 // Note that _num_working_threads is decreased after we have
                 // refilled the queue:
@@ -135,6 +288,10 @@ SimsTreeMultiThreaded::_thread_worker()
                 // could trigger the threads to terminate.
             }
 
+            if (!has_children) {
+                _finish_node(&node);
+            }
+
             _num_working_threads--;
 
             if (has_children || _num_working_threads == 0) {
@@ -147,6 +304,7 @@ SimsTreeMultiThreaded::_thread_worker()
             if (_num_working_threads == 0) {
                 // No _Node's left in the queue and no thread is recursing.
                 // Terminate.
+                _search_finished = true;
                 break;
             }
 
@@ -159,41 +317,178 @@ SimsTreeMultiThreaded::_thread_worker()
                 // flag only once until the queue has been refilled.
                 _node_index++;
                 _recursion_stop_requested = true;
+                if (_trace) {
+                    _trace->instant(thread_index, "stop request");
+                }
             }
 
             // Sleep until either the work queue has been refilled or
             // _num_working_threads changed.
+            if (_trace) {
+                _trace->begin(thread_index, "wait");
+            }
             _wake_up_threads.wait(lk);
+            if (_trace) {
+                _trace->end(thread_index);
+            }
         }
     }
+
+    _counters[thread_index]->close_perf_counters();
+}
+
+void
+SimsTreeMultiThreaded::_finish_node(_Node * node)
+{
+    while (_Node * const parent = node->parent) {
+        parent->num_unfinished_children--;
+        if (parent->num_unfinished_children > 0) {
+            return;
+        }
+
+        // Same order as _merge_vectors.
+        for (_Node &child : parent->children) {
+            for (size_t i = 0; i < parent->complete_nodes.size(); i++) {
+                parent->complete_nodes[i].append(
+                    std::move(child.complete_nodes[i]));
+            }
+            for (const _Run &run : child.runs) {
+                _append_run(run, &parent->runs);
+            }
+        }
+        if (_nodes == &parent->children) {
+            // All _Node's of the queue were pulled off already.
+            _nodes = &_no_nodes;
+            _node_index = 0;
+        }
+        _frontier_memory -= parent->children.size() * _node_memory();
+        // Actually free the memory.
+        std::vector<_Node>().swap(parent->children);
+
+        node = parent;
+    }
 }
 
 void
 SimsTreeMultiThreaded::_merge_vectors(
-    const std::vector<_Node> &nodes,
-    std::vector<SimsNode> * const result)
+    std::vector<_Node> * const nodes,
+    std::vector<CoverList> * const result)
 {
-    for (const auto &node : nodes) {
-        for (const SimsNode &complete_node : node.complete_nodes) {
-            result->push_back(complete_node);
+    for (_Node &node : *nodes) {
+        for (size_t i = 0; i < result->size(); i++) {
+            (*result)[i].append(std::move(node.complete_nodes[i]));
         }
-        _merge_vectors(node.children, result);
+        _merge_vectors(&node.children, result);
     }
 }
 
-std::vector<SimsNode>
-SimsTreeMultiThreaded::_list()
+void
+SimsTreeMultiThreaded::_append_run(
+    const _Run &run,
+    std::vector<_Run> * const runs)
+{
+    if (run.count == 0) {
+        return;
+    }
+    if (!runs->empty()) {
+        _Run &last = runs->back();
+        if (last.segment == run.segment &&
+            last.begin + last.count == run.begin) {
+            last.count += run.count;
+            return;
+        }
+    }
+    runs->push_back(run);
+}
+
+void
+SimsTreeMultiThreaded::_collect_runs(
+    const std::vector<_Node> &nodes)
 {
-    // The root _Node containing a SimsNode without any edges.
-    std::vector<_Node> root_nodes{_Node(_root)};
+    // Same traversal as _merge_vectors. The runs of finished _Node's
+    // were already moved to their parent by _finish_node.
+    for (const _Node &node : nodes) {
+        for (const _Run &run : node.runs) {
+            _result_writer->add_run(run.segment, run.begin, run.count);
+        }
+        _collect_runs(node.children);
+    }
+}
+
+void
+SimsTreeMultiThreaded::_collect_frontier(
+    std::vector<_Node> * const nodes,
+    _FrontierItem * const current,
+    std::vector<_FrontierItem> * const frontier)
+{
+    // Same traversal as _merge_vectors.
+    for (_Node &node : *nodes) {
+        for (size_t i = 0; i < node.complete_nodes.size(); i++) {
+            current->complete_nodes[i].append(
+                std::move(node.complete_nodes[i]));
+        }
+        if (node.root) {
+            // The _Node has not been recursed yet.
+            current->node = std::move(node.root);
+            const size_t n = current->complete_nodes.size();
+            frontier->push_back(std::move(*current));
+            *current = { std::vector<CoverList>(n), nullptr };
+        }
+        _collect_frontier(&node.children, current, frontier);
+    }
+}
+
+bool
+SimsTreeMultiThreaded::_run_threads(std::vector<_Node> * const root_nodes)
+{
+    _frontier_memory = _tree_memory(*root_nodes);
+    _memory_grew();
+
     // Fill the queue.
-    _nodes = &root_nodes;
+    _nodes = root_nodes;
+    _node_index = 0;
+    _num_working_threads = 0;
+    _search_finished = false;
+    _recursion_stop_requested = false;
+    _checkpoint_requested = false;
 
     // Start the threads
     std::vector<std::thread> threads;
     threads.reserve(_num_threads);
     for (unsigned int i = 0; i < _num_threads; i++) {
-        threads.emplace_back(&SimsTreeMultiThreaded::_thread_worker, this);
+        threads.emplace_back(
+            &SimsTreeMultiThreaded::_thread_worker, this, i);
+    }
+
+    {
+        std::unique_lock<std::mutex> lk(_mutex);
+        while (true) {
+            // Wait until threads are finished or it is time to check
+            // whether the search should stop or the checkpoint is due.
+            std::chrono::steady_clock::time_point wake_up =
+                std::chrono::steady_clock::now() + _stop_check_period;
+            if (!_checkpoint_filename.empty()) {
+                wake_up = std::min(wake_up, _next_checkpoint);
+            }
+            if (_wake_up_threads.wait_until(
+                    lk, wake_up, [this]{ return _search_finished; })) {
+                break;
+            }
+            // Do not hold the lock while checking since _stop_due might
+            // call into python.
+            lk.unlock();
+            const bool stop = _stop_due() || _checkpoint_due();
+            lk.lock();
+            if (stop) {
+                if (_trace) {
+                    _trace->instant(_num_threads, "stop threads");
+                }
+                // Request threads to terminate.
+                _checkpoint_requested = true;
+                _wake_up_threads.notify_all();
+                break;
+            }
+        }
     }
 
     // Wait for all threads to finish.
@@ -201,10 +496,88 @@ SimsTreeMultiThreaded::_list()
         t.join();
     }
 
+    if (!_checkpoint_requested) {
+        return true;
+    }
+
+    if (_stopped && _checkpoint_filename.empty()) {
+        // The complete nodes found so far are still in the _Node's tree.
+        return true;
+    }
+
+    // Turn the _Node's tree into the frontier, write it and
+    // rebuild the _Node's from it to continue.
+    const size_t num_sets = _long_relator_sets.size();
+    std::vector<_FrontierItem> frontier;
+    _FrontierItem current{
+        std::vector<CoverList>(num_sets), nullptr };
+    _collect_frontier(root_nodes, &current, &frontier);
+    frontier.push_back(std::move(current));
+
+    if (_trace) {
+        _trace->begin(_num_threads, "checkpoint");
+    }
+    _write_checkpoint(frontier);
+    if (_trace) {
+        _trace->end(_num_threads);
+    }
+
+    std::vector<_Node> new_root_nodes;
+    for (_FrontierItem &item : frontier) {
+        new_root_nodes.emplace_back(
+            std::move(item.node), std::move(item.complete_nodes));
+    }
+    *root_nodes = std::move(new_root_nodes);
+
+    return _stopped;
+}
+
+std::vector<CoverList>
+SimsTreeMultiThreaded::_list()
+{
+    // The root _Node's - containing just a SimsNode without any edges
+    // unless we resume.
+    std::vector<_Node> root_nodes;
+    for (_FrontierItem &item : _initial_frontier()) {
+        root_nodes.emplace_back(
+            std::move(item.node), std::move(item.complete_nodes));
+    }
+
+    _segments.clear();
+    if (_result_writer) {
+        for (unsigned int i = 0; i < _num_threads; i++) {
+            _segments.push_back(_result_writer->add_segment());
+        }
+    }
+
+    if (!_trace_filename.empty()) {
+        std::vector<std::string> thread_names;
+        for (unsigned int i = 0; i < _num_threads; i++) {
+            thread_names.push_back("worker " + std::to_string(i));
+        }
+        thread_names.push_back("main");
+        _trace.reset(new ThreadTrace(thread_names));
+        _trace->begin(_num_threads, "list");
+    }
+
+    while (!_run_threads(&root_nodes)) {
+        // A checkpoint was written, run again.
+    }
+
+    if (_trace) {
+        _trace->end(_num_threads);
+        std::unique_ptr<ThreadTrace> trace = std::move(_trace);
+        trace->write(_trace_filename);
+    }
+
+    if (_result_writer) {
+        _collect_runs(root_nodes);
+    }
+
     // Traverse the _Node tree to find all complete covering
     // graphs.
-    std::vector<SimsNode> result;
-    _merge_vectors(root_nodes, &result);
+    std::vector<CoverList> result(_long_relator_sets.size());
+    _merge_vectors(&root_nodes, &result);
     return result;
 }
 
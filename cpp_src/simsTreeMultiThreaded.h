@@ -2,6 +2,7 @@
 #define LOW_INDEX_SIMS_TREE_MULTI_THREADED_H
 
 #include "simsTreeBase.h"
+#include "threadTrace.h"
 
 #include <atomic>
 #include <condition_variable>
@@ -28,8 +29,45 @@ public:
         const std::vector<Relator> &long_relators,
         unsigned int num_threads);
 
+    /// Use the given SimsNode as root instead of the SimsNode with no
+    /// edges, e.g., one of the nodes returned by SimsTreeBase::bloom.
+    ///
+    /// The rank and max_degree are taken from the root. The root needs to
+    /// support the short_relators, see AbstractSimsNode::num_relators.
+    /// If the root has edges, relators_may_lift must have been called
+    /// with the short_relators after adding them.
+    SimsTreeMultiThreaded(
+        const SimsNode &root,
+        const std::vector<Relator> &short_relators,
+        const std::vector<Relator> &long_relators,
+        unsigned int num_threads);
+
+    /// Limit the memory (in bytes) used for the parts of the search tree
+    /// that are materialized to distribute work between the threads.
+    /// This does not include the complete covering subgraphs found.
+    ///
+    /// When over budget, a thread does not hand out the remaining work of
+    /// its subtree when another thread runs out of work but keeps
+    /// recursing it. This bounds the memory but can leave threads idle.
+    /// The budget can be exceeded by the nodes handed out at once (the
+    /// unsearched siblings of the nodes on the path of the thread).
+    ///
+    /// 0 (the default) means no limit.
+    void set_memory_budget(size_t bytes);
+
+    /// Record what the worker threads do and write it to the given file
+    /// (in the Chrome trace event format, see ThreadTrace) when list()
+    /// (or a variant) finishes. Recorded are the subtrees recursed by each
+    /// thread, the waits for work, the requests to stop recursing (to
+    /// refill the queue) and the responses to them and the swaps of the
+    /// queue. The main thread records the checkpoints.
+    ///
+    /// An empty filename (the default) disables tracing.
+    void set_trace_file(const std::string &filename);
+
 protected:
-    std::vector<SimsNode> _list() override;
+    std::vector<CoverList> _list() override;
+    size_t _pending_memory() const override { return _frontier_memory; }
 
 private:
     /// Multi-threaded implementation
@@ -77,40 +115,148 @@ private:
     /// thread fills _Node::children and swaps the queue to point to it,
     /// resetting the index to zero.
 
+    /// The records segment_begin, ..., segment_begin + count - 1 of the
+    /// segment with index segment of _result_writer.
+    struct _Run
+    {
+        size_t segment;
+        size_t begin;
+        size_t count;
+    };
+
     /// A node in the collapsed search tree.
     class _Node {
     public:
-        _Node(const SimsNode &root)
-          : root(root)
+        _Node(const AbstractSimsNode &root,
+              const size_t num_long_relator_sets)
+          : root(new SimsNode(root))
+          , complete_nodes(num_long_relator_sets)
+          , segment(0)
+          , parent(nullptr)
+          , num_unfinished_children(0)
         { }
-        /// SimsNode to recurse.
-        const SimsNode root;
+        _Node(std::unique_ptr<SimsNode> root,
+              std::vector<CoverList> complete_nodes)
+          : root(std::move(root))
+          , complete_nodes(std::move(complete_nodes))
+          , segment(0)
+          , parent(nullptr)
+          , num_unfinished_children(0)
+        { }
+        /// SimsNode to recurse. Reset by _recurse so nullptr means
+        /// that the _Node has been recursed (or that there was nothing
+        /// to recurse in the first place).
+        std::unique_ptr<SimsNode> root;
 
-        /// Filled by _recurse with complete nodes.
-        std::vector<SimsNode> complete_nodes;
+        /// Filled by _recurse with complete nodes - one list for
+        /// each set in _long_relator_sets. Since only the thread recursing
+        /// this _Node writes to it, the slabs of the list are never
+        /// shared between threads.
+        ///
+        /// When resuming from a checkpoint, this is pre-filled with the
+        /// complete nodes coming before the ones from recursing root.
+        std::vector<CoverList> complete_nodes;
+        /// When list_to_file was called, _recurse writes the complete
+        /// nodes to the segment (with index segment) of the thread
+        /// instead. runs are the records written for this _Node followed
+        /// by those moved from its children by _finish_node.
+        size_t segment;
+        std::vector<_Run> runs;
         /// Filled by _recurse with nodes that still need to be
         /// recursed (if this thread was prompted to stop recursing).
         std::vector<_Node> children;
+        /// The _Node whose children this _Node is (nullptr for the
+        /// root _Node's).
+        _Node * parent;
+        /// Number of children that have not finished yet, see
+        /// _finish_node.
+        size_t num_unfinished_children;
     };
 
-    /// Recurse _Node::root and fill _Node::complete_nodes and
+    /// Recurse _Node::root and fill _Node::complete_nodes (or write
+    /// to the segment of the thread with the given index) and
     /// _Node::children.
     void _recurse(
-        _Node * node);
+        _Node * node,
+        unsigned int thread_index);
     void _recurse(
         const class StackedSimsNode &n,
-        _Node * result);
+        _Node * result,
+        SearchCounters * counters,
+        LeafSink * sink);
+
+    void _thread_worker(unsigned int thread_index);
+
+    /// Add a _Node for new_subgraph to the children of result.
+    void _add_child(const AbstractSimsNode &new_subgraph, _Node * result);
+
+    /// Called (with _mutex locked) when a _Node has been recursed and
+    /// all its children have finished. Collapses the parent if this was
+    /// its last unfinished child: the complete nodes (or runs) of its
+    /// children are moved to the parent (keeping the order) and the
+    /// children are freed.
+    /// Continues with the parent if it has finished now.
+    void _finish_node(_Node * node);
+
+    /// Memory of a _Node when its root has been recursed.
+    size_t _node_memory() const;
+    /// Memory of the SimsNode _Node::root.
+    size_t _root_memory() const;
+    /// Memory of all _Node's in the given tree.
+    size_t _tree_memory(const std::vector<_Node> &nodes) const;
+
+    /// Whether the materialized _Node's fit into the budget given to
+    /// set_memory_budget.
+    bool _within_memory_budget() const {
+        return _memory_budget == 0 || _frontier_memory < _memory_budget;
+    }
 
-    void _thread_worker();
+    /// Start threads and wait for them to finish (or, if a checkpoint
+    /// is due, stop them and write the checkpoint). Returns true if the
+    /// search is finished or was stopped (see SimsTreeBase::_stop_due).
+    bool _run_threads(std::vector<_Node> * root_nodes);
 
-    /// Collect all completed nodes from _Node's tree.
+    /// Collect all completed nodes from _Node's tree (moving them
+    /// into result).
     static void _merge_vectors(
-        const std::vector<_Node> &nodes,
-        std::vector<SimsNode> * result);
+        std::vector<_Node> * nodes,
+        std::vector<CoverList> * result);
+
+    /// Append run to runs, merging it with the last run if consecutive.
+    static void _append_run(const _Run &run, std::vector<_Run> * runs);
+
+    /// Add the runs of records written by _recurse to _result_writer
+    /// (in the same order as _merge_vectors).
+    void _collect_runs(const std::vector<_Node> &nodes);
+
+    /// Collect the frontier (see SimsTreeBase::_FrontierItem) from the
+    /// _Node's tree. current contains the complete nodes not yet added
+    /// to an item.
+    static void _collect_frontier(
+        std::vector<_Node> * nodes,
+        _FrontierItem * current,
+        std::vector<_FrontierItem> * frontier);
 
     /// Number of threads to use.
     const unsigned int _num_threads;
 
+    /// Set by set_memory_budget.
+    size_t _memory_budget;
+    /// Memory currently used by the _Node's, see _within_memory_budget.
+    std::atomic<size_t> _frontier_memory;
+    /// The queue after the _Node's it pointed to have been freed by
+    /// _finish_node.
+    std::vector<_Node> _no_nodes;
+
+    /// Set by set_trace_file.
+    std::string _trace_filename;
+    /// Only set while listing if set_trace_file was called. The main
+    /// thread records with index _num_threads.
+    std::unique_ptr<ThreadTrace> _trace;
+
+    /// One segment for each thread when list_to_file was called.
+    std::vector<ResultSegmentWriter*> _segments;
+
     /// Signal that there is new work on the queue or that no thread
     /// is recursing and threads should terminate.
     std::condition_variable _wake_up_threads;
@@ -118,8 +264,14 @@ private:
     /// fill work queue instead. Atomic so that only
     /// one thread will stop recursing anytime it has been raised.
     std::atomic_bool _recursion_stop_requested;
+    /// Flag to request all threads to stop recursing (adding all
+    /// nodes still requiring processing to _Node::children) and
+    /// terminate so that a checkpoint can be written or because the
+    /// search should stop.
+    std::atomic_bool _checkpoint_requested;
 
-    /// Mutex to protect _nodes, _node_index and _num_working_threads.
+    /// Mutex to protect _nodes, _node_index, _num_working_threads and
+    /// _search_finished.
     std::mutex _mutex;
 
     /// The current queue of _Node's.
@@ -128,6 +280,8 @@ private:
     size_t _node_index;
     /// The number of theads currently busy recursing a _Node.
     unsigned int _num_working_threads;
+    /// Set when the queue is empty and no thread is busy.
+    bool _search_finished;
 };
 
 } // Namespace low_index
@@ -38,7 +38,7 @@ StackedSimsNode::StackedSimsNode(
 }
 
 size_t
-SimsNodeStack::_compute_memory_size(const AbstractSimsNode &node)
+SimsNodeStack::memory_size(const AbstractSimsNode &node)
 {
     const StackedSimsNode::_MemoryLayout layout(node);
     // Enough memory for the initial node and the nested
@@ -49,9 +49,9 @@ SimsNodeStack::_compute_memory_size(const AbstractSimsNode &node)
 
 SimsNodeStack::SimsNodeStack(const AbstractSimsNode &node)
   // C++11:
-  : _memory(new uint8_t[_compute_memory_size(node)])
+  : _memory(new uint8_t[memory_size(node)])
   // C++14 and later:
-//: _memory(std::make_unique<uint8_t[]>(_compute_memory_size(node)))
+//: _memory(std::make_unique<uint8_t[]>(memory_size(node)))
   , _node(node, _memory.get())
 {
 }
@@ -24,8 +24,8 @@ namespace low_index {
 ///
 /// Because of the optimization, there are certain restrictions about how these
 /// nodes are allowed to be instantiated:
-///  1. There can be at most rank * max_degree (i.e., max number of edges)
-///     nested copies.
+///  1. There can be at most rank * max_degree + 1 (i.e., max number of
+///     edges plus one) nested copies.
 ///  2. The nested copies and SimsNodeStack need to be destroyed in the
 ///     opposite order they were created (enforced by compiler).
 ///  3. You cannot make more than one (non-nested) copy of a StackedSimsNode at
@@ -76,12 +76,12 @@ public:
         return _node;
     };
 
+    /// The memory allocated by a SimsNodeStack for the given node.
+    static size_t memory_size(const AbstractSimsNode &node);
+
 private:
     void * operator new(size_t size) = delete;
 
-    // Compute the memory needed to store data for enough StackedSimsNode's
-    static size_t _compute_memory_size(const AbstractSimsNode &node);
-
     // The memory used to store the data for the StackedSimsNode's
     std::unique_ptr<uint8_t[]> _memory;
     // The initial StackedSimsNode.
@@ -0,0 +1,25 @@
+#ifndef LOW_INDEX_SUBGROUP_COUNTS_H
+#define LOW_INDEX_SUBGROUP_COUNTS_H
+
+#include <cstdint>
+#include <vector>
+
+namespace low_index {
+
+/// The number of subgroups of each index found by a search, see
+/// SimsTreeBase::count.
+struct SubgroupCounts
+{
+    /// Number of conjugacy classes of subgroups of index d (that is, of
+    /// complete covering subgraphs of degree d returned by list()) at
+    /// index d - 1.
+    std::vector<uint64_t> conjugacy_classes;
+    /// Number of subgroups of index d at index d - 1, that is, the sum
+    /// of AbstractSimsNode::conjugacy_class_size over the complete
+    /// covering subgraphs of degree d.
+    std::vector<uint64_t> subgroups;
+};
+
+} // Namespace low_index
+
+#endif
@@ -0,0 +1,100 @@
+#include "threadTrace.h"
+
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+namespace low_index {
+
+ThreadTrace::ThreadTrace(const std::vector<std::string> &thread_names)
+  : _start(std::chrono::steady_clock::now())
+  , _threads(thread_names.size())
+{
+    for (size_t i = 0; i < thread_names.size(); i++) {
+        _threads[i].name = thread_names[i];
+        // Avoid reallocating while the search is running.
+        _threads[i].events.reserve(1 << 12);
+    }
+}
+
+void
+ThreadTrace::_record(
+    const unsigned int thread_index,
+    const char * const name,
+    const char phase,
+    const char * const arg_name,
+    const int64_t arg)
+{
+    const int64_t time =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - _start).count();
+    _threads[thread_index].events.push_back(
+        { name, phase, time, arg_name, arg });
+}
+
+// The names are string literals from the code or the thread names which
+// do not need escaping.
+static void
+_write_event(
+    std::ostream &out,
+    const size_t tid,
+    const char * const name,
+    const char phase,
+    const int64_t time,
+    const char * const arg_name,
+    const int64_t arg)
+{
+    char timestamp[32];
+    // Microseconds.
+    std::snprintf(timestamp, sizeof(timestamp), "%lld.%03lld",
+                  static_cast<long long>(time / 1000),
+                  static_cast<long long>(time % 1000));
+    out << ",\n{\"ph\":\"" << phase << "\",\"pid\":1,\"tid\":" << tid
+        << ",\"ts\":" << timestamp;
+    if (name) {
+        out << ",\"name\":\"" << name << "\"";
+    }
+    if (phase == 'i') {
+        // Scope of the instant event is the thread.
+        out << ",\"s\":\"t\"";
+    }
+    if (arg_name) {
+        out << ",\"args\":{\"" << arg_name << "\":" << arg << "}";
+    }
+    out << "}";
+}
+
+void
+ThreadTrace::write(const std::string &filename) const
+{
+    std::ofstream out(filename);
+    if (!out) {
+        throw std::runtime_error("Could not open " + filename);
+    }
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    out << "{\"ph\":\"M\",\"pid\":1,\"name\":\"process_name\","
+        << "\"args\":{\"name\":\"low_index\"}}";
+    for (size_t i = 0; i < _threads.size(); i++) {
+        out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+            << ",\"name\":\"thread_name\",\"args\":{\"name\":\""
+            << _threads[i].name << "\"}}";
+        // Show the threads in order.
+        out << ",\n{\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+            << ",\"name\":\"thread_sort_index\",\"args\":{\"sort_index\":"
+            << i << "}}";
+    }
+    for (size_t i = 0; i < _threads.size(); i++) {
+        for (const _Event &event : _threads[i].events) {
+            _write_event(out, i, event.name, event.phase, event.time,
+                         event.arg_name, event.arg);
+        }
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Could not write " + filename);
+    }
+}
+
+} // Namespace low_index
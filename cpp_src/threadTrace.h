@@ -0,0 +1,81 @@
+#ifndef LOW_INDEX_THREAD_TRACE_H
+#define LOW_INDEX_THREAD_TRACE_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace low_index {
+
+/// Records timestamped events of several threads and writes them in the
+/// Chrome trace event format, see SimsTreeMultiThreaded::set_trace_file.
+/// The file can be opened in chrome://tracing or https://ui.perfetto.dev.
+///
+/// Each thread records into its own buffer (given by the thread index),
+/// so no locking is needed. The names passed to the methods must be
+/// string literals (or otherwise outlive the ThreadTrace).
+class ThreadTrace
+{
+public:
+    /// thread_names gives the number of threads and their names in the
+    /// trace.
+    ThreadTrace(const std::vector<std::string> &thread_names);
+
+    /// Begin a duration event. Events of a thread have to be nested.
+    void begin(unsigned int thread_index,
+               const char * name,
+               const char * arg_name = nullptr,
+               int64_t arg = 0) {
+        _record(thread_index, name, 'B', arg_name, arg);
+    }
+
+    /// End the last duration event begun by the thread.
+    void end(unsigned int thread_index) {
+        _record(thread_index, nullptr, 'E', nullptr, 0);
+    }
+
+    /// Record an instant event.
+    void instant(unsigned int thread_index,
+                 const char * name,
+                 const char * arg_name = nullptr,
+                 int64_t arg = 0) {
+        _record(thread_index, name, 'i', arg_name, arg);
+    }
+
+    /// Write the events recorded so far as JSON. Must not be called while
+    /// threads are recording events.
+    void write(const std::string &filename) const;
+
+private:
+    struct _Event
+    {
+        const char * name;
+        char phase;
+        // Nanoseconds since the ThreadTrace was created.
+        int64_t time;
+        const char * arg_name;
+        int64_t arg;
+    };
+
+    struct _Thread
+    {
+        std::string name;
+        std::vector<_Event> events;
+        // Avoid false sharing with the buffers of other threads.
+        char padding[64];
+    };
+
+    void _record(unsigned int thread_index,
+                 const char * name,
+                 char phase,
+                 const char * arg_name,
+                 int64_t arg);
+
+    const std::chrono::steady_clock::time_point _start;
+    std::vector<_Thread> _threads;
+};
+
+} // Namespace low_index
+
+#endif
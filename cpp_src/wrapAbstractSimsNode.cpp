@@ -13,10 +13,23 @@ void addAbstractSimsNode(pybind11::module_ &m) {
                     DOC(low_index, AbstractSimsNode))
         .def("relators_lift", &AbstractSimsNode::relators_lift,
              DOC(low_index, AbstractSimsNode, relators_lift))
-        .def("relators_may_lift", &AbstractSimsNode::relators_may_lift,
+        .def("relators_may_lift",
+             [](AbstractSimsNode &node,
+                const std::vector<Relator> &relators,
+                const std::pair<LetterType, DegreeType> slot,
+                const DegreeType target) {
+                 // The node might have been unpickled.
+                 node.check_lift_state(relators);
+                 return node.relators_may_lift(relators, slot, target);
+             },
              DOC(low_index, AbstractSimsNode, relators_may_lift))
+        .def("check_lift_state", &AbstractSimsNode::check_lift_state,
+             DOC(low_index, AbstractSimsNode, check_lift_state))
         .def("may_be_minimal", &AbstractSimsNode::may_be_minimal,
              DOC(low_index, AbstractSimsNode, may_be_minimal))
+        .def("conjugacy_class_size",
+             &AbstractSimsNode::conjugacy_class_size,
+             DOC(low_index, AbstractSimsNode, conjugacy_class_size))
         .def_property_readonly("num_relators", &AbstractSimsNode::num_relators,
                                DOC(low_index, AbstractSimsNode, num_relators));
 }
@@ -5,9 +5,20 @@
 #include "wrapModule.cpp"
 #include "wrapCoveringSubgraph.cpp"
 #include "wrapAbstractSimsNode.cpp"
+#include "wrapKernels.cpp"
 #include "wrapSimsNode.cpp"
+#include "wrapSearchStatistics.cpp"
+#include "wrapMemoryUsage.cpp"
+#include "wrapSubgroupCounts.cpp"
+#include "wrapSampling.cpp"
+#include "wrapCancellation.cpp"
 #include "wrapSimsTreeBase.cpp"
 #include "wrapSimsTree.cpp"
 #include "wrapSimsTreeMultiThreaded.cpp"
 #include "wrapLowIndex.cpp"
 #include "wrapWords.cpp"
+#include "wrapCoverStore.cpp"
+#include "wrapCoverList.cpp"
+#include "wrapPermutationRepSet.cpp"
+#include "wrapResultFile.cpp"
+#include "wrapDeltaStream.cpp"
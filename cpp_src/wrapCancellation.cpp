@@ -0,0 +1,54 @@
+#include "cancellation.h"
+#include "docCancellation.h"
+
+#include "pybind11/pybind11.h"
+
+#include <memory>
+
+namespace low_index {
+
+// Installed with set_interrupt_check. Called from the thread running the
+// search (which released the GIL).
+static
+bool
+_python_interrupt_check()
+{
+    pybind11::gil_scoped_acquire gil;
+    if (PyErr_CheckSignals() == 0) {
+        return false;
+    }
+    // The search stops and throws SearchInterrupted, which is turned into
+    // KeyboardInterrupt again (or, if the caller set a cancellation token,
+    // returns what it found so far). So do not leave the exception raised
+    // by the signal handler pending.
+    PyErr_Clear();
+    return true;
+}
+
+void addCancellation(pybind11::module_ &m) {
+    pybind11::class_<CancellationToken, std::shared_ptr<CancellationToken>>(
+            m, "CancellationToken", DOC(low_index, CancellationToken))
+        .def(pybind11::init<>())
+        .def("cancel", &CancellationToken::cancel,
+             DOC(low_index, CancellationToken, cancel))
+        .def("set_deadline", &CancellationToken::set_deadline,
+             pybind11::arg("seconds"),
+             DOC(low_index, CancellationToken, set_deadline))
+        .def("is_cancelled", &CancellationToken::is_cancelled,
+             DOC(low_index, CancellationToken, is_cancelled));
+
+    pybind11::register_exception_translator(
+        [](std::exception_ptr p) {
+            try {
+                if (p) {
+                    std::rethrow_exception(p);
+                }
+            } catch (const SearchInterrupted &) {
+                PyErr_SetNone(PyExc_KeyboardInterrupt);
+            }
+        });
+
+    set_interrupt_check(&_python_interrupt_check);
+}
+
+} // Namespace low_index
@@ -0,0 +1,52 @@
+#include "coverList.h"
+#include "docCoverList.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+// Support negative indices like a python list.
+static
+size_t
+_cover_list_index(const CoverList &covers, pybind11::ssize_t i)
+{
+    if (i < 0) {
+        i += covers.size();
+    }
+    if (i < 0 || static_cast<size_t>(i) >= covers.size()) {
+        throw pybind11::index_error();
+    }
+    return i;
+}
+
+void addCoverList(pybind11::module_ &m) {
+    pybind11::class_<CoverList>(m, "CoverList", DOC(low_index, CoverList))
+        .def_property_readonly("rank", &CoverList::rank,
+                               DOC(low_index, CoverList, rank))
+        .def_property_readonly("max_degree", &CoverList::max_degree,
+                               DOC(low_index, CoverList, max_degree))
+        .def("__len__", &CoverList::size,
+             DOC(low_index, CoverList, size))
+        .def("__getitem__",
+             [](const CoverList &covers, pybind11::ssize_t i) {
+                 return covers.cover(_cover_list_index(covers, i)); },
+             pybind11::arg("i"),
+             DOC(low_index, CoverList, cover))
+        .def("degree",
+             [](const CoverList &covers, pybind11::ssize_t i) {
+                 return covers.degree(_cover_list_index(covers, i)); },
+             pybind11::arg("i"),
+             DOC(low_index, CoverList, degree))
+        .def("permutation_rep",
+             [](const CoverList &covers, pybind11::ssize_t i) {
+                 return covers.permutation_rep(
+                     _cover_list_index(covers, i)); },
+             pybind11::arg("i"),
+             DOC(low_index, CoverList, permutation_rep))
+        .def("to_sims_nodes", &CoverList::to_sims_nodes,
+             DOC(low_index, CoverList, to_sims_nodes));
+}
+
+} // Namespace low_index
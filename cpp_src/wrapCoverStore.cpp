@@ -0,0 +1,68 @@
+#include "coverStore.h"
+#include "resultFile.h"
+#include "docCoverStore.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addCoverStore(pybind11::module_ &m) {
+    {
+        using NodesSignature = void(*)(
+            const std::string &, RankType, DegreeType,
+            const std::vector<SimsNode> &);
+        using ResultFileSignature = void(*)(
+            const std::string &, const ResultFile &);
+
+        m.def("write_cover_store",
+              NodesSignature(&write_cover_store),
+              pybind11::arg("filename"),
+              pybind11::arg("rank"),
+              pybind11::arg("max_degree"),
+              pybind11::arg("nodes"),
+              DOC(low_index, write_cover_store));
+        m.def("write_cover_store",
+              ResultFileSignature(&write_cover_store),
+              pybind11::arg("filename"),
+              pybind11::arg("results"),
+              pybind11::call_guard<pybind11::gil_scoped_release>(),
+              DOC(low_index, write_cover_store_2));
+    }
+
+    {
+        using RelatorsSignature = std::vector<SimsNode>(CoverStore::*)(
+            const std::vector<Relator> &, unsigned int) const;
+        using WordsSignature = std::vector<SimsNode>(CoverStore::*)(
+            const std::vector<std::string> &, unsigned int) const;
+
+        pybind11::class_<CoverStore>(m, "CoverStore",
+                                     DOC(low_index, CoverStore))
+            .def(pybind11::init<const std::string &>(),
+                 pybind11::arg("filename"),
+                 DOC(low_index, CoverStore, CoverStore))
+            .def_property_readonly("rank", &CoverStore::rank,
+                                   DOC(low_index, CoverStore, rank))
+            .def_property_readonly("max_degree", &CoverStore::max_degree,
+                                   DOC(low_index, CoverStore, max_degree))
+            .def("__len__", &CoverStore::size,
+                 DOC(low_index, CoverStore, size))
+            .def("num_covers", &CoverStore::num_covers,
+                 pybind11::arg("degree"),
+                 DOC(low_index, CoverStore, num_covers))
+            .def("cover", &CoverStore::cover,
+                 pybind11::arg("i"),
+                 DOC(low_index, CoverStore, cover))
+            .def("query", RelatorsSignature(&CoverStore::query),
+                 pybind11::arg("long_relators"),
+                 pybind11::arg("num_threads") = 0,
+                 DOC(low_index, CoverStore, query))
+            .def("query", WordsSignature(&CoverStore::query),
+                 pybind11::arg("long_relators"),
+                 pybind11::arg("num_threads") = 0,
+                 DOC(low_index, CoverStore, query_2));
+    }
+}
+
+} // Namespace low_index
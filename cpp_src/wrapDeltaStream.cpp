@@ -0,0 +1,52 @@
+#include "deltaStream.h"
+#include "docDeltaStream.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addDeltaStream(pybind11::module_ &m) {
+    using WriteSignature = void (DeltaStreamWriter::*)(const CoveringSubgraph &);
+
+    pybind11::class_<DeltaStreamWriter>(m, "DeltaStreamWriter",
+                                        DOC(low_index, DeltaStreamWriter))
+        .def(pybind11::init<const std::string &, RankType, DegreeType>(),
+             pybind11::arg("filename"),
+             pybind11::arg("rank"),
+             pybind11::arg("max_degree"),
+             DOC(low_index, DeltaStreamWriter, DeltaStreamWriter))
+        .def("write", WriteSignature(&DeltaStreamWriter::write),
+             pybind11::arg("node"),
+             DOC(low_index, DeltaStreamWriter, write))
+        .def("close", &DeltaStreamWriter::close,
+             DOC(low_index, DeltaStreamWriter, close))
+        .def("__len__", &DeltaStreamWriter::size,
+             DOC(low_index, DeltaStreamWriter, size));
+
+    pybind11::class_<DeltaStream>(m, "DeltaStream",
+                                  DOC(low_index, DeltaStream))
+        .def(pybind11::init<const std::string &>(),
+             pybind11::arg("filename"),
+             DOC(low_index, DeltaStream, DeltaStream))
+        .def_property_readonly("rank", &DeltaStream::rank,
+                               DOC(low_index, DeltaStream, rank))
+        .def_property_readonly("max_degree", &DeltaStream::max_degree,
+                               DOC(low_index, DeltaStream, max_degree))
+        .def("__len__", &DeltaStream::size,
+             DOC(low_index, DeltaStream, size))
+        .def("__iter__", [](DeltaStream &s) -> DeltaStream & {
+                s.rewind();
+                return s; },
+             pybind11::return_value_policy::reference_internal,
+             DOC(low_index, DeltaStream, rewind))
+        .def("__next__", [](DeltaStream &s) {
+                if (!s.next()) {
+                    throw pybind11::stop_iteration();
+                }
+                return s.cover(); },
+             DOC(low_index, DeltaStream, next));
+}
+
+} // Namespace low_index
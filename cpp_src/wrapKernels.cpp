@@ -0,0 +1,25 @@
+#include "kernels.h"
+#include "docKernels.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addKernels(pybind11::module_ &m) {
+    m.def("kernel_variant",
+          &kernel_variant,
+          DOC(low_index, kernel_variant));
+
+    m.def("kernel_variants",
+          &kernel_variants,
+          DOC(low_index, kernel_variants));
+
+    m.def("set_kernel_variant",
+          &set_kernel_variant,
+          pybind11::arg("name"),
+          DOC(low_index, set_kernel_variant));
+}
+
+} // Namespace low_index
@@ -6,51 +6,591 @@
 
 #include "pybind11/stl.h"
 
+#include <memory>
+
 namespace low_index {
 
+// The module functions are wrapped without the token, deadline and
+// is_complete arguments, so they throw SearchInterrupted if the search was
+// interrupted (see set_interrupt_check). The _partial variants take a
+// token and deadline instead and always also return is_complete.
+
+template<typename Word>
+static
+std::vector<std::vector<std::vector<DegreeType>>>
+_permutation_reps(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const unsigned int shard_index,
+    const unsigned int num_shards)
+{
+    return permutation_reps(
+        rank, short_relators, long_relators, max_degree, strategy, num_threads,
+        shard_index, num_shards);
+}
+
+template<typename Word>
+static
+std::pair<std::vector<std::vector<std::vector<DegreeType>>>, bool>
+_permutation_reps_partial(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const unsigned int shard_index,
+    const unsigned int num_shards,
+    const std::shared_ptr<CancellationToken> &token,
+    const double deadline)
+{
+    bool is_complete = false;
+    std::vector<std::vector<std::vector<DegreeType>>> result =
+        permutation_reps(
+            rank, short_relators, long_relators, max_degree, strategy,
+            num_threads, shard_index, num_shards,
+            token, deadline, &is_complete);
+    return { std::move(result), is_complete };
+}
+
+template<typename Word>
+static
+PermutationRepSet
+_permutation_rep_set(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads)
+{
+    return permutation_rep_set(
+        rank, short_relators, long_relators, max_degree, strategy,
+        num_threads);
+}
+
+template<typename Word>
+static
+std::pair<PermutationRepSet, bool>
+_permutation_rep_set_partial(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const std::shared_ptr<CancellationToken> &token,
+    const double deadline)
+{
+    bool is_complete = false;
+    PermutationRepSet result = permutation_rep_set(
+        rank, short_relators, long_relators, max_degree, strategy, num_threads,
+        token, deadline, &is_complete);
+    return { std::move(result), is_complete };
+}
+
+template<typename Word>
+static
+std::vector<std::vector<std::vector<std::vector<DegreeType>>>>
+_permutation_reps_batched(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const std::vector<std::vector<Word>> &long_relator_sets,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads)
+{
+    return permutation_reps_batched(
+        rank, short_relators, long_relators, long_relator_sets, max_degree,
+        strategy, num_threads);
+}
+
+template<typename Word>
+static
+std::pair<std::vector<std::vector<std::vector<std::vector<DegreeType>>>>, bool>
+_permutation_reps_batched_partial(
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const std::vector<std::vector<Word>> &long_relator_sets,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const std::shared_ptr<CancellationToken> &token,
+    const double deadline)
+{
+    bool is_complete = false;
+    std::vector<std::vector<std::vector<std::vector<DegreeType>>>> result =
+        permutation_reps_batched(
+            rank, short_relators, long_relators, long_relator_sets, max_degree,
+            strategy, num_threads,
+            token, deadline, &is_complete);
+    return { std::move(result), is_complete };
+}
+
+template<typename Word>
+static
+void
+_create_cover_store(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads)
+{
+    create_cover_store(
+        filename, rank, short_relators, max_degree, strategy, num_threads);
+}
+
+template<typename Word>
+static
+bool
+_create_cover_store_partial(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const std::shared_ptr<CancellationToken> &token,
+    const double deadline)
+{
+    bool is_complete = false;
+    create_cover_store(
+        filename, rank, short_relators, max_degree, strategy, num_threads,
+        token, deadline, &is_complete);
+    return is_complete;
+}
+
+template<typename Word>
+static
+size_t
+_create_result_file(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const bool delta_compressed)
+{
+    return create_result_file(
+        filename, rank, short_relators, long_relators, max_degree, strategy,
+        num_threads, delta_compressed);
+}
+
+template<typename Word>
+static
+std::pair<size_t, bool>
+_create_result_file_partial(
+    const std::string &filename,
+    const RankType rank,
+    const std::vector<Word> &short_relators,
+    const std::vector<Word> &long_relators,
+    const DegreeType max_degree,
+    const std::string &strategy,
+    const unsigned int num_threads,
+    const bool delta_compressed,
+    const std::shared_ptr<CancellationToken> &token,
+    const double deadline)
+{
+    bool is_complete = false;
+    size_t result = create_result_file(
+        filename, rank, short_relators, long_relators, max_degree, strategy,
+        num_threads, delta_compressed,
+        token, deadline, &is_complete);
+    return { std::move(result), is_complete };
+}
+
+static const char * const _partial_doc =
+R"doc(A variant of the function without _partial that additionally takes a
+CancellationToken and/or a deadline in seconds (ignored unless positive)
+to stop the search early.
+
+Returns a pair of the result and whether the search finished (see
+SimsTreeBase.is_complete). If the search was stopped early (or
+interrupted by Ctrl-C with a token given), the result contains what was
+found so far. create_cover_store_partial has no result and only returns
+whether the search finished.)doc";
+
 void addLowIndex(pybind11::module_ &m) {
+    // Release the GIL while searching so that the search can be
+    // interrupted, see set_interrupt_check.
+    using ReleaseGIL = pybind11::call_guard<pybind11::gil_scoped_release>;
 
     m.attr("spin_short_strategy") = spin_short_strategy;
 
+    m.def("permutation_reps",
+          &_permutation_reps<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("shard_index") = 0,
+          pybind11::arg("num_shards") = 1,
+          ReleaseGIL(),
+          DOC(low_index, permutation_reps));
+
+    m.def("permutation_reps_partial",
+          &_permutation_reps_partial<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("shard_index") = 0,
+          pybind11::arg("num_shards") = 1,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("permutation_reps",
+          &_permutation_reps<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("shard_index") = 0,
+          pybind11::arg("num_shards") = 1,
+          ReleaseGIL(),
+          DOC(low_index, permutation_reps_2));
+
+    m.def("permutation_reps_partial",
+          &_permutation_reps_partial<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("shard_index") = 0,
+          pybind11::arg("num_shards") = 1,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
     {
-        using Signature = std::vector<std::vector<std::vector<DegreeType>>>(*)(
+        using Signature = TreeSizeEstimate(*)(
             RankType,
             const std::vector<Relator> &,
             const std::vector<Relator> &,
             DegreeType,
+            size_t,
             const std::string &,
-            unsigned int num_threads);
+            unsigned int num_threads,
+            uint64_t seed);
 
-        m.def("permutation_reps",
-              Signature(&permutation_reps),
+        m.def("estimate_tree_size",
+              Signature(&estimate_tree_size),
               pybind11::arg("rank"),
               pybind11::arg("short_relators"),
               pybind11::arg("long_relators"),
               pybind11::arg("max_degree"),
+              pybind11::arg("num_probes"),
               pybind11::arg("strategy") = spin_short_strategy,
               pybind11::arg("num_threads") = 0,
-              DOC(low_index, permutation_reps));
+              pybind11::arg("seed") = 0,
+              ReleaseGIL(),
+              DOC(low_index, estimate_tree_size));
     }
 
     {
-        using Signature = std::vector<std::vector<std::vector<DegreeType>>>(*)(
+        using Signature = TreeSizeEstimate(*)(
             RankType,
             const std::vector<std::string> &,
             const std::vector<std::string> &,
             DegreeType,
+            size_t,
             const std::string &,
-            unsigned int num_threads);
+            unsigned int num_threads,
+            uint64_t seed);
 
-        m.def("permutation_reps",
-              Signature(&permutation_reps),
+        m.def("estimate_tree_size",
+              Signature(&estimate_tree_size),
               pybind11::arg("rank"),
               pybind11::arg("short_relators"),
               pybind11::arg("long_relators"),
               pybind11::arg("max_degree"),
+              pybind11::arg("num_probes"),
               pybind11::arg("strategy") = spin_short_strategy,
               pybind11::arg("num_threads") = 0,
-              DOC(low_index, permutation_reps_2));
+              pybind11::arg("seed") = 0,
+              ReleaseGIL(),
+              DOC(low_index, estimate_tree_size_2));
     }
+
+    {
+        using Signature = CoverSample(*)(
+            RankType,
+            const std::vector<Relator> &,
+            const std::vector<Relator> &,
+            DegreeType,
+            size_t,
+            const std::string &,
+            unsigned int num_threads,
+            uint64_t seed);
+
+        m.def("sample_covers",
+              Signature(&sample_covers),
+              pybind11::arg("rank"),
+              pybind11::arg("short_relators"),
+              pybind11::arg("long_relators"),
+              pybind11::arg("max_degree"),
+              pybind11::arg("num_samples"),
+              pybind11::arg("strategy") = spin_short_strategy,
+              pybind11::arg("num_threads") = 0,
+              pybind11::arg("seed") = 0,
+              ReleaseGIL(),
+              DOC(low_index, sample_covers));
+    }
+
+    {
+        using Signature = CoverSample(*)(
+            RankType,
+            const std::vector<std::string> &,
+            const std::vector<std::string> &,
+            DegreeType,
+            size_t,
+            const std::string &,
+            unsigned int num_threads,
+            uint64_t seed);
+
+        m.def("sample_covers",
+              Signature(&sample_covers),
+              pybind11::arg("rank"),
+              pybind11::arg("short_relators"),
+              pybind11::arg("long_relators"),
+              pybind11::arg("max_degree"),
+              pybind11::arg("num_samples"),
+              pybind11::arg("strategy") = spin_short_strategy,
+              pybind11::arg("num_threads") = 0,
+              pybind11::arg("seed") = 0,
+              ReleaseGIL(),
+              DOC(low_index, sample_covers_2));
+    }
+
+    m.def("permutation_rep_set",
+          &_permutation_rep_set<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, permutation_rep_set));
+
+    m.def("permutation_rep_set_partial",
+          &_permutation_rep_set_partial<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("permutation_rep_set",
+          &_permutation_rep_set<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, permutation_rep_set_2));
+
+    m.def("permutation_rep_set_partial",
+          &_permutation_rep_set_partial<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("merge_permutation_reps",
+          &merge_permutation_reps,
+          pybind11::arg("shards"),
+          DOC(low_index, merge_permutation_reps));
+
+    m.def("permutation_reps_batched",
+          &_permutation_reps_batched<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("long_relator_sets"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, permutation_reps_batched));
+
+    m.def("permutation_reps_batched_partial",
+          &_permutation_reps_batched_partial<Relator>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("long_relator_sets"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("permutation_reps_batched",
+          &_permutation_reps_batched<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("long_relator_sets"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, permutation_reps_batched_2));
+
+    m.def("permutation_reps_batched_partial",
+          &_permutation_reps_batched_partial<std::string>,
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("long_relator_sets"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("create_cover_store",
+          &_create_cover_store<Relator>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, create_cover_store));
+
+    m.def("create_cover_store_partial",
+          &_create_cover_store_partial<Relator>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("create_cover_store",
+          &_create_cover_store<std::string>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          ReleaseGIL(),
+          DOC(low_index, create_cover_store_2));
+
+    m.def("create_cover_store_partial",
+          &_create_cover_store_partial<std::string>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("create_result_file",
+          &_create_result_file<Relator>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("delta_compressed") = false,
+          ReleaseGIL(),
+          DOC(low_index, create_result_file));
+
+    m.def("create_result_file_partial",
+          &_create_result_file_partial<Relator>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("delta_compressed") = false,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
+
+    m.def("create_result_file",
+          &_create_result_file<std::string>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("delta_compressed") = false,
+          ReleaseGIL(),
+          DOC(low_index, create_result_file_2));
+
+    m.def("create_result_file_partial",
+          &_create_result_file_partial<std::string>,
+          pybind11::arg("filename"),
+          pybind11::arg("rank"),
+          pybind11::arg("short_relators"),
+          pybind11::arg("long_relators"),
+          pybind11::arg("max_degree"),
+          pybind11::arg("strategy") = spin_short_strategy,
+          pybind11::arg("num_threads") = 0,
+          pybind11::arg("delta_compressed") = false,
+          pybind11::arg("token") = nullptr,
+          pybind11::arg("deadline") = 0.0,
+          ReleaseGIL(),
+          _partial_doc);
 }
 
 }
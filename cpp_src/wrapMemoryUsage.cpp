@@ -0,0 +1,31 @@
+#include "memoryUsage.h"
+#include "docMemoryUsage.h"
+
+#include "pybind11/pybind11.h"
+
+namespace low_index {
+
+void addMemoryUsage(pybind11::module_ &m) {
+    pybind11::class_<MemoryUsage>(
+            m, "MemoryUsage", DOC(low_index, MemoryUsage))
+        .def_readonly("stack_frames", &MemoryUsage::stack_frames,
+                      DOC(low_index, MemoryUsage, stack_frames))
+        .def_readonly("pending_nodes", &MemoryUsage::pending_nodes,
+                      DOC(low_index, MemoryUsage, pending_nodes))
+        .def_readonly("complete_nodes", &MemoryUsage::complete_nodes,
+                      DOC(low_index, MemoryUsage, complete_nodes))
+        .def_readonly("relators", &MemoryUsage::relators,
+                      DOC(low_index, MemoryUsage, relators))
+        .def_readonly("total", &MemoryUsage::total,
+                      DOC(low_index, MemoryUsage, total))
+        .def_readonly("peak", &MemoryUsage::peak,
+                      DOC(low_index, MemoryUsage, peak));
+
+    // A MemoryError so that existing handlers for running out of memory
+    // also catch it.
+    pybind11::register_exception<MemoryLimitExceeded>(
+        m, "MemoryLimitExceeded", PyExc_MemoryError).attr("__doc__") =
+            DOC(low_index, MemoryLimitExceeded);
+}
+
+} // Namespace low_index
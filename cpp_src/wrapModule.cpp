@@ -8,10 +8,21 @@ void addLowIndex(pybind11::module_ &m);
 void addWords(pybind11::module_ &m);
 void addCoveringSubgraph(pybind11::module_ &m);
 void addAbstractSimsNode(pybind11::module_ &m);
+void addKernels(pybind11::module_ &m);
 void addSimsNode(pybind11::module_ &m);
+void addSearchStatistics(pybind11::module_ &m);
+void addMemoryUsage(pybind11::module_ &m);
+void addSubgroupCounts(pybind11::module_ &m);
+void addSampling(pybind11::module_ &m);
+void addCancellation(pybind11::module_ &m);
 void addSimsTreeBase(pybind11::module_ &m);
 void addSimsTree(pybind11::module_ &m);
 void addSimsTreeMultiThreaded(pybind11::module_ &m);
+void addCoverStore(pybind11::module_ &m);
+void addCoverList(pybind11::module_ &m);
+void addPermutationRepSet(pybind11::module_ &m);
+void addResultFile(pybind11::module_ &m);
+void addDeltaStream(pybind11::module_ &m);
 
 }
 
@@ -29,10 +40,21 @@ A module to enumerate low-index subgroups.
     addWords(m);
     addCoveringSubgraph(m);
     addAbstractSimsNode(m);
+    addKernels(m);
     addSimsNode(m);
+    addSearchStatistics(m);
+    addMemoryUsage(m);
+    addSubgroupCounts(m);
+    addSampling(m);
+    addCancellation(m);
     addSimsTreeBase(m);
     addSimsTree(m);
     addSimsTreeMultiThreaded(m);
+    addCoverStore(m);
+    addCoverList(m);
+    addPermutationRepSet(m);
+    addResultFile(m);
+    addDeltaStream(m);
 
     m.def("hardware_concurrency",
           &std::thread::hardware_concurrency,
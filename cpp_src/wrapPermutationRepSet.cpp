@@ -0,0 +1,91 @@
+#include "permutationRepSet.h"
+#include "docPermutationRepSet.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+#include <memory>
+
+namespace low_index {
+
+// The permutation representations of one degree of a PermutationRepSet
+// exposed as num_reps x rank x degree array through python's buffer
+// protocol. Keeps the PermutationRepSet alive.
+class _PermutationRepArray
+{
+public:
+    std::shared_ptr<const PermutationRepSet> reps;
+    DegreeType degree;
+};
+
+void addPermutationRepSet(pybind11::module_ &m) {
+    pybind11::class_<_PermutationRepArray>(
+            m, "_PermutationRepArray", pybind11::buffer_protocol())
+        .def_buffer([](const _PermutationRepArray &a) {
+            const pybind11::ssize_t rank = a.reps->rank();
+            const pybind11::ssize_t d = a.degree;
+            return pybind11::buffer_info(
+                const_cast<DegreeType*>(a.reps->data(a.degree)),
+                sizeof(DegreeType),
+                pybind11::format_descriptor<DegreeType>::format(),
+                3,
+                { static_cast<pybind11::ssize_t>(
+                      a.reps->num_reps(a.degree)), rank, d },
+                { rank * d * static_cast<pybind11::ssize_t>(
+                      sizeof(DegreeType)),
+                  d * static_cast<pybind11::ssize_t>(sizeof(DegreeType)),
+                  static_cast<pybind11::ssize_t>(sizeof(DegreeType)) },
+                /* readonly = */ true); });
+
+    pybind11::class_<PermutationRepSet, std::shared_ptr<PermutationRepSet>>(
+            m, "PermutationRepSet", DOC(low_index, PermutationRepSet))
+        .def(pybind11::init<RankType,
+                            DegreeType,
+                            const std::vector<SimsNode> &>(),
+             pybind11::arg("rank"),
+             pybind11::arg("max_degree"),
+             pybind11::arg("nodes"),
+             DOC(low_index, PermutationRepSet, PermutationRepSet))
+        .def(pybind11::init<RankType,
+                            DegreeType,
+                            const CoverList &>(),
+             pybind11::arg("rank"),
+             pybind11::arg("max_degree"),
+             pybind11::arg("covers"),
+             DOC(low_index, PermutationRepSet, PermutationRepSet_2))
+        .def_property_readonly("rank", &PermutationRepSet::rank,
+                               DOC(low_index, PermutationRepSet, rank))
+        .def_property_readonly("max_degree", &PermutationRepSet::max_degree,
+                               DOC(low_index, PermutationRepSet, max_degree))
+        .def("__len__", &PermutationRepSet::size,
+             DOC(low_index, PermutationRepSet, size))
+        .def("__getitem__",
+             [](const PermutationRepSet &reps, pybind11::ssize_t i) {
+                 // Support negative indices like a python list.
+                 if (i < 0) {
+                     i += reps.size();
+                 }
+                 if (i < 0) {
+                     throw pybind11::index_error();
+                 }
+                 return reps.permutation_rep(i); },
+             pybind11::arg("i"),
+             DOC(low_index, PermutationRepSet, permutation_rep))
+        .def("degree", &PermutationRepSet::degree,
+             pybind11::arg("i"),
+             DOC(low_index, PermutationRepSet, degree))
+        .def("num_reps", &PermutationRepSet::num_reps,
+             pybind11::arg("degree"),
+             DOC(low_index, PermutationRepSet, num_reps))
+        .def("array",
+             [](const std::shared_ptr<PermutationRepSet> &reps,
+                const DegreeType degree) {
+                 // Raise exception early for a bad degree.
+                 reps->data(degree);
+                 return _PermutationRepArray{ reps, degree }; },
+             pybind11::arg("degree"),
+             DOC(low_index, PermutationRepSet, data));
+}
+
+} // Namespace low_index
@@ -0,0 +1,68 @@
+#include "resultFile.h"
+#include "docResultFile.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+#include <memory>
+
+namespace low_index {
+
+// The records of one extent of a ResultFile exposed as
+// num_records x record_size array through python's buffer protocol.
+// Keeps the ResultFile alive.
+class _ResultFileExtent
+{
+public:
+    std::shared_ptr<const ResultFile> file;
+    size_t index;
+};
+
+void addResultFile(pybind11::module_ &m) {
+    pybind11::class_<_ResultFileExtent>(
+            m, "_ResultFileExtent", pybind11::buffer_protocol())
+        .def_buffer([](const _ResultFileExtent &e) {
+            const pybind11::ssize_t record_size = e.file->record_size();
+            return pybind11::buffer_info(
+                const_cast<uint8_t*>(e.file->extent_records(e.index)),
+                { static_cast<pybind11::ssize_t>(
+                      e.file->extent_size(e.index)), record_size },
+                { record_size, static_cast<pybind11::ssize_t>(1) },
+                /* readonly = */ true); });
+
+    pybind11::class_<ResultFile, std::shared_ptr<ResultFile>>(
+            m, "ResultFile", DOC(low_index, ResultFile))
+        .def(pybind11::init<const std::string &>(),
+             pybind11::arg("filename"),
+             DOC(low_index, ResultFile, ResultFile))
+        .def_property_readonly("rank", &ResultFile::rank,
+                               DOC(low_index, ResultFile, rank))
+        .def_property_readonly("max_degree", &ResultFile::max_degree,
+                               DOC(low_index, ResultFile, max_degree))
+        .def_property_readonly("record_size", &ResultFile::record_size,
+                               DOC(low_index, ResultFile, record_size))
+        .def("__len__", &ResultFile::size,
+             DOC(low_index, ResultFile, size))
+        .def("__getitem__", &ResultFile::cover,
+             pybind11::arg("i"),
+             DOC(low_index, ResultFile, cover))
+        .def("degree", &ResultFile::degree,
+             pybind11::arg("i"),
+             DOC(low_index, ResultFile, degree))
+        .def("num_covers", &ResultFile::num_covers,
+             pybind11::arg("degree"),
+             DOC(low_index, ResultFile, num_covers))
+        .def_property_readonly("num_extents", &ResultFile::num_extents,
+                               DOC(low_index, ResultFile, num_extents))
+        .def("extent",
+             [](const std::shared_ptr<ResultFile> &f, const size_t i) {
+                 // Raise exception early for a bad index (the buffer
+                 // protocol cannot raise it).
+                 f->extent_size(i);
+                 return _ResultFileExtent{ f, i }; },
+             pybind11::arg("i"),
+             DOC(low_index, ResultFile, extent_records));
+}
+
+} // Namespace low_index
@@ -0,0 +1,51 @@
+#include "sampling.h"
+#include "docSampling.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addSampling(pybind11::module_ &m) {
+    pybind11::class_<CoverSample>(
+            m, "CoverSample", DOC(low_index, CoverSample))
+        .def_readonly("num_samples", &CoverSample::num_samples,
+                      DOC(low_index, CoverSample, num_samples))
+        .def_readonly("covers", &CoverSample::covers,
+                      DOC(low_index, CoverSample, covers))
+        .def_readonly("weights", &CoverSample::weights,
+                      DOC(low_index, CoverSample, weights))
+        .def_readonly("probes", &CoverSample::probes,
+                      DOC(low_index, CoverSample, probes));
+
+    pybind11::class_<TreeSizeEstimate>(
+            m, "TreeSizeEstimate", DOC(low_index, TreeSizeEstimate))
+        .def_readonly("num_probes", &TreeSizeEstimate::num_probes,
+                      DOC(low_index, TreeSizeEstimate, num_probes))
+        .def_readonly("nodes", &TreeSizeEstimate::nodes,
+                      DOC(low_index, TreeSizeEstimate, nodes))
+        .def_readonly("nodes_error", &TreeSizeEstimate::nodes_error,
+                      DOC(low_index, TreeSizeEstimate, nodes_error))
+        .def_readonly("covers", &TreeSizeEstimate::covers,
+                      DOC(low_index, TreeSizeEstimate, covers))
+        .def_readonly("covers_error", &TreeSizeEstimate::covers_error,
+                      DOC(low_index, TreeSizeEstimate, covers_error))
+        .def_readonly("total_nodes", &TreeSizeEstimate::total_nodes,
+                      DOC(low_index, TreeSizeEstimate, total_nodes))
+        .def_readonly("total_nodes_error",
+                      &TreeSizeEstimate::total_nodes_error,
+                      DOC(low_index, TreeSizeEstimate, total_nodes_error))
+        .def_readonly("total_covers", &TreeSizeEstimate::total_covers,
+                      DOC(low_index, TreeSizeEstimate, total_covers))
+        .def_readonly("total_covers_error",
+                      &TreeSizeEstimate::total_covers_error,
+                      DOC(low_index, TreeSizeEstimate, total_covers_error))
+        .def_readonly("nodes_probed", &TreeSizeEstimate::nodes_probed,
+                      DOC(low_index, TreeSizeEstimate, nodes_probed))
+        .def_readonly("estimated_seconds",
+                      &TreeSizeEstimate::estimated_seconds,
+                      DOC(low_index, TreeSizeEstimate, estimated_seconds));
+}
+
+} // Namespace low_index
@@ -0,0 +1,57 @@
+#include "searchStatistics.h"
+#include "docSearchStatistics.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addSearchStatistics(pybind11::module_ &m) {
+    pybind11::class_<PerfCounts>(
+            m, "PerfCounts", DOC(low_index, PerfCounts))
+        .def_readonly("calls", &PerfCounts::calls,
+                      DOC(low_index, PerfCounts, calls))
+        .def_readonly("cycles", &PerfCounts::cycles)
+        .def_readonly("instructions", &PerfCounts::instructions)
+        .def_readonly("cache_misses", &PerfCounts::cache_misses)
+        .def_readonly("branch_misses", &PerfCounts::branch_misses)
+        .def_property_readonly(
+            "instructions_per_cycle", &PerfCounts::instructions_per_cycle,
+            DOC(low_index, PerfCounts, instructions_per_cycle));
+
+    pybind11::class_<SearchStatistics>(
+            m, "SearchStatistics", DOC(low_index, SearchStatistics))
+        .def_readonly("nodes_visited", &SearchStatistics::nodes_visited,
+                      DOC(low_index, SearchStatistics, nodes_visited))
+        .def_readonly("children_tried", &SearchStatistics::children_tried,
+                      DOC(low_index, SearchStatistics, children_tried))
+        .def_readonly("relators_pruned", &SearchStatistics::relators_pruned,
+                      DOC(low_index, SearchStatistics, relators_pruned))
+        .def_readonly("minimality_pruned",
+                      &SearchStatistics::minimality_pruned,
+                      DOC(low_index, SearchStatistics, minimality_pruned))
+        .def_readonly("shard_pruned", &SearchStatistics::shard_pruned,
+                      DOC(low_index, SearchStatistics, shard_pruned))
+        .def_readonly("deductions", &SearchStatistics::deductions,
+                      DOC(low_index, SearchStatistics, deductions))
+        .def_readonly("long_relator_checks",
+                      &SearchStatistics::long_relator_checks,
+                      DOC(low_index, SearchStatistics, long_relator_checks))
+        .def_readonly("long_relator_failures",
+                      &SearchStatistics::long_relator_failures,
+                      DOC(low_index, SearchStatistics, long_relator_failures))
+        .def_readonly("covers_found", &SearchStatistics::covers_found,
+                      DOC(low_index, SearchStatistics, covers_found))
+        .def_readonly("elapsed", &SearchStatistics::elapsed,
+                      DOC(low_index, SearchStatistics, elapsed))
+        .def_readonly("phase_seconds", &SearchStatistics::phase_seconds,
+                      DOC(low_index, SearchStatistics, phase_seconds))
+        .def_readonly("perf_counters", &SearchStatistics::perf_counters,
+                      DOC(low_index, SearchStatistics, perf_counters));
+
+    m.attr("statistics_enabled") = statistics_enabled;
+    m.attr("perf_counters_enabled") = perf_counters_enabled;
+}
+
+} // Namespace low_index
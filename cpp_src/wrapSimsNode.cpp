@@ -19,7 +19,35 @@ void addSimsNode(pybind11::module_ &m) {
              pybind11::arg("num_relators") = 0,
              DOC(low_index, SimsNode, SimsNode))
         .def(pybind11::init<const SimsNode&>(),
-             DOC(low_index, SimsNode, SimsNode_3));
+             DOC(low_index, SimsNode, SimsNode_4))
+        .def(pybind11::pickle(
+                 [](const SimsNode &node) {
+                     return pybind11::bytes(encode_sims_nodes({ node }));
+                 },
+                 [](const pybind11::bytes &bytes) {
+                     std::vector<SimsNode> nodes = decode_sims_nodes(bytes);
+                     if (nodes.size() != 1) {
+                         throw std::runtime_error(
+                             "Not an encoding of a single SimsNode.");
+                     }
+                     return std::move(nodes[0]);
+                 }));
+
+    m.def("encode_sims_nodes",
+          [](const std::vector<SimsNode> &nodes, bool with_lift_state) {
+              return pybind11::bytes(
+                  encode_sims_nodes(nodes, with_lift_state));
+          },
+          pybind11::arg("nodes"),
+          pybind11::arg("with_lift_state") = true,
+          DOC(low_index, encode_sims_nodes));
+
+    m.def("decode_sims_nodes",
+          [](const pybind11::bytes &bytes) {
+              return decode_sims_nodes(bytes);
+          },
+          pybind11::arg("bytes"),
+          DOC(low_index, decode_sims_nodes));
 }
 
 } // Namespace low_index
@@ -18,7 +18,14 @@ void addSimsTree(pybind11::module_ &m) {
              pybind11::arg("max_degree"),
              pybind11::arg("short_relators"),
              pybind11::arg("long_relators"),
-             DOC(low_index, SimsTree, SimsTree));
+             DOC(low_index, SimsTree, SimsTree))
+        .def(pybind11::init<const SimsNode &,
+                            const std::vector<Relator> &,
+                            const std::vector<Relator> &>(),
+             pybind11::arg("root"),
+             pybind11::arg("short_relators"),
+             pybind11::arg("long_relators"),
+             DOC(low_index, SimsTree, SimsTree_2));
 }
 
 }
@@ -8,10 +8,74 @@
 namespace low_index {
 
 void addSimsTreeBase(pybind11::module_ &m) {
+    // Release the GIL while searching so that other python threads can,
+    // e.g., call statistics() to monitor the progress.
+    using ReleaseGIL = pybind11::call_guard<pybind11::gil_scoped_release>;
+
     pybind11::class_<SimsTreeBase>(
             m, "SimsTreeBase", DOC(low_index, SimsTreeBase))
         .def("list", &SimsTreeBase::list,
-             DOC(low_index, SimsTreeBase, list));
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, list))
+        .def("list_compact", &SimsTreeBase::list_compact,
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, list_compact))
+        .def("bloom", &SimsTreeBase::bloom,
+             pybind11::arg("num_nodes"),
+             DOC(low_index, SimsTreeBase, bloom))
+        .def("list_batched", &SimsTreeBase::list_batched,
+             pybind11::arg("long_relator_sets"),
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, list_batched))
+        .def("list_to_file", &SimsTreeBase::list_to_file,
+             pybind11::arg("filename"),
+             pybind11::arg("delta_compressed") = false,
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, list_to_file))
+        .def("count", &SimsTreeBase::count,
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, count))
+        .def("estimate_size", &SimsTreeBase::estimate_size,
+             pybind11::arg("num_probes"),
+             pybind11::arg("seed") = 0,
+             pybind11::arg("num_threads") = 1,
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, estimate_size))
+        .def("sample_covers", &SimsTreeBase::sample_covers,
+             pybind11::arg("num_samples"),
+             pybind11::arg("seed") = 0,
+             pybind11::arg("num_threads") = 1,
+             ReleaseGIL(),
+             DOC(low_index, SimsTreeBase, sample_covers))
+        .def("statistics", &SimsTreeBase::statistics,
+             DOC(low_index, SimsTreeBase, statistics))
+        .def("memory_usage", &SimsTreeBase::memory_usage,
+             DOC(low_index, SimsTreeBase, memory_usage))
+        .def("set_memory_limit", &SimsTreeBase::set_memory_limit,
+             pybind11::arg("bytes"),
+             DOC(low_index, SimsTreeBase, set_memory_limit))
+        .def("set_checkpoint", &SimsTreeBase::set_checkpoint,
+             pybind11::arg("filename"),
+             pybind11::arg("interval"),
+             DOC(low_index, SimsTreeBase, set_checkpoint))
+        .def("resume", &SimsTreeBase::resume,
+             pybind11::arg("filename"),
+             DOC(low_index, SimsTreeBase, resume))
+        .def("set_cancellation_token", &SimsTreeBase::set_cancellation_token,
+             pybind11::arg("token"),
+             DOC(low_index, SimsTreeBase, set_cancellation_token))
+        .def("is_complete", &SimsTreeBase::is_complete,
+             DOC(low_index, SimsTreeBase, is_complete))
+        .def("set_shard", &SimsTreeBase::set_shard,
+             pybind11::arg("shard_index"),
+             pybind11::arg("num_shards"),
+             pybind11::arg("shard_depth") =
+                 SimsTreeBase::default_shard_depth,
+             DOC(low_index, SimsTreeBase, set_shard));
+
+    m.def("merge_shards", &merge_shards,
+          pybind11::arg("shards"),
+          DOC(low_index, merge_shards));
 }
 
 }
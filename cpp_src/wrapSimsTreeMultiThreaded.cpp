@@ -21,7 +21,22 @@ void addSimsTreeMultiThreaded(pybind11::module_ &m) {
              pybind11::arg("short_relators"),
              pybind11::arg("long_relators"),
              pybind11::arg("num_threads"),
-             DOC(low_index, SimsTreeMultiThreaded, SimsTreeMultiThreaded));
+             DOC(low_index, SimsTreeMultiThreaded, SimsTreeMultiThreaded))
+        .def(pybind11::init<const SimsNode &,
+                            const std::vector<Relator> &,
+                            const std::vector<Relator> &,
+                            unsigned int>(),
+             pybind11::arg("root"),
+             pybind11::arg("short_relators"),
+             pybind11::arg("long_relators"),
+             pybind11::arg("num_threads"),
+             DOC(low_index, SimsTreeMultiThreaded, SimsTreeMultiThreaded_2))
+        .def("set_memory_budget", &SimsTreeMultiThreaded::set_memory_budget,
+             pybind11::arg("bytes"),
+             DOC(low_index, SimsTreeMultiThreaded, set_memory_budget))
+        .def("set_trace_file", &SimsTreeMultiThreaded::set_trace_file,
+             pybind11::arg("filename"),
+             DOC(low_index, SimsTreeMultiThreaded, set_trace_file));
 }
 
 }
@@ -0,0 +1,20 @@
+#include "subgroupCounts.h"
+#include "docSubgroupCounts.h"
+
+#include "pybind11/pybind11.h"
+
+#include "pybind11/stl.h"
+
+namespace low_index {
+
+void addSubgroupCounts(pybind11::module_ &m) {
+    pybind11::class_<SubgroupCounts>(
+            m, "SubgroupCounts", DOC(low_index, SubgroupCounts))
+        .def_readonly("conjugacy_classes",
+                      &SubgroupCounts::conjugacy_classes,
+                      DOC(low_index, SubgroupCounts, conjugacy_classes))
+        .def_readonly("subgroups", &SubgroupCounts::subgroups,
+                      DOC(low_index, SubgroupCounts, subgroups));
+}
+
+} // Namespace low_index
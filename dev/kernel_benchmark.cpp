@@ -0,0 +1,350 @@
+// Microbenchmark for the kernels of the search: the methods of
+// CoveringSubgraph, AbstractSimsNode and StackedSimsNode called by
+// SimsTree::_recurse.
+//
+// The kernels run on node states captured along random paths through the
+// search trees of some of the examples of python_src/benchmark.py. The
+// result is printed as JSON with the nanoseconds per call for each
+// example and kernel.
+//
+// stacked_copy, add_edge and relators_may_lift are differences of timings
+// (see child_step), so values of a few nanoseconds (or even negative
+// ones) for add_edge are within the noise.
+//
+// Build and run with:
+//
+//     make -C dev kernel_benchmark
+//     dev/kernel_benchmark [min_seconds_per_kernel]
+
+#include "simsNode.h"
+#include "stackedSimsNode.h"
+#include "sampling.h"
+#include "words.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace low_index;
+
+namespace {
+
+struct Example
+{
+    std::string name;
+    RankType rank;
+    std::vector<std::string> short_relators;
+    std::vector<std::string> long_relators;
+    DegreeType max_degree;
+};
+
+const std::vector<Example> examples = {
+    { "O333_2", 4,
+      { "aaa", "bbb", "ccc", "dd", "BaBa", "CaCaCa", "CbCbCbCb",
+        "DbDbDb", "DcDc" },
+      { },
+      14 },
+    { "K11n34", 3,
+      { "aaBcbbcAc" },
+      { "aacAbCBBaCAAbbcBc" },
+      7 },
+    { "K15n12345", 3,
+      { "aBcACAcb" },
+      { "aBaCacBAcAbaBabaCAcAbaBaCacBAcAbaBabCAcAbABaCabABAbABaCabCAcAb" },
+      7 },
+    { "o9_15405", 2,
+      { "aaaaabbbaabbbaaaaabbbaabbbaaaaaBBBBBBBB" },
+      { },
+      9 },
+    { "K5_13(3,0)", 2,
+      { "bbb", "abABaaBAbabABaaBAbabABAb" },
+      { },
+      15 },
+};
+
+// Number of random paths to capture node states from.
+const size_t num_paths = 200;
+
+// The node states of an example.
+struct Capture
+{
+    std::vector<Relator> short_relators;
+    // The relators checked for complete nodes: the long relators or,
+    // if there are none, the short relators.
+    std::vector<Relator> complete_relators;
+    // Incomplete nodes (that passed relators_may_lift and
+    // may_be_minimal).
+    std::vector<SimsNode> nodes;
+    // Complete nodes.
+    std::vector<SimsNode> leaves;
+};
+
+std::vector<Relator>
+parse_words(const RankType rank, const std::vector<std::string> &words)
+{
+    std::vector<Relator> result;
+    for (const std::string &word : words) {
+        result.push_back(parse_word(rank, word));
+    }
+    return result;
+}
+
+// The children of a node in the search tree, same as one step of
+// SimsTree::_recurse.
+std::vector<SimsNode>
+children(const SimsNode &node, const std::vector<Relator> &short_relators)
+{
+    std::vector<SimsNode> result;
+    const std::pair<LetterType, DegreeType> slot = node.first_empty_slot();
+    const DegreeType m =
+        std::min<DegreeType>(node.degree() + 1, node.max_degree());
+    for (DegreeType v = 1; v <= m; v++) {
+        if (node.act_by(-slot.first, v) != 0) {
+            continue;
+        }
+        SimsNode child(node);
+        child.add_edge(slot.first, slot.second, v);
+        if (child.relators_may_lift(short_relators, slot, v) &&
+            child.may_be_minimal()) {
+            result.push_back(std::move(child));
+        }
+    }
+    return result;
+}
+
+Capture
+capture(const Example &example)
+{
+    Capture result;
+    result.short_relators = spin_short(
+        parse_words(example.rank, example.short_relators),
+        example.max_degree);
+    result.complete_relators =
+        example.long_relators.empty()
+            ? result.short_relators
+            : parse_words(example.rank, example.long_relators);
+
+    for (size_t i = 0; i < num_paths; i++) {
+        RandomGenerator rng = RandomGenerator::stream(0, i);
+        // SimsNode has no operator=, so hold it through a pointer.
+        std::unique_ptr<SimsNode> node(
+            new SimsNode(
+                example.rank, example.max_degree,
+                result.short_relators.size()));
+        while (!node->is_complete()) {
+            result.nodes.push_back(*node);
+            std::vector<SimsNode> c = children(*node, result.short_relators);
+            if (c.empty()) {
+                break;
+            }
+            node.reset(new SimsNode(std::move(c[rng.below(c.size())])));
+        }
+        if (node->is_complete()) {
+            result.leaves.push_back(*node);
+        }
+    }
+    return result;
+}
+
+// Defeat the optimizer.
+volatile size_t sink;
+
+// Number of rounds to time each kernel. The fastest round is reported to
+// reduce the noise.
+const int num_rounds = 3;
+
+// Run kernel (which returns the number of calls it made) repeatedly for
+// at least min_seconds and return nanoseconds per call.
+template<typename Kernel>
+double
+time_kernel(const Kernel &kernel, const double min_seconds, size_t *calls)
+{
+    double best = 0.0;
+    for (int round = 0; round < num_rounds; round++) {
+        size_t n = 0;
+        const auto start = std::chrono::steady_clock::now();
+        double seconds = 0.0;
+        do {
+            n += kernel();
+            seconds = std::chrono::duration<double>(
+                std::chrono::steady_clock::now() - start).count();
+        } while (seconds < min_seconds / num_rounds);
+        if (n == 0) {
+            // Nothing captured for this kernel.
+            *calls = 0;
+            return 0.0;
+        }
+        const double ns = seconds * 1e9 / n;
+        if (round == 0 || ns < best) {
+            best = ns;
+            *calls = n;
+        }
+    }
+    return best;
+}
+
+// The kernels on the captured states. Each returns the number of calls.
+
+size_t
+act_by(const Capture &c)
+{
+    size_t calls = 0;
+    size_t s = 0;
+    for (const SimsNode &n : c.nodes) {
+        const int rank = n.rank();
+        for (int l = -rank; l <= rank; l++) {
+            if (l == 0) {
+                continue;
+            }
+            for (DegreeType v = 1; v <= n.degree(); v++) {
+                s += n.act_by(l, v);
+                calls++;
+            }
+        }
+    }
+    sink = s;
+    return calls;
+}
+
+size_t
+first_empty_slot(const Capture &c)
+{
+    size_t s = 0;
+    for (const SimsNode &n : c.nodes) {
+        s += n.first_empty_slot().second;
+    }
+    sink = s;
+    return c.nodes.size();
+}
+
+size_t
+may_be_minimal(const Capture &c)
+{
+    size_t s = 0;
+    for (const SimsNode &n : c.nodes) {
+        s += n.may_be_minimal();
+    }
+    sink = s;
+    return c.nodes.size();
+}
+
+size_t
+relators_lift(const Capture &c)
+{
+    size_t s = 0;
+    for (const SimsNode &n : c.leaves) {
+        s += n.relators_lift(c.complete_relators);
+    }
+    sink = s;
+    return c.leaves.size();
+}
+
+// For each captured node and each vertex v that the first empty slot can
+// be connected to: copy the node as StackedSimsNode and, depending on
+// level, add the edge and check relators_may_lift.
+//
+// level 0: nothing (to measure the overhead of the loop and allocating
+// the SimsNodeStack), level 1: copy, level 2: copy and add_edge,
+// level 3: copy, add_edge and relators_may_lift.
+size_t
+child_step(const Capture &c, const int level)
+{
+    size_t calls = 0;
+    size_t s = 0;
+    for (const SimsNode &n : c.nodes) {
+        SimsNodeStack stack(n);
+        const StackedSimsNode &parent = stack.get_node();
+        const std::pair<LetterType, DegreeType> slot =
+            parent.first_empty_slot();
+        const DegreeType m =
+            std::min<DegreeType>(parent.degree() + 1, parent.max_degree());
+        for (DegreeType v = 1; v <= m; v++) {
+            if (parent.act_by(-slot.first, v) != 0) {
+                continue;
+            }
+            calls++;
+            if (level == 0) {
+                s += v;
+                continue;
+            }
+            StackedSimsNode child(parent);
+            if (level >= 2) {
+                child.add_edge(slot.first, slot.second, v);
+            }
+            if (level >= 3) {
+                s += child.relators_may_lift(c.short_relators, slot, v);
+            }
+            s += child.num_edges();
+        }
+    }
+    sink = s;
+    return calls;
+}
+
+} // Anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    const double min_seconds = argc > 1 ? std::atof(argv[1]) : 0.2;
+
+    std::printf("{\n  \"min_seconds_per_kernel\": %g,\n", min_seconds);
+    std::printf("  \"examples\": [\n");
+    for (size_t i = 0; i < examples.size(); i++) {
+        const Example &example = examples[i];
+        const Capture c = capture(example);
+
+        size_t calls;
+        std::vector<std::pair<std::string, double>> results;
+        std::vector<size_t> num_calls;
+        auto run = [&](const std::string &name, double ns) {
+            results.push_back({name, ns});
+            num_calls.push_back(calls);
+        };
+
+        run("act_by",
+            time_kernel([&]{ return act_by(c); }, min_seconds, &calls));
+        run("first_empty_slot",
+            time_kernel([&]{ return first_empty_slot(c); },
+                        min_seconds, &calls));
+        // The copy, add_edge and relators_may_lift are timed together
+        // (they need a fresh copy of the node each time), so report
+        // the differences.
+        double step[4];
+        for (int level = 0; level < 4; level++) {
+            step[level] = time_kernel(
+                [&]{ return child_step(c, level); }, min_seconds, &calls);
+        }
+        run("stacked_copy", step[1] - step[0]);
+        run("add_edge", step[2] - step[1]);
+        run("relators_may_lift", step[3] - step[2]);
+        run("may_be_minimal",
+            time_kernel([&]{ return may_be_minimal(c); },
+                        min_seconds, &calls));
+        run("relators_lift",
+            time_kernel([&]{ return relators_lift(c); },
+                        min_seconds, &calls));
+
+        std::printf("    {\n");
+        std::printf("      \"name\": \"%s\",\n", example.name.c_str());
+        std::printf("      \"rank\": %d,\n", int(example.rank));
+        std::printf("      \"max_degree\": %d,\n", int(example.max_degree));
+        std::printf("      \"num_nodes\": %zu,\n", c.nodes.size());
+        std::printf("      \"num_leaves\": %zu,\n", c.leaves.size());
+        std::printf("      \"kernels\": {\n");
+        for (size_t j = 0; j < results.size(); j++) {
+            std::printf(
+                "        \"%s\": { \"ns_per_call\": %.3f, \"calls\": %zu }%s\n",
+                results[j].first.c_str(), results[j].second, num_calls[j],
+                j + 1 < results.size() ? "," : "");
+        }
+        std::printf("      }\n");
+        std::printf("    }%s\n", i + 1 < examples.size() ? "," : "");
+    }
+    std::printf("  ]\n}\n");
+    return 0;
+}
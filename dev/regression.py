@@ -0,0 +1,336 @@
+"""
+Run the presentations of dev/corpus.json with 1..N threads and report
+wall time, nodes per second, peak RSS and the number of subgroups.
+
+    python3 dev/regression.py --output results.json
+    python3 dev/regression.py --baseline results.json
+
+Each run is done in a fresh python process so that the peak RSS is that
+of the run alone. The number of subgroups is checked against the corpus
+and, with --baseline, the wall time against the baseline. Cases that are
+slower than the baseline by more than the tolerance are flagged as
+regressions and the exit status is 1.
+
+Nodes per second are only reported (and the seconds spent in each phase
+of the search only included in the --output) if low_index was built with
+LOW_INDEX_STATISTICS=1. The hardware performance counters of each phase
+are included in the --output if low_index was built with
+LOW_INDEX_PERF_COUNTERS=1 (and they are available).
+"""
+
+import argparse
+import json
+import os
+import re
+import subprocess
+import sys
+import time
+
+default_corpus = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                              'corpus.json')
+
+def run_one(case):
+    """
+    Run a single case (in the child process) and print the result as JSON.
+    """
+    import low_index
+
+    rank = case['rank']
+    max_degree = case['max_degree']
+    short_relators = [ low_index.parse_word(rank, r)
+                       for r in case['short_relators'] ]
+    if case.get('strategy', 'spin_short') == 'spin_short':
+        short_relators = low_index.spin_short(short_relators, max_degree)
+    long_relators = [ low_index.parse_word(rank, r)
+                      for r in case['long_relators'] ]
+    if case['num_threads'] == 1:
+        tree = low_index.SimsTree(
+            rank, max_degree, short_relators, long_relators)
+    else:
+        tree = low_index.SimsTreeMultiThreaded(
+            rank, max_degree, short_relators, long_relators,
+            case['num_threads'])
+
+    start = time.perf_counter()
+    covers = tree.list_compact()
+    elapsed = time.perf_counter() - start
+
+    statistics = tree.statistics()
+    nodes = None
+    if low_index.statistics_enabled:
+        nodes = sum(statistics.nodes_visited)
+    perf_counters = {
+        phase : { 'calls': counts.calls,
+                  'cycles': counts.cycles,
+                  'instructions': counts.instructions,
+                  'cache_misses': counts.cache_misses,
+                  'branch_misses': counts.branch_misses }
+        for phase, counts in statistics.perf_counters.items() }
+    print(json.dumps({'subgroups': len(covers),
+                      'elapsed': elapsed,
+                      'nodes': nodes,
+                      'phase_seconds': statistics.phase_seconds,
+                      'perf_counters': perf_counters}))
+
+def peak_rss_bytes(rusage):
+    # ru_maxrss is in kilobytes on Linux and in bytes on macOS.
+    if sys.platform == 'darwin':
+        return rusage.ru_maxrss
+    return rusage.ru_maxrss * 1024
+
+def run_case(case):
+    """
+    Run a case in a child process and return its result with the peak RSS.
+    """
+    process = subprocess.Popen(
+        [ sys.executable, os.path.abspath(__file__),
+          '--run-one', json.dumps(case) ],
+        stdout = subprocess.PIPE)
+    output = process.stdout.read()
+    process.stdout.close()
+    peak_rss = None
+    if hasattr(os, 'wait4'):
+        _, status, rusage = os.wait4(process.pid, 0)
+        process.returncode = os.waitstatus_to_exitcode(status)
+        peak_rss = peak_rss_bytes(rusage)
+    else:
+        process.wait()
+    if process.returncode != 0:
+        raise RuntimeError('Run of %s with degree %d and %d threads failed.' % (
+            case['name'], case['max_degree'], case['num_threads']))
+    result = json.loads(output)
+    result['peak_rss'] = peak_rss
+    return result
+
+def thread_counts(max_threads):
+    """
+    1, 2, 4, ..., max_threads.
+    """
+    result = []
+    n = 1
+    while n < max_threads:
+        result.append(n)
+        n *= 2
+    result.append(max_threads)
+    return result
+
+def cases(corpus, args):
+    name_filter = re.compile(args.filter) if args.filter else None
+    for presentation in corpus['presentations']:
+        if name_filter and not name_filter.search(presentation['name']):
+            continue
+        if args.family and presentation['family'] not in args.family:
+            continue
+        degrees = sorted(presentation['degrees'], key = int)
+        if args.quick:
+            degrees = degrees[:1]
+        for degree in degrees:
+            if args.max_degree and int(degree) > args.max_degree:
+                continue
+            yield presentation, int(degree)
+
+def key(name, max_degree, num_threads):
+    return '%s; degree = %d; threads = %d' % (name, max_degree, num_threads)
+
+def scaling(runs):
+    """
+    Strong scaling of each presentation and degree: speedup and efficiency
+    relative to the run with the fewest threads.
+    """
+    result = {}
+    for run in runs:
+        result.setdefault(
+            (run['name'], run['max_degree']), []).append(run)
+    curves = []
+    for (name, max_degree), series in result.items():
+        series.sort(key = lambda run: run['num_threads'])
+        base = series[0]
+        curves.append({
+            'name': name,
+            'max_degree': max_degree,
+            'threads': [ run['num_threads'] for run in series ],
+            'wall': [ run['wall'] for run in series ],
+            'speedup': [ base['wall'] / run['wall'] for run in series ],
+            'efficiency': [
+                base['wall'] * base['num_threads'] /
+                (run['wall'] * run['num_threads']) for run in series ] })
+    return curves
+
+def format_rss(peak_rss):
+    if peak_rss is None:
+        return '-'
+    return '%.1fMB' % (peak_rss / 2.0 ** 20)
+
+def format_rate(run):
+    if run['nodes'] is None:
+        return '-'
+    return '%.3g' % (run['nodes'] / run['wall'])
+
+def compare(runs, baseline, tolerance, min_delta):
+    """
+    Return the runs that are slower than in the baseline.
+    """
+    if baseline['corpus_version'] != runs['corpus_version']:
+        raise ValueError(
+            'Baseline is for corpus version %d, not %d.' % (
+                baseline['corpus_version'], runs['corpus_version']))
+    old = { key(run['name'], run['max_degree'], run['num_threads']) : run
+            for run in baseline['runs'] }
+    regressions = []
+    for run in runs['runs']:
+        k = key(run['name'], run['max_degree'], run['num_threads'])
+        if k not in old:
+            continue
+        before = old[k]['wall']
+        if (run['wall'] > before * (1 + tolerance) and
+            run['wall'] - before > min_delta):
+            regressions.append((k, before, run['wall']))
+    return regressions
+
+def plot(curves, filename):
+    import matplotlib
+    matplotlib.use('Agg')
+    import matplotlib.pyplot as plt
+    figure, axes = plt.subplots()
+    max_threads = 1
+    for curve in curves:
+        if len(curve['threads']) < 2:
+            continue
+        axes.plot(curve['threads'], curve['speedup'], marker = 'o',
+                  label = '%s (%d)' % (curve['name'], curve['max_degree']))
+        max_threads = max(max_threads, curve['threads'][-1])
+    axes.plot([1, max_threads], [1, max_threads], 'k--', label = 'ideal')
+    axes.set_xlabel('threads')
+    axes.set_ylabel('speedup')
+    axes.legend(fontsize = 'small')
+    figure.savefig(filename)
+
+def main():
+    parser = argparse.ArgumentParser(
+        description = 'Benchmark and regression runner for low_index.')
+    parser.add_argument('--corpus', default = default_corpus)
+    parser.add_argument('--filter',
+                        help = 'Only run presentations whose name matches '
+                        'this regular expression.')
+    parser.add_argument('--family', action = 'append',
+                        help = 'Only run presentations of this family '
+                        '(can be repeated).')
+    parser.add_argument('--quick', action = 'store_true',
+                        help = 'Only run the smallest degree of each '
+                        'presentation.')
+    parser.add_argument('--max-degree', type = int)
+    parser.add_argument('--max-threads', type = int,
+                        help = 'Run with 1, 2, 4, ..., max-threads threads '
+                        '(default: all cores).')
+    parser.add_argument('--repeat', type = int, default = 1,
+                        help = 'Number of runs per case, the fastest is '
+                        'reported.')
+    parser.add_argument('--output', help = 'Write the results as JSON. '
+                        'Can be used as --baseline later.')
+    parser.add_argument('--baseline', help = 'Results to compare against.')
+    parser.add_argument('--tolerance', type = float, default = 0.1,
+                        help = 'Relative slowdown to flag as regression.')
+    parser.add_argument('--min-delta', type = float, default = 0.05,
+                        help = 'Slowdowns of fewer seconds are ignored.')
+    parser.add_argument('--plot', help = 'Save the strong scaling curves '
+                        'to this file (needs matplotlib).')
+    parser.add_argument('--run-one', help = argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.run_one:
+        run_one(json.loads(args.run_one))
+        return 0
+
+    import low_index
+    from low_index import benchmark_util
+
+    with open(args.corpus) as input_file:
+        corpus = json.load(input_file)
+
+    max_threads = args.max_threads or low_index.hardware_concurrency() or 1
+
+    results = {
+        'corpus_version': corpus['version'],
+        'low_index_version': low_index.version(),
+        'cpu': benchmark_util.cpu_info(),
+        'hardware_concurrency': low_index.hardware_concurrency(),
+        'statistics_enabled': low_index.statistics_enabled,
+        'runs': [] }
+
+    failures = []
+    for presentation, max_degree in cases(corpus, args):
+        expected = presentation['degrees'][str(max_degree)]
+        for num_threads in thread_counts(max_threads):
+            case = { 'name': presentation['name'],
+                     'rank': presentation['rank'],
+                     'short_relators': presentation['short_relators'],
+                     'long_relators': presentation['long_relators'],
+                     'strategy': presentation.get('strategy', 'spin_short'),
+                     'max_degree': max_degree,
+                     'num_threads': num_threads }
+            best = None
+            for i in range(args.repeat):
+                result = run_case(case)
+                if best is None or result['elapsed'] < best['elapsed']:
+                    best = result
+            run = { 'name': presentation['name'],
+                    'max_degree': max_degree,
+                    'num_threads': num_threads,
+                    'wall': best['elapsed'],
+                    'nodes': best['nodes'],
+                    'peak_rss': best['peak_rss'],
+                    'phase_seconds': best['phase_seconds'],
+                    'perf_counters': best['perf_counters'],
+                    'subgroups': best['subgroups'] }
+            results['runs'].append(run)
+            status = ''
+            if run['subgroups'] != expected:
+                status = ' WRONG (expected %d)' % expected
+                failures.append(key(presentation['name'], max_degree,
+                                    num_threads))
+            print('%-50s %9.3fs %10s nodes/s %10s %8d subgroups%s' % (
+                key(presentation['name'], max_degree, num_threads),
+                run['wall'], format_rate(run), format_rss(run['peak_rss']),
+                run['subgroups'], status))
+            sys.stdout.flush()
+
+    results['scaling'] = scaling(results['runs'])
+    if max_threads > 1:
+        print('\nStrong scaling (speedup, efficiency):')
+        for curve in results['scaling']:
+            print('%-40s %s' % (
+                '%s; degree = %d' % (curve['name'], curve['max_degree']),
+                '  '.join('%d: %.2fx %3.0f%%' % (t, s, 100 * e)
+                          for t, s, e in zip(curve['threads'],
+                                             curve['speedup'],
+                                             curve['efficiency']))))
+
+    if args.output:
+        with open(args.output, 'w') as output_file:
+            json.dump(results, output_file, indent = 2)
+    if args.plot:
+        plot(results['scaling'], args.plot)
+
+    regressions = []
+    if args.baseline:
+        with open(args.baseline) as input_file:
+            baseline = json.load(input_file)
+        regressions = compare(results, baseline,
+                              args.tolerance, args.min_delta)
+        if regressions:
+            print('\nRegressions against %s:' % args.baseline)
+            for k, before, after in regressions:
+                print('%-50s %9.3fs -> %9.3fs (%+.0f%%)' % (
+                    k, before, after, 100 * (after / before - 1)))
+        else:
+            print('\nNo regressions against %s.' % args.baseline)
+
+    if failures:
+        print('\nWrong number of subgroups:')
+        for k in failures:
+            print(k)
+
+    return 1 if (failures or regressions) else 0
+
+if __name__ == '__main__':
+    sys.exit(main())
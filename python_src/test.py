@@ -1,3 +1,11 @@
+import _thread
+import json
+import os
+import pickle
+import struct
+import tempfile
+import threading
+import time
 import unittest
 
 from collections import Counter
@@ -80,6 +88,46 @@ class TestSimsTree(unittest.TestCase):
         self.assertEqual(degrees[6], 11)
         self.assertEqual(degrees[7], 0) # Beyond what we counted
 
+    def test_memory_budget(self):
+        expected = SimsTree(2, 8, [], []).list_compact()
+        # The budget only changes how the work is distributed among the
+        # threads, not the result.
+        for budget in [ 0, 1, 10000 ]:
+            t = SimsTreeMultiThreaded(2, 8, [], [], 8)
+            t.set_memory_budget(budget)
+            covers = t.list_compact()
+            self.assertEqual(len(covers), len(expected))
+            for i in range(0, len(covers), 101):
+                self.assertEqual(covers.permutation_rep(i),
+                                 expected.permutation_rep(i))
+
+    def test_trace(self):
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            filename = os.path.join(tmp_dir, 'trace.json')
+            t = SimsTreeMultiThreaded(2, 7, [], [], 4)
+            t.set_trace_file(filename)
+            self.assertEqual(len(t.list_compact()),
+                             len(SimsTree(2, 7, [], []).list_compact()))
+            with open(filename) as trace_file:
+                events = json.load(trace_file)['traceEvents']
+
+        thread_names = { event['tid'] : event['args']['name']
+                         for event in events
+                         if event.get('name') == 'thread_name' }
+        self.assertEqual(thread_names,
+                         { 0: 'worker 0', 1: 'worker 1', 2: 'worker 2',
+                           3: 'worker 3', 4: 'main' })
+        names = Counter(event.get('name') for event in events
+                        if event['ph'] in 'Bi')
+        # The root and the nodes handed out to refill the queue.
+        self.assertGreater(names['subtree'], 1)
+        self.assertGreater(names['swap queue'], 0)
+        self.assertEqual(names['stop response'], names['swap queue'])
+        for tid in thread_names:
+            phases = [ event['ph'] for event in events
+                       if event.get('tid') == tid and event['ph'] in 'BE' ]
+            self.assertEqual(phases.count('B'), phases.count('E'))
+
 class TestPermutationRep(unittest.TestCase):
     def _test_K11n34_7(self, num_threads):
         reps = permutation_reps(
@@ -177,9 +225,873 @@ class TestPermutationRep(unittest.TestCase):
     def test_o9_03127_9_long(self):
         self._test_o9_03127_9(True)
 
+class TestPermutationRepsBatched(unittest.TestCase):
+    def _test_K11n34_6(self, num_threads):
+        long_relator_sets = [["aacAbCBBaCAAbbcBc"], [], ["ab"]]
+
+        batched = permutation_reps_batched(
+            3,
+            ["aaBcbbcAc"],
+            [],
+            long_relator_sets,
+            6,
+            num_threads = num_threads)
+
+        self.assertEqual(len(batched), 3)
+        for long_relators, reps in zip(long_relator_sets, batched):
+            self.assertEqual(
+                reps,
+                permutation_reps(
+                    3,
+                    ["aaBcbbcAc"],
+                    long_relators,
+                    6,
+                    num_threads = num_threads))
+
+    def test_K11n34_6_single_threaded(self):
+        self._test_K11n34_6(num_threads = 1)
+
+    def test_K11n34_6_multi_threaded(self):
+        self._test_K11n34_6(num_threads = 4)
+
+    def test_empty(self):
+        self.assertEqual(
+            permutation_reps_batched(2, ["aa"], [], [], 3), [])
+
+class TestCoverStore(unittest.TestCase):
+    def test_K11n34_6(self):
+        with tempfile.TemporaryDirectory() as d:
+            filename = os.path.join(d, 'K11n34.store')
+            create_cover_store(filename, 3, ["aaBcbbcAc"], 6)
+            # The temporary result file has been removed.
+            self.assertEqual(os.listdir(d), [ 'K11n34.store' ])
+
+            # Same as writing the store from a result file.
+            results_filename = os.path.join(d, 'K11n34.results')
+            create_result_file(
+                results_filename, 3, ["aaBcbbcAc"], [], 6, num_threads = 3)
+            other_filename = os.path.join(d, 'other.store')
+            write_cover_store(other_filename, ResultFile(results_filename))
+            with open(filename, 'rb') as f, open(other_filename, 'rb') as g:
+                self.assertEqual(f.read(), g.read())
+
+            store = CoverStore(filename)
+            self.assertEqual(store.rank, 3)
+            self.assertEqual(store.max_degree, 6)
+            self.assertEqual(
+                len(store),
+                len(permutation_reps(3, ["aaBcbbcAc"], [], 6)))
+
+            for num_threads in [1, 3]:
+                reps = [ cover.permutation_rep()
+                         for cover in store.query(["aacAbCBBaCAAbbcBc"],
+                                                  num_threads) ]
+                expected = permutation_reps(
+                    3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 6)
+                # The store groups the covers by degree.
+                expected.sort(key = lambda rep: len(rep[0]))
+                self.assertEqual(reps, expected)
+
+    def test_bad_file(self):
+        with tempfile.TemporaryDirectory() as d:
+            filename = os.path.join(d, 'bad.store')
+            with open(filename, 'wb') as f:
+                f.write(b'Not a store')
+            with self.assertRaises(RuntimeError):
+                CoverStore(filename)
+
+            # The number of covers in the header would overflow the
+            # offset into the file.
+            with open(filename, 'wb') as f:
+                f.write(b'LICS' + (1).to_bytes(4, 'little') +
+                        (3).to_bytes(2, 'little') + bytes([2, 0, 0, 0, 0, 0]) +
+                        (1).to_bytes(8, 'little') +
+                        (2**64 // 6 + 1).to_bytes(8, 'little') +
+                        bytes(5))
+            with self.assertRaises(RuntimeError):
+                CoverStore(filename)
+
+            # A graph of degree 2 with two edges labeled a ending at 1.
+            with open(filename, 'wb') as f:
+                f.write(b'LICS' + (1).to_bytes(4, 'little') +
+                        (1).to_bytes(2, 'little') + bytes([2, 0, 0, 0, 0, 0]) +
+                        (0).to_bytes(8, 'little') +
+                        (1).to_bytes(8, 'little') +
+                        bytes([1, 1]))
+            with self.assertRaises(RuntimeError):
+                CoverStore(filename)
+
+class TestResultFile(unittest.TestCase):
+    def test_K11n34_7(self):
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+
+        with tempfile.TemporaryDirectory() as d:
+            for num_threads in [1, 4]:
+                filename = os.path.join(d, 'K11n34_%d.results' % num_threads)
+                self.assertEqual(
+                    create_result_file(
+                        filename, 3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7,
+                        num_threads = num_threads),
+                    len(expected))
+                # No temporary files are left next to the result file.
+                self.assertEqual(
+                    os.listdir(d), [ os.path.basename(filename) ])
+
+                f = ResultFile(filename)
+                self.assertEqual(len(f), len(expected))
+                self.assertEqual(f.num_covers(7), 30)
+                self.assertEqual(
+                    [ f[i].permutation_rep() for i in range(len(f)) ],
+                    expected)
+
+                # Same as numpy.asarray(f.extent(i))
+                if num_threads == 1:
+                    self.assertEqual(f.num_extents, 1)
+                extents = [ memoryview(f.extent(i))
+                            for i in range(f.num_extents) ]
+                self.assertEqual(
+                    sum(extent.shape[0] for extent in extents), len(f))
+                self.assertEqual(
+                    [ record[0]
+                      for extent in extents
+                      for record in extent.tolist() ],
+                    [ len(rep[0]) for rep in expected ])
+                with self.assertRaises(IndexError):
+                    f.extent(f.num_extents)
+                del extents, f
+                os.remove(filename)
+
+class TestDeltaStream(unittest.TestCase):
+    def test_K11n34_7(self):
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+
+        with tempfile.TemporaryDirectory() as d:
+            raw_filename = os.path.join(d, 'K11n34.results')
+            create_result_file(
+                raw_filename, 3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+            for num_threads in [1, 4]:
+                filename = os.path.join(d, 'K11n34_%d.delta' % num_threads)
+                self.assertEqual(
+                    create_result_file(
+                        filename, 3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7,
+                        num_threads = num_threads, delta_compressed = True),
+                    len(expected))
+                if num_threads == 1:
+                    # With several threads, each run of records starts
+                    # without a shared prefix, so there is no gain for
+                    # such a small example.
+                    self.assertLess(
+                        os.path.getsize(filename),
+                        os.path.getsize(raw_filename))
+                # No temporary files are left next to the stream.
+                self.assertEqual(
+                    [ n for n in os.listdir(d)
+                      if n.startswith(os.path.basename(filename)) ],
+                    [ os.path.basename(filename) ])
+
+                s = DeltaStream(filename)
+                self.assertEqual((s.rank, s.max_degree), (3, 7))
+                self.assertEqual(len(s), len(expected))
+                self.assertEqual(
+                    [ n.permutation_rep() for n in s ], expected)
+                # Iterating again starts from the beginning.
+                self.assertEqual(
+                    [ n.permutation_rep() for n in s ], expected)
+                del s
+
+            # Write a stream by hand.
+            filename = os.path.join(d, 'written.delta')
+            w = DeltaStreamWriter(filename, 3, 7)
+            for n in ResultFile(raw_filename):
+                w.write(n)
+            with self.assertRaises(ValueError):
+                w.write(SimsNode(3, 7, 1))
+            self.assertEqual(len(w), len(expected))
+            w.close()
+            self.assertEqual(
+                [ n.permutation_rep() for n in DeltaStream(filename) ],
+                expected)
+
+class TestCheckpoint(unittest.TestCase):
+    def test_K11n34_7(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        expected = [
+            n.permutation_rep()
+            for n in SimsTree(3, 7, short_relators, long_relators).list() ]
+
+        with tempfile.TemporaryDirectory() as d:
+            filename = os.path.join(d, 'K11n34.checkpoint')
+            for num_threads in [1, 3]:
+                if num_threads == 1:
+                    t = SimsTree(3, 7, short_relators, long_relators)
+                else:
+                    t = SimsTreeMultiThreaded(
+                        3, 7, short_relators, long_relators, num_threads)
+                t.set_checkpoint(filename, 0.01)
+                self.assertEqual(
+                    [ n.permutation_rep() for n in t.list() ], expected)
+
+                # Resume from the last checkpoint written, swapping the
+                # kind of tree.
+                if num_threads == 1:
+                    t = SimsTreeMultiThreaded(
+                        3, 7, short_relators, long_relators, 2)
+                else:
+                    t = SimsTree(3, 7, short_relators, long_relators)
+                t.resume(filename)
+                self.assertEqual(
+                    [ n.permutation_rep() for n in t.list() ], expected)
+
+            t = SimsTree(3, 6, short_relators, long_relators)
+            t.resume(filename)
+            with self.assertRaises(ValueError):
+                t.list()
+
+class TestBloom(unittest.TestCase):
+    def test_K11n34_7(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        expected = [
+            n.permutation_rep()
+            for n in SimsTree(3, 7, short_relators, long_relators).list() ]
+
+        nodes = SimsTree(3, 7, short_relators, long_relators).bloom(50)
+        self.assertGreaterEqual(len(nodes), 50)
+
+        reps = []
+        for i, node in enumerate(nodes):
+            if i % 2 == 0:
+                t = SimsTree(node, short_relators, long_relators)
+            else:
+                t = SimsTreeMultiThreaded(
+                    node, short_relators, long_relators, 2)
+            reps += [ n.permutation_rep() for n in t.list() ]
+        self.assertEqual(reps, expected)
+
+    def test_wrong_num_relators(self):
+        with self.assertRaises(ValueError):
+            SimsTree(SimsNode(2, 3, 1), [[1, 1], [2, 2]], [])
+        with self.assertRaises(ValueError):
+            SimsTree(SimsNode(2, 3, 1), [], [])
+
+class TestEncoding(unittest.TestCase):
+    def test_pickle(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        nodes = SimsTree(3, 7, short_relators, long_relators).bloom(20)
+
+        # Continuing the search from unpickled nodes requires the
+        # lift state.
+        unpickled = [ pickle.loads(pickle.dumps(node)) for node in nodes ]
+        self.assertEqual([ str(node) for node in unpickled ],
+                         [ str(node) for node in nodes ])
+        self.assertEqual(
+            [ n.permutation_rep()
+              for node in unpickled
+              for n in SimsTree(node, short_relators, long_relators).list() ],
+            permutation_reps(3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7))
+
+    def test_bulk(self):
+        nodes = SimsTree(2, 4, [], []).list()
+        for with_lift_state in [False, True]:
+            decoded = decode_sims_nodes(
+                encode_sims_nodes(nodes, with_lift_state))
+            self.assertEqual([ node.permutation_rep() for node in decoded ],
+                             [ node.permutation_rep() for node in nodes ])
+        self.assertEqual(decode_sims_nodes(encode_sims_nodes([])), [])
+        with self.assertRaises(ValueError):
+            encode_sims_nodes([SimsNode(2, 3), SimsNode(2, 4)])
+        with self.assertRaises(RuntimeError):
+            decode_sims_nodes(encode_sims_nodes(nodes)[:-1])
+
+    def test_malformed(self):
+        def header(num_relators, num_nodes, flags = 1):
+            return (b"LISN" + struct.pack("<BBHBIQ", 1, flags, 2, 3,
+                                          num_relators, num_nodes))
+
+        # Rejected before allocating the nodes.
+        for flags in [0, 1]:
+            with self.assertRaises(RuntimeError):
+                decode_sims_nodes(header(2**32 - 1, 1, flags) + b"\x01aa")
+            with self.assertRaises(RuntimeError):
+                decode_sims_nodes(header(0, 2**64 - 1, flags))
+        with self.assertRaises(ValueError):
+            encode_sims_nodes([SimsNode(2, 3, 10)], False)
+
+        # Degree 1 with two loops and lift vertex 2 (lift index 0).
+        with self.assertRaises(ValueError):
+            decode_sims_nodes(
+                header(1, 1) + b"\x01\x01\x01" + struct.pack("<HB", 0, 2))
+
+        # Lift index 5 is valid for "aaBabbAb" but not for "ab".
+        node, = decode_sims_nodes(
+            header(1, 1) + b"\x01\x00\x00" + struct.pack("<HB", 5, 1))
+        node.check_lift_state([parse_word(2, "aaBabbAb")])
+        relators = [parse_word(2, "ab")]
+        with self.assertRaises(ValueError):
+            node.relators_may_lift(relators, (0, 0), 0)
+        with self.assertRaises(ValueError):
+            SimsTree(node, relators, [])
+
+class TestPermutationRepSet(unittest.TestCase):
+    def test_K11n34_7(self):
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+        reps = permutation_rep_set(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+
+        self.assertEqual(len(reps), len(expected))
+        self.assertEqual(list(reps), expected)
+        self.assertEqual(reps[-1], expected[-1])
+        with self.assertRaises(IndexError):
+            reps[len(reps)]
+
+        for degree in range(1, 8):
+            # Same as numpy.asarray(reps.array(degree)).tolist()
+            array = memoryview(reps.array(degree))
+            self.assertEqual(array.shape, (reps.num_reps(degree), 3, degree))
+            self.assertEqual(
+                array.tolist(),
+                [ rep for rep in expected if len(rep[0]) == degree ])
+
+class TestCoverList(unittest.TestCase):
+    def test_K11n34_7(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+
+        for t in [ SimsTree(3, 7, short_relators, long_relators),
+                   SimsTreeMultiThreaded(
+                       3, 7, short_relators, long_relators, 4) ]:
+            covers = t.list_compact()
+            self.assertEqual((covers.rank, covers.max_degree), (3, 7))
+            self.assertEqual(len(covers), len(expected))
+            self.assertEqual(
+                [ covers.permutation_rep(i) for i in range(len(covers)) ],
+                expected)
+            self.assertEqual(
+                [ n.permutation_rep() for n in covers.to_sims_nodes() ],
+                expected)
+            self.assertEqual(covers[-1].permutation_rep(), expected[-1])
+            self.assertEqual(covers.degree(-1), len(expected[-1][0]))
+            with self.assertRaises(IndexError):
+                covers[len(covers)]
+            # The SimsNode's have no acceleration structure for the short
+            # relators.
+            with self.assertRaises(ValueError):
+                covers[0].relators_may_lift(short_relators, (0, 0), 0)
+            self.assertTrue(covers[0].relators_lift(short_relators))
+
+            reps = PermutationRepSet(3, 7, covers)
+            self.assertEqual(list(reps), expected)
+
+class TestStatistics(unittest.TestCase):
+    def test_K11n34_7(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+
+        results = []
+        for t in [ SimsTree(3, 7, short_relators, long_relators),
+                   SimsTreeMultiThreaded(
+                       3, 7, short_relators, long_relators, 4) ]:
+            self.assertEqual(t.statistics().elapsed, 0)
+            covers = t.list()
+            s = t.statistics()
+            self.assertGreater(s.elapsed, 0)
+            # The search has finished.
+            self.assertEqual(t.statistics().elapsed, s.elapsed)
+            if not statistics_enabled:
+                self.assertEqual(s.covers_found, 0)
+                self.assertEqual(s.phase_seconds, {})
+                continue
+
+            self.assertEqual(set(s.phase_seconds),
+                             {'slot', 'copy', 'lift', 'minimality', 'leaf'})
+            self.assertGreater(s.phase_seconds['lift'], 0)
+
+            self.assertEqual(s.covers_found, len(covers))
+            self.assertEqual(len(s.nodes_visited), 3 * 7 + 1)
+            self.assertEqual(s.nodes_visited[0], 1)
+            # Every visited node but the root was a child that was tried
+            # and not pruned.
+            relators_pruned = (
+                s.children_tried - s.minimality_pruned - s.shard_pruned -
+                (sum(s.nodes_visited) - 1))
+            self.assertGreater(relators_pruned, 0)
+            self.assertLessEqual(relators_pruned, s.relators_pruned)
+            self.assertEqual(
+                s.covers_found,
+                s.long_relator_checks - s.long_relator_failures)
+            results.append(
+                (s.nodes_visited, s.children_tried, s.relators_pruned,
+                 s.minimality_pruned, s.deductions, s.long_relator_checks,
+                 s.covers_found))
+
+        if statistics_enabled:
+            # The counters do not depend on the number of threads.
+            self.assertEqual(results[0], results[1])
+
+    def test_perf_counters(self):
+        t = SimsTreeMultiThreaded(
+            2, 7, spin_short([parse_word(2, "aaBB")], 7), [], 2)
+        t.list()
+        perf_counters = t.statistics().perf_counters
+        if not perf_counters_enabled:
+            self.assertEqual(perf_counters, {})
+            return
+        # Empty if the hardware counters are not available.
+        if perf_counters:
+            self.assertEqual(set(perf_counters),
+                             {'slot', 'copy', 'lift', 'minimality', 'leaf'})
+            self.assertGreater(perf_counters['copy'].calls, 0)
+            self.assertGreater(perf_counters['copy'].instructions, 0)
+
+    def test_monitor(self):
+        # statistics() can be called while list() is running in a
+        # different thread.
+        t = SimsTreeMultiThreaded(
+            2, 7, spin_short([parse_word(2, "aaBB")], 7), [], 2)
+        thread = threading.Thread(target = t.list)
+        thread.start()
+        elapsed = [ t.statistics().elapsed for i in range(10) ]
+        thread.join()
+        self.assertEqual(elapsed, sorted(elapsed))
+        self.assertGreater(t.statistics().elapsed, 0)
+
+class TestEstimate(unittest.TestCase):
+    def test_aaBB_6(self):
+        t = SimsTree(2, 6, spin_short([parse_word(2, "aaBB")], 6), [])
+        num_covers = len(t.list())
+        e = t.estimate_size(20000, seed = 1)
+        self.assertEqual(e.num_probes, 20000)
+        self.assertEqual(len(e.nodes), 6)
+        self.assertEqual(len(e.covers), 6)
+        self.assertGreater(e.total_covers_error, 0)
+        self.assertLess(abs(e.total_covers - num_covers),
+                        4 * e.total_covers_error)
+        self.assertAlmostEqual(e.total_covers, sum(e.covers))
+        self.assertAlmostEqual(e.total_nodes, sum(e.nodes))
+        self.assertGreaterEqual(e.nodes_probed, 20000)
+        self.assertGreater(e.estimated_seconds, 0)
+
+        # The result only depends on the seed and the number of probes.
+        e2 = t.estimate_size(20000, seed = 1, num_threads = 3)
+        self.assertAlmostEqual(e.total_nodes, e2.total_nodes)
+        self.assertAlmostEqual(e.total_covers, e2.total_covers)
+        self.assertEqual(e.nodes_probed, e2.nodes_probed)
+
+    def test_estimate_tree_size(self):
+        e = estimate_tree_size(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7, 1000,
+            num_threads = 2, seed = 5)
+        # Every probe starts at the root.
+        self.assertGreaterEqual(e.nodes[0], 1)
+        self.assertEqual(e.nodes_probed,
+                         estimate_tree_size(
+                             3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7, 1000,
+                             seed = 5).nodes_probed)
+
+    def test_sample_covers(self):
+        t = SimsTree(2, 6, spin_short([parse_word(2, "aaBB")], 6), [])
+        covers = t.list()
+        even = sum(1 for c in covers if c.degree % 2 == 0) / len(covers)
+
+        s = t.sample_covers(20000, seed = 3)
+        self.assertEqual(s.num_samples, 20000)
+        self.assertEqual(len(s.covers), len(s.weights))
+        self.assertEqual(s.probes, sorted(s.probes))
+        # Every sampled cover is a result of list().
+        reps = [ c.permutation_rep() for c in covers ]
+        for i in range(0, len(s.covers), 1000):
+            self.assertIn(s.covers.permutation_rep(i), reps)
+
+        # Estimate the number of covers and the fraction of covers of
+        # even degree.
+        self.assertAlmostEqual(
+            sum(s.weights) / s.num_samples, len(covers), delta = 1)
+        self.assertAlmostEqual(
+            sum(w for i, w in enumerate(s.weights)
+                if s.covers.degree(i) % 2 == 0) / sum(s.weights),
+            even, delta = 0.02)
+
+        # The result does not depend on the number of threads.
+        s2 = t.sample_covers(20000, seed = 3, num_threads = 3)
+        self.assertEqual(s.probes, s2.probes)
+        self.assertEqual(s.weights, s2.weights)
+
+        s3 = sample_covers(2, ["aaBB"], [], 6, 20000, num_threads = 2,
+                           seed = 3)
+        self.assertEqual(s.weights, s3.weights)
+
+class TestMemoryUsage(unittest.TestCase):
+    def test_breakdown(self):
+        relators = spin_short([parse_word(2, "aaBB")], 7)
+        usages = []
+        for t in [ SimsTree(2, 7, relators, []),
+                   SimsTreeMultiThreaded(2, 7, relators, [], 4) ]:
+            covers = t.list_compact()
+            usage = t.memory_usage()
+            self.assertGreater(usage.stack_frames, 0)
+            self.assertGreater(usage.relators, 0)
+            self.assertGreater(usage.complete_nodes, 8 * len(covers))
+            self.assertEqual(
+                usage.total,
+                usage.stack_frames + usage.pending_nodes +
+                usage.complete_nodes + usage.relators)
+            self.assertGreaterEqual(usage.peak, usage.total)
+            usages.append(usage)
+        # One stack per thread.
+        self.assertEqual(usages[1].stack_frames, 4 * usages[0].stack_frames)
+        self.assertEqual(usages[0].pending_nodes, 0)
+        self.assertEqual(usages[1].complete_nodes, usages[0].complete_nodes)
+        self.assertEqual(usages[1].relators, usages[0].relators)
+
+    def test_limit(self):
+        for t in [ SimsTree(2, 9, [], []),
+                   SimsTreeMultiThreaded(2, 9, [], [], 2) ]:
+            t.set_memory_limit(1 << 20)
+            with self.assertRaises(MemoryLimitExceeded):
+                t.list_compact()
+            self.assertFalse(t.is_complete())
+            # Stopped shortly after exceeding the limit.
+            self.assertGreater(t.memory_usage().peak, 1 << 20)
+            self.assertLess(t.memory_usage().peak, 1 << 23)
+
+        # Not even enough memory to start.
+        t = SimsTree(2, 5, [], [])
+        t.set_memory_limit(1)
+        with self.assertRaises(MemoryError):
+            t.list()
+
+        t = SimsTree(2, 5, [], [])
+        t.set_memory_limit(1 << 20)
+        # Conjugacy classes of subgroups of F2 of index at most 5.
+        self.assertEqual(len(t.list()), 1 + 3 + 7 + 26 + 97)
+        self.assertTrue(t.is_complete())
+
+class TestCancellation(unittest.TestCase):
+    # F2 has 353884 subgroups of index at most 9 and list() takes about a
+    # second. For index 10, it takes long enough for the search to be
+    # stopped reliably.
+
+    def _check_prefix(self, covers, full):
+        for i in range(0, len(covers), 997):
+            self.assertEqual(covers.permutation_rep(i),
+                             full.permutation_rep(i))
+
+    def test_deadline(self):
+        full = SimsTree(2, 9, [], []).list_compact()
+        for t in [ SimsTree(2, 9, [], []),
+                   SimsTreeMultiThreaded(2, 9, [], [], 4) ]:
+            self.assertFalse(t.is_complete())
+            token = CancellationToken()
+            token.set_deadline(0.05)
+            t.set_cancellation_token(token)
+            covers = t.list_compact()
+            self.assertTrue(token.is_cancelled())
+            self.assertFalse(t.is_complete())
+            self.assertLess(len(covers), len(full))
+            if isinstance(t, SimsTree):
+                # The covers found so far are in the order of list().
+                self._check_prefix(covers, full)
+
+        t = SimsTree(2, 6, [], [])
+        t.set_cancellation_token(CancellationToken())
+        self.assertEqual(len(t.list()), 758)
+        self.assertTrue(t.is_complete())
+
+    def test_cancel(self):
+        token = CancellationToken()
+        trees = [ SimsTree(2, 10, [], []),
+                  SimsTreeMultiThreaded(2, 10, [], [], 2) ]
+        for t in trees:
+            t.set_cancellation_token(token)
+        threading.Timer(0.2, token.cancel).start()
+        start = time.time()
+        for t in trees:
+            t.list_compact()
+            self.assertFalse(t.is_complete())
+        self.assertLess(time.time() - start, 5)
+
+    def test_resume(self):
+        full = SimsTree(2, 9, [], []).list_compact()
+        for make_tree in [
+                lambda: SimsTree(2, 9, [], []),
+                lambda: SimsTreeMultiThreaded(2, 9, [], [], 4) ]:
+            with tempfile.TemporaryDirectory() as tmp_dir:
+                path = os.path.join(tmp_dir, "checkpoint.bin")
+                t = make_tree()
+                t.set_checkpoint(path, 1000)
+                token = CancellationToken()
+                token.set_deadline(0.05)
+                t.set_cancellation_token(token)
+                self.assertLess(len(t.list_compact()), len(full))
+                self.assertTrue(os.path.exists(path))
+
+                t = make_tree()
+                t.resume(path)
+                covers = t.list_compact()
+                self.assertTrue(t.is_complete())
+                self.assertEqual(len(covers), len(full))
+                self._check_prefix(covers, full)
+
+    def test_interrupt(self):
+        # Ctrl-C stops the search of a tree.
+        for t in [ SimsTree(2, 10, [], []),
+                   SimsTreeMultiThreaded(2, 10, [], [], 2) ]:
+            threading.Timer(0.2, _thread.interrupt_main).start()
+            with self.assertRaises(KeyboardInterrupt):
+                t.list_compact()
+            self.assertFalse(t.is_complete())
+
+        # Only with a token, the covers found so far are returned.
+        for t in [ SimsTree(2, 10, [], []),
+                   SimsTreeMultiThreaded(2, 10, [], [], 2) ]:
+            t.set_cancellation_token(CancellationToken())
+            threading.Timer(0.2, _thread.interrupt_main).start()
+            t.list_compact()
+            self.assertFalse(t.is_complete())
+
+        # permutation_reps cannot return a partial result.
+        threading.Timer(0.2, _thread.interrupt_main).start()
+        with self.assertRaises(KeyboardInterrupt):
+            permutation_reps(2, [], [], 10, num_threads = 1)
+
+        threading.Timer(0.2, _thread.interrupt_main).start()
+        reps, complete = permutation_reps_partial(
+            2, [], [], 10, num_threads = 1, token = CancellationToken())
+        self.assertFalse(complete)
+
+    def test_search_functions(self):
+        full = permutation_reps(2, [], [], 9, num_threads = 1)
+        for num_threads in [1, 4]:
+            reps, complete = permutation_reps_partial(
+                2, [], [], 9, num_threads = num_threads, deadline = 0.05)
+            self.assertFalse(complete)
+            self.assertLess(len(reps), len(full))
+            if num_threads == 1:
+                self.assertEqual(reps, full[:len(reps)])
+
+        token = CancellationToken()
+        token.cancel()
+        reps, complete = permutation_rep_set_partial(
+            2, [], [], 9, token = token)
+        self.assertFalse(complete)
+        self.assertLess(len(reps), len(full))
+        results, complete = permutation_reps_batched_partial(
+            2, [], [], [["aa"], ["bb"]], 9, token = token)
+        self.assertFalse(complete)
+
+        # A token that is not cancelled does not change the result.
+        self.assertEqual(
+            permutation_reps_partial(
+                2, [], [], 5, token = CancellationToken()),
+            (permutation_reps(2, [], [], 5), True))
+
+        with tempfile.TemporaryDirectory() as tmp_dir:
+            filename = os.path.join(tmp_dir, "results.bin")
+            n, complete = create_result_file_partial(
+                filename, 2, [], [], 9, num_threads = 4, deadline = 0.05)
+            self.assertFalse(complete)
+            self.assertEqual(len(ResultFile(filename)), n)
+
+            filename = os.path.join(tmp_dir, "covers.bin")
+            self.assertTrue(
+                create_cover_store_partial(filename, 2, [], 5, deadline = 60))
+            self.assertIsNone(create_cover_store(filename, 2, [], 5))
+
+class TestShards(unittest.TestCase):
+    def test_K11n34_7(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        expected = [
+            n.permutation_rep()
+            for n in SimsTree(3, 7, short_relators, long_relators).list() ]
+
+        for shard_depth in [3, 8]:
+            shards = []
+            for shard_index in range(4):
+                if shard_index % 2 == 0:
+                    t = SimsTree(3, 7, short_relators, long_relators)
+                else:
+                    t = SimsTreeMultiThreaded(
+                        3, 7, short_relators, long_relators, 2)
+                t.set_shard(shard_index, 4, shard_depth)
+                shards.append(t.list())
+            self.assertEqual(sum(len(shard) for shard in shards),
+                             len(expected))
+            self.assertEqual(
+                [ n.permutation_rep() for n in merge_shards(shards[::-1]) ],
+                expected)
+
+    def test_rooted(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+
+        # Roots with at least shard_depth = 3 edges (a covering subgraph
+        # of degree d has at least d - 1 edges).
+        roots = [ node
+                  for node in SimsTree(
+                          3, 7, short_relators, long_relators).bloom(50)
+                  if node.degree >= 4 and not node.is_complete() ]
+        self.assertTrue(roots)
+
+        for root in roots[:5]:
+            expected = [
+                n.permutation_rep()
+                for n in SimsTree(root, short_relators, long_relators).list() ]
+            shards = []
+            for shard_index in range(4):
+                t = SimsTree(root, short_relators, long_relators)
+                t.set_shard(shard_index, 4, 3)
+                shards.append(t.list())
+            self.assertEqual(sum(len(shard) for shard in shards),
+                             len(expected))
+            self.assertEqual(
+                [ n.permutation_rep() for n in merge_shards(shards) ],
+                expected)
+
+        # A complete root belongs to the first shard.
+        root = SimsNode(2, 3)
+        root.add_edge(1, 1, 1)
+        root.add_edge(2, 1, 1)
+        for shard_index in range(3):
+            for t in [ SimsTree(root, [], []),
+                       SimsTreeMultiThreaded(root, [], [], 2) ]:
+                t.set_shard(shard_index, 3)
+                self.assertEqual(len(t.list()),
+                                 1 if shard_index == 0 else 0)
+
+    def test_permutation_reps(self):
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 6)
+        shards = [
+            permutation_reps(3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 6,
+                             shard_index = shard_index, num_shards = 3)
+            for shard_index in range(3) ]
+        self.assertEqual(merge_permutation_reps(shards), expected)
+
+class TestKernels(unittest.TestCase):
+    def tearDown(self):
+        set_kernel_variant('auto')
+
+    def test_variants(self):
+        variants = kernel_variants()
+        self.assertEqual(variants[0], 'scalar')
+        self.assertEqual(kernel_variant(), variants[-1])
+        with self.assertRaises(ValueError):
+            set_kernel_variant('bogus')
+
+    @staticmethod
+    def _random_node(rank, degree, rng):
+        # The first generator is the cycle 1 -> 2 -> ... -> degree -> 1 so
+        # that each edge adds at most one vertex.
+        perms = [ [ (v + 1) % degree for v in range(degree) ] ]
+        for i in range(1, rank):
+            perm = list(range(degree))
+            rng.shuffle(perm)
+            perms.append(perm)
+        node = SimsNode(rank, degree)
+        for letter, perm in enumerate(perms, 1):
+            for v in range(degree):
+                node.add_edge(letter, v + 1, perm[v] + 1)
+        return node, perms
+
+    @staticmethod
+    def _lifts(perms, relator):
+        inverses = [ sorted(range(len(p)), key = p.__getitem__)
+                     for p in perms ]
+        for start in range(len(perms[0])):
+            v = start
+            for letter in relator:
+                if letter > 0:
+                    v = perms[letter - 1][v]
+                else:
+                    v = inverses[-letter - 1][v]
+            if v != start:
+                return False
+        return True
+
+    def test_relators_lift(self):
+        import random
+        rng = random.Random(42)
+        for degree in [ 3, 16, 20, 32, 40, 64, 70 ]:
+            for rank in [ 2, 3 ]:
+                node, perms = self._random_node(rank, degree, rng)
+                relators = [ [ 1 ] * degree, [ -1 ] * degree ]
+                for i in range(5):
+                    relators.append(
+                        [ rng.choice([1, -1]) * rng.randint(1, rank)
+                          for j in range(rng.randint(1, 20)) ])
+                for relator in relators:
+                    expected = self._lifts(perms, relator)
+                    for variant in kernel_variants():
+                        set_kernel_variant(variant)
+                        self.assertEqual(node.relators_lift([relator]),
+                                         expected)
+                        self.assertEqual(
+                            node.relators_lift(relators[:2] + [relator]),
+                            expected)
+
+    def test_permutation_reps(self):
+        expected = permutation_reps(
+            3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7)
+        for variant in kernel_variants():
+            set_kernel_variant(variant)
+            self.assertEqual(
+                permutation_reps(
+                    3, ["aaBcbbcAc"], ["aacAbCBBaCAAbbcBc"], 7),
+                expected)
+
+class TestSubgroupCounts(unittest.TestCase):
+    def test_free_group(self):
+        # Subgroup growth of the free group of rank 2 (OEIS A003319 for
+        # the subgroups and A057005 for the conjugacy classes).
+        for t in [ SimsTree(2, 6, [], []),
+                   SimsTreeMultiThreaded(2, 6, [], [], 2) ]:
+            counts = t.count()
+            self.assertEqual(counts.conjugacy_classes,
+                             [1, 3, 7, 26, 97, 624])
+            self.assertEqual(counts.subgroups,
+                             [1, 3, 13, 71, 461, 3447])
+
+    def test_abelian(self):
+        # All subgroups of Z^2 are normal, the number of index n is the
+        # sum of the divisors of n.
+        counts = SimsTree(2, 8, [parse_word(2, "abAB")], []).count()
+        self.assertEqual(counts.subgroups, [1, 3, 4, 7, 6, 12, 8, 15])
+        self.assertEqual(counts.conjugacy_classes, counts.subgroups)
+
+    def test_conjugacy_class_size(self):
+        short_relators = spin_short([parse_word(3, "aaBcbbcAc")], 7)
+        long_relators = [parse_word(3, "aacAbCBBaCAAbbcBc")]
+        nodes = SimsTree(3, 7, short_relators, long_relators).list()
+        subgroups = [ 0 ] * 7
+        for node in nodes:
+            size = node.conjugacy_class_size()
+            self.assertEqual(node.degree % size, 0)
+            subgroups[node.degree - 1] += size
+
+        counts = SimsTreeMultiThreaded(
+            3, 7, short_relators, long_relators, 2).count()
+        self.assertEqual(sum(counts.conjugacy_classes), len(nodes))
+        self.assertEqual(counts.subgroups, subgroups)
+
+        shard_counts = []
+        for shard_index in range(3):
+            t = SimsTree(3, 7, short_relators, long_relators)
+            t.set_shard(shard_index, 3, 6)
+            shard_counts.append(t.count().subgroups)
+        self.assertEqual([ sum(c) for c in zip(*shard_counts) ], subgroups)
+
+        with self.assertRaises(ValueError):
+            SimsNode(3, 7).conjugacy_class_size()
+
 if __name__ == '__main__':
     print("Number of cores reported by the operating system:",
           hardware_concurrency())
     unittest.main()
-
-
@@ -1,3 +1,4 @@
+import os
 import sys
 import shutil
 from setuptools import setup, Command, Extension
@@ -9,28 +10,66 @@ sources = [
     "cpp_src/simsNode.cpp",
     "cpp_src/stackedSimsNode.cpp",
     "cpp_src/abstractSimsNode.cpp",
+    "cpp_src/kernels.cpp",
+    "cpp_src/perfEvents.cpp",
+    "cpp_src/searchStatistics.cpp",
+    "cpp_src/sampling.cpp",
+    "cpp_src/cancellation.cpp",
+    "cpp_src/leafSink.cpp",
     "cpp_src/simsTreeBase.cpp",
     "cpp_src/simsTree.cpp",
+    "cpp_src/threadTrace.cpp",
     "cpp_src/simsTreeMultiThreaded.cpp",
+    "cpp_src/mappedFile.cpp",
+    "cpp_src/coverStore.cpp",
+    "cpp_src/coverList.cpp",
+    "cpp_src/permutationRepSet.cpp",
+    "cpp_src/resultFile.cpp",
+    "cpp_src/deltaStream.cpp",
     # The pybind11 headers are somewhat heavy - compiling all pieces
     # of the python wrapping in the same translation unit speeds up
     # compilation significantly.
     "cpp_src/wrapAll.cpp"
 ]
 
+# The same flags as the Release build of CMakeLists.txt: the code only
+# needs C++11, but newer compilers optimize better in the newer modes.
+# Set the environment variable LOW_INDEX_LTO=0 to disable link-time
+# optimization (like the option of the same name of CMakeLists.txt).
+use_lto = os.environ.get('LOW_INDEX_LTO', '1') not in ['', '0']
+extra_link_args = []
 if sys.platform.startswith('win'):
     # '/MT' statically links against the C++ runtime `msvcp140.dll`
     # which is not part of Windows proper and has various incompatible
     # versions.
-    extra_compile_args = ['/Ox', '/std:c++14', '/MT']
+    extra_compile_args = ['/O2', '/std:c++17', '/MT']
+    if use_lto:
+        extra_compile_args.append('/GL')
+        extra_link_args.append('/LTCG')
 else:
-    extra_compile_args = ['-O3', '-std=c++11']
+    extra_compile_args = ['-O3', '-std=c++17']
+    if use_lto:
+        extra_compile_args.append('-flto')
+        extra_link_args.append('-flto')
+
+# Set the environment variable LOW_INDEX_STATISTICS=1 to compile in the
+# counters for SimsTreeBase.statistics().
+define_macros = []
+if os.environ.get('LOW_INDEX_STATISTICS', '0') not in ['', '0']:
+    define_macros.append(('LOW_INDEX_STATISTICS', '1'))
+# Set the environment variable LOW_INDEX_PERF_COUNTERS=1 to compile in the
+# hardware performance counters (Linux only) for
+# SimsTreeBase.statistics().perf_counters.
+if os.environ.get('LOW_INDEX_PERF_COUNTERS', '0') not in ['', '0']:
+    define_macros.append(('LOW_INDEX_PERF_COUNTERS', '1'))
 
 ext_modules = [
     Extension(
         name = 'low_index._low_index',
         sources = sources,
-        extra_compile_args = extra_compile_args)
+        define_macros = define_macros,
+        extra_compile_args = extra_compile_args,
+        extra_link_args = extra_link_args)
 ]
 
 class Clean(Command):